@@ -6949,6 +6949,14 @@ namespace Vitex
 					return ExpectsWrapper::UnwrapVoid(std::move(Result), Context);
 				});
 			}
+			Core::Promise<bool> ClientUpgradeDeflate(Network::HTTP::Client* Base, const Network::HTTP::RequestFrame& Frame, const Network::HTTP::WebSocketDeflate& Deflate)
+			{
+				ImmediateContext* Context = ImmediateContext::Get();
+				return Base->Upgrade(Network::HTTP::RequestFrame(Frame), Deflate).Then<bool>([Context](Core::ExpectsSystem<void>&& Result)
+				{
+					return ExpectsWrapper::UnwrapVoid(std::move(Result), Context);
+				});
+			}
 			Core::Promise<bool> ClientSend(Network::HTTP::Client* Base, const Network::HTTP::RequestFrame& Frame)
 			{
 				ImmediateContext* Context = ImmediateContext::Get();
@@ -6965,6 +6973,23 @@ namespace Vitex
 					return ExpectsWrapper::UnwrapVoid(std::move(Result), Context);
 				});
 			}
+			Core::Promise<bool> ClientSendPipelined(Network::HTTP::Client* Base, Array* Data)
+			{
+				ImmediateContext* Context = ImmediateContext::Get();
+				auto Frames = Data != nullptr ? Array::Decompose<Network::HTTP::RequestFrame>(Data) : Core::Vector<Network::HTTP::RequestFrame>();
+				return Base->SendPipelined(std::move(Frames)).Then<bool>([Context](Core::ExpectsSystem<void>&& Result)
+				{
+					return ExpectsWrapper::UnwrapVoid(std::move(Result), Context);
+				});
+			}
+			Core::Promise<bool> ClientReceivePipelined(Network::HTTP::Client* Base)
+			{
+				ImmediateContext* Context = ImmediateContext::Get();
+				return Base->ReceivePipelined().Then<bool>([Context](Core::ExpectsSystem<void>&& Result)
+				{
+					return ExpectsWrapper::UnwrapVoid(std::move(Result), Context);
+				});
+			}
 			Core::Promise<Core::Schema*> ClientJSON(Network::HTTP::Client* Base, const Network::HTTP::RequestFrame& Frame, size_t MaxSize)
 			{
 				ImmediateContext* Context = ImmediateContext::Get();
@@ -6990,6 +7015,14 @@ namespace Vitex
 					return ExpectsWrapper::Unwrap(std::move(Response), Network::HTTP::ResponseFrame(), Context);
 				});
 			}
+			Core::Promise<Network::HTTP::ResponseFrame> ClientPoolFetch(Network::HTTP::ClientPool* Base, const std::string_view& Location, const std::string_view& Method, const Network::HTTP::FetchFrame& Options)
+			{
+				ImmediateContext* Context = ImmediateContext::Get();
+				return Base->Fetch(Location, Method, Options).Then<Network::HTTP::ResponseFrame>([Context](Core::ExpectsSystem<Network::HTTP::ResponseFrame>&& Response) -> Network::HTTP::ResponseFrame
+				{
+					return ExpectsWrapper::Unwrap(std::move(Response), Network::HTTP::ResponseFrame(), Context);
+				});
+			}
 
 			Array* SMTPRequestGetRecipients(Network::SMTP::RequestFrame* Base)
 			{
@@ -7630,6 +7663,57 @@ namespace Vitex
 					return ExpectsWrapper::Unwrap(std::move(Result), Network::PDB::Cursor(), Context);
 				});
 			}
+			Core::Promise<Network::PDB::Cursor> PDBClusterCopyFromStream(Network::PDB::Cluster* Base, const std::string_view& Command, Core::Stream* Source, Network::PDB::SessionId Session)
+			{
+				ImmediateContext* Context = ImmediateContext::Get();
+				return Base->CopyFromStream(Command, Source, Session).Then<Network::PDB::Cursor>([Context](Network::PDB::ExpectsDB<Network::PDB::Cursor>&& Result)
+				{
+					return ExpectsWrapper::Unwrap(std::move(Result), Network::PDB::Cursor(), Context);
+				});
+			}
+			Core::Promise<Network::PDB::Cursor> PDBClusterCopyToStream(Network::PDB::Cluster* Base, const std::string_view& Command, Core::Stream* Target, Network::PDB::SessionId Session)
+			{
+				ImmediateContext* Context = ImmediateContext::Get();
+				return Base->CopyToStream(Command, Target, Session).Then<Network::PDB::Cursor>([Context](Network::PDB::ExpectsDB<Network::PDB::Cursor>&& Result)
+				{
+					return ExpectsWrapper::Unwrap(std::move(Result), Network::PDB::Cursor(), Context);
+				});
+			}
+			Core::Promise<Network::PDB::Cursor> PDBClusterStreamQuery(Network::PDB::Cluster* Base, const std::string_view& Command, asIScriptFunction* Callback, size_t Rows, Network::PDB::SessionId Session)
+			{
+				FunctionDelegate Delegate(Callback);
+				ImmediateContext* Context = ImmediateContext::Get();
+				return Base->StreamQuery(Command, [Base, Delegate](Network::PDB::Response&& Data) mutable -> Core::Promise<bool>
+				{
+					if (!Delegate.IsValid())
+						return Core::Promise<bool>(true);
+
+					Core::Promise<bool> Future;
+					Network::PDB::Response* Chunk = Core::Memory::New<Network::PDB::Response>(std::move(Data));
+					Delegate([Base, Chunk](ImmediateContext* Context)
+					{
+						Context->SetArgObject(0, Base);
+						Context->SetArgObject(1, Chunk);
+					}, [Future, Chunk](ImmediateContext* Context) mutable
+					{
+						Core::Memory::Delete(Chunk);
+						Promise* Target = Context->GetReturnObject<Promise>();
+						if (!Target)
+							return Future.Set(true);
+
+						Target->When([Future](Promise* Target) mutable
+						{
+							bool Value = true;
+							Target->Retrieve(&Value, (int)TypeId::BOOL);
+							Future.Set(Value);
+						});
+					});
+					return Future;
+				}, Rows, Session).Then<Network::PDB::Cursor>([Context](Network::PDB::ExpectsDB<Network::PDB::Cursor>&& Result)
+				{
+					return ExpectsWrapper::Unwrap(std::move(Result), Network::PDB::Cursor(), Context);
+				});
+			}
 			Core::Promise<Network::PDB::Cursor> PDBClusterEmplaceQuery(Network::PDB::Cluster* Base, const std::string_view& Command, Array* Data, size_t Options, Network::PDB::Connection* Session)
 			{
 				Core::SchemaList Args;
@@ -7674,6 +7758,50 @@ namespace Vitex
 					return ExpectsWrapper::Unwrap(std::move(Result), Network::PDB::Cursor(), Context);
 				});
 			}
+			Core::Promise<Network::PDB::Cursor> PDBClusterPreparedQuery(Network::PDB::Cluster* Base, const std::string_view& Command, Dictionary* Data, size_t Options, Network::PDB::Connection* Session)
+			{
+				Core::SchemaArgs Args;
+				if (Data != nullptr)
+				{
+					VirtualMachine* VM = VirtualMachine::Get();
+					if (VM != nullptr)
+					{
+						int TypeId = VM->GetTypeIdByDecl("schema@");
+						Args.reserve(Data->Size());
+
+						for (auto It = Data->Begin(); It != Data->End(); ++It)
+						{
+							Core::Schema* Value = nullptr;
+							if (It.GetValue(&Value, TypeId))
+							{
+								Args[It.GetKey()] = Value;
+								Value->AddRef();
+							}
+						}
+					}
+				}
+
+				ImmediateContext* Context = ImmediateContext::Get();
+				return Base->PreparedQuery(Command, &Args, Options, Session).Then<Network::PDB::Cursor>([Context](Network::PDB::ExpectsDB<Network::PDB::Cursor>&& Result)
+				{
+					return ExpectsWrapper::Unwrap(std::move(Result), Network::PDB::Cursor(), Context);
+				});
+			}
+			Core::Promise<Network::PDB::Cursor> PDBClusterParameterizedQuery(Network::PDB::Cluster* Base, const std::string_view& Command, Array* Data, size_t Options, Network::PDB::Connection* Session)
+			{
+				Core::SchemaList Args;
+				for (auto& Item : Array::Decompose<Core::Schema*>(Data))
+				{
+					Args.emplace_back(Item);
+					Item->AddRef();
+				}
+
+				ImmediateContext* Context = ImmediateContext::Get();
+				return Base->ParameterizedQuery(Command, &Args, Options, Session).Then<Network::PDB::Cursor>([Context](Network::PDB::ExpectsDB<Network::PDB::Cursor>&& Result)
+				{
+					return ExpectsWrapper::Unwrap(std::move(Result), Network::PDB::Cursor(), Context);
+				});
+			}
 
 			Core::String PDBUtilsInlineQuery(Network::PDB::Cluster* Client, Core::Schema* Where, Dictionary* WhitelistData, const std::string_view& Default)
 			{
@@ -10318,6 +10446,7 @@ namespace Vitex
 				VDesc->SetProperty("usize stack_size", &Core::Schedule::Desc::StackSize);
 				VDesc->SetProperty("usize max_coroutines", &Core::Schedule::Desc::MaxCoroutines);
 				VDesc->SetProperty("usize max_recycles", &Core::Schedule::Desc::MaxRecycles);
+				VDesc->SetProperty("bool work_stealing", &Core::Schedule::Desc::WorkStealing);
 				VDesc->SetProperty("bool parallel", &Core::Schedule::Desc::Parallel);
 				VDesc->SetConstructor<Core::Schedule::Desc>("void f()");
 				VDesc->SetConstructor<Core::Schedule::Desc, size_t>("void f(usize)");
@@ -11000,6 +11129,7 @@ namespace Vitex
 				VSocket->SetMethodEx("bool set_blocking(bool)", VI_EXPECTIFY_VOID(Network::Socket::SetBlocking));
 				VSocket->SetMethodEx("bool set_no_delay(bool)", VI_EXPECTIFY_VOID(Network::Socket::SetNoDelay));
 				VSocket->SetMethodEx("bool set_keep_alive(bool)", VI_EXPECTIFY_VOID(Network::Socket::SetKeepAlive));
+				VSocket->SetMethodEx("bool set_reuse_port(bool)", VI_EXPECTIFY_VOID(Network::Socket::SetReusePort));
 				VSocket->SetMethodEx("bool set_timeout(int)", VI_EXPECTIFY_VOID(Network::Socket::SetTimeout));
 				VSocket->SetMethodEx("bool shutdown(bool = false)", &VI_EXPECTIFY_VOID(Network::Socket::Shutdown));
 				VSocket->SetMethodEx("bool open(const socket_address&in)", &VI_EXPECTIFY_VOID(Network::Socket::Open));
@@ -11034,10 +11164,12 @@ namespace Vitex
 				VMultiplexer->SetFunctionDef("void poll_async(socket@+, socket_poll)");
 				VMultiplexer->SetConstructor<Network::Multiplexer>("multiplexer@ f()");
 				VMultiplexer->SetConstructor<Network::Multiplexer, uint64_t, size_t>("multiplexer@ f(uint64, usize)");
-				VMultiplexer->SetMethod("void rescale(uint64, usize)", &Network::Multiplexer::Rescale);
+				VMultiplexer->SetConstructor<Network::Multiplexer, uint64_t, size_t, size_t>("multiplexer@ f(uint64, usize, usize)");
+				VMultiplexer->SetMethod("void rescale(uint64, usize, usize = 1)", &Network::Multiplexer::Rescale);
 				VMultiplexer->SetMethod("void activate()", &Network::Multiplexer::Activate);
 				VMultiplexer->SetMethod("void deactivate()", &Network::Multiplexer::Deactivate);
 				VMultiplexer->SetMethod("int dispatch(uint64)", &Network::Multiplexer::Dispatch);
+				VMultiplexer->SetMethod("int dispatch_shard(usize, uint64)", &Network::Multiplexer::DispatchShard);
 				VMultiplexer->SetMethod("bool shutdown()", &Network::Multiplexer::Shutdown);
 				VMultiplexer->SetMethodEx("bool when_readable(socket@+, poll_async@)", &MultiplexerWhenReadable);
 				VMultiplexer->SetMethodEx("bool when_writeable(socket@+, poll_async@)", &MultiplexerWhenWriteable);
@@ -11045,6 +11177,7 @@ namespace Vitex
 				VMultiplexer->SetMethod("bool clear_events(socket@+)", &Network::Multiplexer::ClearEvents);
 				VMultiplexer->SetMethod("bool is_listening()", &Network::Multiplexer::IsListening);
 				VMultiplexer->SetMethod("usize get_activations()", &Network::Multiplexer::GetActivations);
+				VMultiplexer->SetMethod("usize get_shards() const", &Network::Multiplexer::GetShards);
 				VMultiplexer->SetMethodStatic("multiplexer@+ get()", &Network::Multiplexer::Get);
 
 				auto VUplinks = VM->SetClass<Network::Uplinks>("uplinks", false);
@@ -11076,6 +11209,7 @@ namespace Vitex
 				VSocketRouter->SetProperty<Network::SocketRouter>("usize backlog_queue", &Network::SocketRouter::BacklogQueue);
 				VSocketRouter->SetProperty<Network::SocketRouter>("usize socket_timeout", &Network::SocketRouter::SocketTimeout);
 				VSocketRouter->SetProperty<Network::SocketRouter>("usize max_connections", &Network::SocketRouter::MaxConnections);
+				VSocketRouter->SetProperty<Network::SocketRouter>("usize max_listeners", &Network::SocketRouter::MaxListeners);
 				VSocketRouter->SetProperty<Network::SocketRouter>("int64 keep_alive_max_count", &Network::SocketRouter::KeepAliveMaxCount);
 				VSocketRouter->SetProperty<Network::SocketRouter>("int64 graceful_time_wait", &Network::SocketRouter::GracefulTimeWait);
 				VSocketRouter->SetProperty<Network::SocketRouter>("bool enable_no_delay", &Network::SocketRouter::EnableNoDelay);
@@ -11184,6 +11318,11 @@ namespace Vitex
 				VWebSocketState->SetValue("process", (int)Network::HTTP::WebSocketState::Process);
 				VWebSocketState->SetValue("close", (int)Network::HTTP::WebSocketState::Close);
 
+				auto VBroadcastPolicy = VM->SetEnum("broadcast_policy");
+				VBroadcastPolicy->SetValue("buffer", (int)Network::HTTP::BroadcastPolicy::Buffer);
+				VBroadcastPolicy->SetValue("drop", (int)Network::HTTP::BroadcastPolicy::Drop);
+				VBroadcastPolicy->SetValue("disconnect", (int)Network::HTTP::BroadcastPolicy::Disconnect);
+
 				auto VCompressionTune = VM->SetEnum("compression_tune");
 				VCompressionTune->SetValue("filtered", (int)Network::HTTP::CompressionTune::Filtered);
 				VCompressionTune->SetValue("huffman", (int)Network::HTTP::CompressionTune::Huffman);
@@ -11341,10 +11480,21 @@ namespace Vitex
 				VRouteCompression->SetMethodEx("void set_files(array<regex_source>@+)", &RouteCompressionSetFiles);
 				VRouteCompression->SetMethodEx("array<regex_source>@ get_files() const", &RouteCompressionGetFiles);
 
+				auto VWebSocketDeflate = VM->SetStructTrivial<Network::HTTP::WebSocketDeflate>("websocket_deflate");
+				VWebSocketDeflate->SetProperty<Network::HTTP::WebSocketDeflate>("usize max_message_size", &Network::HTTP::WebSocketDeflate::MaxMessageSize);
+				VWebSocketDeflate->SetProperty<Network::HTTP::WebSocketDeflate>("int32 local_window_bits", &Network::HTTP::WebSocketDeflate::LocalWindowBits);
+				VWebSocketDeflate->SetProperty<Network::HTTP::WebSocketDeflate>("int32 remote_window_bits", &Network::HTTP::WebSocketDeflate::RemoteWindowBits);
+				VWebSocketDeflate->SetProperty<Network::HTTP::WebSocketDeflate>("int32 quality_level", &Network::HTTP::WebSocketDeflate::QualityLevel);
+				VWebSocketDeflate->SetProperty<Network::HTTP::WebSocketDeflate>("int32 memory_level", &Network::HTTP::WebSocketDeflate::MemoryLevel);
+				VWebSocketDeflate->SetProperty<Network::HTTP::WebSocketDeflate>("bool local_context_takeover", &Network::HTTP::WebSocketDeflate::LocalContextTakeover);
+				VWebSocketDeflate->SetProperty<Network::HTTP::WebSocketDeflate>("bool remote_context_takeover", &Network::HTTP::WebSocketDeflate::RemoteContextTakeover);
+				VWebSocketDeflate->SetConstructor<Network::HTTP::WebSocketDeflate>("void f()");
+
 				auto VMapRouter = VM->SetClass<Network::HTTP::MapRouter>("map_router", true);
 				auto VRouterEntry = VM->SetClass<Network::HTTP::RouterEntry>("route_entry", false);
 				VRouterEntry->SetProperty<Network::HTTP::RouterEntry>("route_auth auths", &Network::HTTP::RouterEntry::Auth);
 				VRouterEntry->SetProperty<Network::HTTP::RouterEntry>("route_compression compressions", &Network::HTTP::RouterEntry::Compression);
+				VRouterEntry->SetProperty<Network::HTTP::RouterEntry>("websocket_deflate websocket_compression", &Network::HTTP::RouterEntry::WebSocketCompression);
 				VRouterEntry->SetProperty<Network::HTTP::RouterEntry>("string files_directory", &Network::HTTP::RouterEntry::FilesDirectory);
 				VRouterEntry->SetProperty<Network::HTTP::RouterEntry>("string char_set", &Network::HTTP::RouterEntry::CharSet);
 				VRouterEntry->SetProperty<Network::HTTP::RouterEntry>("string proxy_ip_address", &Network::HTTP::RouterEntry::ProxyIpAddress);
@@ -11356,7 +11506,9 @@ namespace Vitex
 				VRouterEntry->SetProperty<Network::HTTP::RouterEntry>("usize level", &Network::HTTP::RouterEntry::Level);
 				VRouterEntry->SetProperty<Network::HTTP::RouterEntry>("bool allow_directory_listing", &Network::HTTP::RouterEntry::AllowDirectoryListing);
 				VRouterEntry->SetProperty<Network::HTTP::RouterEntry>("bool allow_websocket", &Network::HTTP::RouterEntry::AllowWebSocket);
+				VRouterEntry->SetProperty<Network::HTTP::RouterEntry>("bool allow_websocket_compression", &Network::HTTP::RouterEntry::AllowWebSocketCompression);
 				VRouterEntry->SetProperty<Network::HTTP::RouterEntry>("bool allow_send_file", &Network::HTTP::RouterEntry::AllowSendFile);
+				VRouterEntry->SetProperty<Network::HTTP::RouterEntry>("bool allow_file_cache", &Network::HTTP::RouterEntry::AllowFileCache);
 				VRouterEntry->SetProperty<Network::HTTP::RouterEntry>("regex_source location", &Network::HTTP::RouterEntry::Location);
 				VRouterEntry->SetConstructor<Network::HTTP::RouterEntry>("route_entry@ f()");
 				VRouterEntry->SetMethodEx("void set_hidden_files(array<regex_source>@+)", &RouterEntrySetHiddenFiles);
@@ -11394,8 +11546,18 @@ namespace Vitex
 				VRouterSession->SetProperty<Network::HTTP::MapRouter::RouterSession>("router_cookie cookie", &Network::HTTP::MapRouter::RouterSession::Cookie);
 				VRouterSession->SetProperty<Network::HTTP::MapRouter::RouterSession>("string directory", &Network::HTTP::MapRouter::RouterSession::Directory);
 				VRouterSession->SetProperty<Network::HTTP::MapRouter::RouterSession>("uint64 expires", &Network::HTTP::MapRouter::RouterSession::Expires);
+				VRouterSession->SetProperty<Network::HTTP::MapRouter::RouterSession>("usize max_entries", &Network::HTTP::MapRouter::RouterSession::MaxEntries);
+				VRouterSession->SetProperty<Network::HTTP::MapRouter::RouterSession>("bool write_behind", &Network::HTTP::MapRouter::RouterSession::WriteBehind);
 				VRouterSession->SetConstructor<Network::HTTP::MapRouter::RouterSession>("void f()");
 
+				auto VRouterHttp2 = VM->SetStructTrivial<Network::HTTP::MapRouter::RouterHttp2>("router_http2");
+				VRouterHttp2->SetProperty<Network::HTTP::MapRouter::RouterHttp2>("usize max_concurrent_streams", &Network::HTTP::MapRouter::RouterHttp2::MaxConcurrentStreams);
+				VRouterHttp2->SetProperty<Network::HTTP::MapRouter::RouterHttp2>("usize initial_window_size", &Network::HTTP::MapRouter::RouterHttp2::InitialWindowSize);
+				VRouterHttp2->SetProperty<Network::HTTP::MapRouter::RouterHttp2>("usize max_frame_size", &Network::HTTP::MapRouter::RouterHttp2::MaxFrameSize);
+				VRouterHttp2->SetProperty<Network::HTTP::MapRouter::RouterHttp2>("usize header_table_size", &Network::HTTP::MapRouter::RouterHttp2::HeaderTableSize);
+				VRouterHttp2->SetProperty<Network::HTTP::MapRouter::RouterHttp2>("bool enabled", &Network::HTTP::MapRouter::RouterHttp2::Enabled);
+				VRouterHttp2->SetConstructor<Network::HTTP::MapRouter::RouterHttp2>("void f()");
+
 				auto VConnection = VM->SetClass<Network::HTTP::Connection>("connection", false);
 				auto VWebSocketFrame = VM->SetClass<Network::HTTP::WebSocketFrame>("websocket_frame", false);
 				VWebSocketFrame->SetFunctionDef("void status_async(websocket_frame@+)");
@@ -11407,6 +11569,7 @@ namespace Vitex
 				VWebSocketFrame->SetMethodEx("promise<bool>@ send(const string_view&in, websocket_op)", &VI_SPROMISIFY(WebSocketFrameSend1, TypeId::BOOL));
 				VWebSocketFrame->SetMethodEx("promise<bool>@ send(uint32, const string_view&in, websocket_op)", &VI_SPROMISIFY(WebSocketFrameSend2, TypeId::BOOL));
 				VWebSocketFrame->SetMethodEx("promise<bool>@ send_close()", &VI_SPROMISIFY(WebSocketFrameSendClose, TypeId::BOOL));
+				VWebSocketFrame->SetMethod("bool set_deflate(const websocket_deflate&in)", &Network::HTTP::WebSocketFrame::SetDeflate);
 				VWebSocketFrame->SetMethod("void next()", &Network::HTTP::WebSocketFrame::Next);
 				VWebSocketFrame->SetMethod("bool is_finished() const", &Network::HTTP::WebSocketFrame::IsFinished);
 				VWebSocketFrame->SetMethod("socket@+ get_stream() const", &Network::HTTP::WebSocketFrame::GetStream);
@@ -11417,10 +11580,12 @@ namespace Vitex
 				VMapRouter->SetProperty<Network::SocketRouter>("usize backlog_queue", &Network::SocketRouter::BacklogQueue);
 				VMapRouter->SetProperty<Network::SocketRouter>("usize socket_timeout", &Network::SocketRouter::SocketTimeout);
 				VMapRouter->SetProperty<Network::SocketRouter>("usize max_connections", &Network::SocketRouter::MaxConnections);
+				VMapRouter->SetProperty<Network::SocketRouter>("usize max_listeners", &Network::SocketRouter::MaxListeners);
 				VMapRouter->SetProperty<Network::SocketRouter>("int64 keep_alive_max_count", &Network::SocketRouter::KeepAliveMaxCount);
 				VMapRouter->SetProperty<Network::SocketRouter>("int64 graceful_time_wait", &Network::SocketRouter::GracefulTimeWait);
 				VMapRouter->SetProperty<Network::SocketRouter>("bool enable_no_delay", &Network::SocketRouter::EnableNoDelay);
 				VMapRouter->SetProperty<Network::HTTP::MapRouter>("router_session session", &Network::HTTP::MapRouter::Session);
+				VMapRouter->SetProperty<Network::HTTP::MapRouter>("router_http2 http2", &Network::HTTP::MapRouter::Http2);
 				VMapRouter->SetProperty<Network::HTTP::MapRouter>("string temporary_directory", &Network::HTTP::MapRouter::TemporaryDirectory);
 				VMapRouter->SetProperty<Network::HTTP::MapRouter>("usize max_uploadable_resources", &Network::HTTP::MapRouter::MaxUploadableResources);
 				VMapRouter->SetGcConstructor<Network::HTTP::MapRouter, MapRouter>("map_router@ f()");
@@ -11524,9 +11689,15 @@ namespace Vitex
 				VSession->SetMethodStatic("bool invalidate_cache(const string_view&in)", &VI_SEXPECTIFY_VOID(Network::HTTP::Session::InvalidateCache));
 				VSession->SetMethodEx("void set_data(schema@+)", &SessionSetData);
 				VSession->SetMethodEx("schema@+ get_data()", &SessionGetData);
+				VConnection->SetMethod("session@+ get_session()", &Network::HTTP::Connection::GetSession);
 
 				VServer->SetGcConstructor<Network::HTTP::Server, Server>("server@ f()");
 				VServer->SetMethod("void update()", &Network::HTTP::Server::Update);
+				VServer->SetMethod("bool subscribe(const string_view&in, websocket_frame@+, broadcast_policy = broadcast_policy::buffer, usize = 1048576)", &Network::HTTP::Server::Subscribe);
+				VServer->SetMethod<Network::HTTP::Server, bool, const std::string_view&, Network::HTTP::WebSocketFrame*>("bool unsubscribe(const string_view&in, websocket_frame@+)", &Network::HTTP::Server::Unsubscribe);
+				VServer->SetMethod<Network::HTTP::Server, void, Network::HTTP::WebSocketFrame*>("void unsubscribe(websocket_frame@+)", &Network::HTTP::Server::Unsubscribe);
+				VServer->SetMethod("usize publish(const string_view&in, const string_view&in, websocket_op = websocket_op::text)", &Network::HTTP::Server::Publish);
+				VServer->SetMethod("usize get_subscribers(const string_view&in)", &Network::HTTP::Server::GetSubscribers);
 				VServer->SetMethodEx("void set_router(map_router@+)", &SocketServerSetRouter);
 				VServer->SetMethodEx("bool configure(map_router@+)", &SocketServerConfigure);
 				VServer->SetMethodEx("bool listen()", &SocketServerListen);
@@ -11558,8 +11729,11 @@ namespace Vitex
 				VClient->SetMethodEx("promise<bool>@ skip()", &VI_SPROMISIFY(ClientSkip, TypeId::BOOL));
 				VClient->SetMethodEx("promise<bool>@ fetch(usize = 65536, bool = false)", &VI_SPROMISIFY(ClientFetch, TypeId::BOOL));
 				VClient->SetMethodEx("promise<bool>@ upgrade(const request_frame&in)", &VI_SPROMISIFY(ClientUpgrade, TypeId::BOOL));
+				VClient->SetMethodEx("promise<bool>@ upgrade(const request_frame&in, const websocket_deflate&in)", &VI_SPROMISIFY(ClientUpgradeDeflate, TypeId::BOOL));
 				VClient->SetMethodEx("promise<bool>@ send(const request_frame&in)", &VI_SPROMISIFY(ClientSend, TypeId::BOOL));
 				VClient->SetMethodEx("promise<bool>@ send_fetch(const request_frame&in, usize = 65536)", &VI_SPROMISIFY(ClientSendFetch, TypeId::BOOL));
+				VClient->SetMethodEx("promise<bool>@ send_pipelined(array<request_frame>@+)", &VI_SPROMISIFY(ClientSendPipelined, TypeId::BOOL));
+				VClient->SetMethodEx("promise<bool>@ receive_pipelined()", &VI_SPROMISIFY(ClientReceivePipelined, TypeId::BOOL));
 				VClient->SetMethodEx("promise<bool>@ connect_sync(const socket_address&in, int32 = -1)", &VI_SPROMISIFY(SocketClientConnectSync, TypeId::BOOL));
 				VClient->SetMethodEx("promise<bool>@ connect_async(const socket_address&in, int32 = -1)", &VI_SPROMISIFY(SocketClientConnectAsync, TypeId::BOOL));
 				VClient->SetMethodEx("promise<bool>@ disconnect()", &VI_SPROMISIFY(SocketClientDisconnect, TypeId::BOOL));
@@ -11574,6 +11748,23 @@ namespace Vitex
 				VClient->SetMethod("response_frame& get_response() property", &Network::HTTP::Client::GetResponse);
 				VClient->SetDynamicCast<Network::HTTP::Client, Network::SocketClient>("socket_client@+", true);
 
+				auto VPoolLimits = VM->SetStructTrivial<Network::HTTP::ClientPool::PoolLimits>("client_pool_limits");
+				VPoolLimits->SetProperty<Network::HTTP::ClientPool::PoolLimits>("uint64 idle_timeout", &Network::HTTP::ClientPool::PoolLimits::IdleTimeout);
+				VPoolLimits->SetProperty<Network::HTTP::ClientPool::PoolLimits>("usize max_connections", &Network::HTTP::ClientPool::PoolLimits::MaxConnections);
+				VPoolLimits->SetProperty<Network::HTTP::ClientPool::PoolLimits>("usize max_idle", &Network::HTTP::ClientPool::PoolLimits::MaxIdle);
+				VPoolLimits->SetProperty<Network::HTTP::ClientPool::PoolLimits>("usize max_pipeline", &Network::HTTP::ClientPool::PoolLimits::MaxPipeline);
+				VPoolLimits->SetProperty<Network::HTTP::ClientPool::PoolLimits>("usize max_queue", &Network::HTTP::ClientPool::PoolLimits::MaxQueue);
+				VPoolLimits->SetConstructor<Network::HTTP::ClientPool::PoolLimits>("void f()");
+
+				auto VClientPool = VM->SetClass<Network::HTTP::ClientPool>("client_pool", false);
+				VClientPool->SetProperty<Network::HTTP::ClientPool>("client_pool_limits limits", &Network::HTTP::ClientPool::Limits);
+				VClientPool->SetConstructor<Network::HTTP::ClientPool>("client_pool@ f()");
+				VClientPool->SetMethodEx("promise<response_frame>@ fetch(const string_view&in, const string_view&in = \"GET\", const fetch_frame&in = fetch_frame())", &VI_SPROMISIFY_REF(ClientPoolFetch, ResponseFrame));
+				VClientPool->SetMethod("void cleanup()", &Network::HTTP::ClientPool::Cleanup);
+				VClientPool->SetMethod("usize get_connections()", &Network::HTTP::ClientPool::GetConnections);
+				VClientPool->SetMethod("usize get_requests()", &Network::HTTP::ClientPool::GetRequests);
+				VClientPool->SetMethodStatic("client_pool@+ get()", &Network::HTTP::ClientPool::Get);
+
 				auto VHrmCache = VM->SetClass<Network::HTTP::HrmCache>("hrm_cache", false);
 				VHrmCache->SetConstructor<Network::HTTP::HrmCache>("hrm_cache@ f()");
 				VHrmCache->SetConstructor<Network::HTTP::HrmCache, size_t>("hrm_cache@ f(usize)");
@@ -11581,6 +11772,24 @@ namespace Vitex
 				VHrmCache->SetMethod("void shrink()", &Network::HTTP::HrmCache::Shrink);
 				VHrmCache->SetMethodStatic("hrm_cache@+ get()", &Network::HTTP::HrmCache::Get);
 
+				auto VFileCache = VM->SetClass<Network::HTTP::FileCache>("file_cache", false);
+				VFileCache->SetConstructor<Network::HTTP::FileCache>("file_cache@ f()");
+				VFileCache->SetConstructor<Network::HTTP::FileCache, size_t, uint64_t>("file_cache@ f(usize, uint64)");
+				VFileCache->SetMethod("void rescale(usize, uint64)", &Network::HTTP::FileCache::Rescale);
+				VFileCache->SetMethod("void clear()", &Network::HTTP::FileCache::Clear);
+				VFileCache->SetMethod("usize get_size()", &Network::HTTP::FileCache::GetSize);
+				VFileCache->SetMethodStatic("file_cache@+ get()", &Network::HTTP::FileCache::Get);
+
+				auto VVariantCache = VM->SetClass<Network::HTTP::VariantCache>("variant_cache", false);
+				VVariantCache->SetConstructor<Network::HTTP::VariantCache>("variant_cache@ f()");
+				VVariantCache->SetConstructor<Network::HTTP::VariantCache, size_t>("variant_cache@ f(usize)");
+				VVariantCache->SetMethod("void rescale(usize)", &Network::HTTP::VariantCache::Rescale);
+				VVariantCache->SetMethod("void clear()", &Network::HTTP::VariantCache::Clear);
+				VVariantCache->SetMethod("uint64 get_hits() const", &Network::HTTP::VariantCache::GetHits);
+				VVariantCache->SetMethod("uint64 get_misses() const", &Network::HTTP::VariantCache::GetMisses);
+				VVariantCache->SetMethod("usize get_size()", &Network::HTTP::VariantCache::GetSize);
+				VVariantCache->SetMethodStatic("variant_cache@+ get()", &Network::HTTP::VariantCache::Get);
+
 				VM->SetFunction("promise<response_frame>@ fetch(const string_view&in, const string_view&in = \"GET\", const fetch_frame&in = fetch_frame())", &VI_SPROMISIFY_REF(HTTPFetch, ResponseFrame));
 				VM->EndNamespace();
 
@@ -11829,6 +12038,7 @@ namespace Vitex
 				VI_ASSERT(VM != nullptr, "manager should be set");
 				VI_TYPEREF(Connection, "pdb::connection");
 				VI_TYPEREF(Cursor, "pdb::cursor");
+				VM->SetClass<Core::Stream>("base_stream", false);
 
 				VM->BeginNamespace("pdb");
 				auto VIsolation = VM->SetEnum("isolation");
@@ -11882,6 +12092,9 @@ namespace Vitex
 				VQueryExec->SetValue("fatal_error", (int)Network::PDB::QueryExec::Fatal_Error);
 				VQueryExec->SetValue("copy_both", (int)Network::PDB::QueryExec::Copy_Both);
 				VQueryExec->SetValue("single_tuple", (int)Network::PDB::QueryExec::Single_Tuple);
+				VQueryExec->SetValue("pipeline_sync", (int)Network::PDB::QueryExec::Pipeline_Sync);
+				VQueryExec->SetValue("pipeline_aborted", (int)Network::PDB::QueryExec::Pipeline_Aborted);
+				VQueryExec->SetValue("tuples_chunk", (int)Network::PDB::QueryExec::Tuples_Chunk);
 
 				auto VFieldCode = VM->SetEnum("field_code");
 				VFieldCode->SetValue("severity", (int)Network::PDB::FieldCode::Severity);
@@ -11960,6 +12173,8 @@ namespace Vitex
 				VOidType->SetValue("money_t", (int)Network::PDB::OidType::Money);
 				VOidType->SetValue("numeric_t", (int)Network::PDB::OidType::Numeric);
 				VOidType->SetValue("bytea_t", (int)Network::PDB::OidType::Bytea);
+				VOidType->SetValue("timestamp_t", (int)Network::PDB::OidType::Timestamp);
+				VOidType->SetValue("timestamptz_t", (int)Network::PDB::OidType::TimestampTZ);
 
 				auto VQueryState = VM->SetEnum("query_state");
 				VQueryState->SetValue("lost", (int)Network::PDB::QueryState::Lost);
@@ -12037,6 +12252,7 @@ namespace Vitex
 				VResponse->SetMethod("row front() const", &Network::PDB::Response::Front);
 				VResponse->SetMethod("row back() const", &Network::PDB::Response::Back);
 				VResponse->SetMethod("response copy() const", &Network::PDB::Response::Copy);
+				VResponse->SetMethod("response share()", &Network::PDB::Response::Share);
 				VResponse->SetMethod("uptr@ get() const", &Network::PDB::Response::Get);
 				VResponse->SetMethod("bool empty() const", &Network::PDB::Response::Empty);
 				VResponse->SetMethod("bool error() const", &Network::PDB::Response::Error);
@@ -12057,6 +12273,7 @@ namespace Vitex
 				VCursor->SetMethod("usize size() const", &Network::PDB::Cursor::Size);
 				VCursor->SetMethod("usize affected_rows() const", &Network::PDB::Cursor::AffectedRows);
 				VCursor->SetMethod("cursor copy() const", &Network::PDB::Cursor::Copy);
+				VCursor->SetMethod("cursor share()", &Network::PDB::Cursor::Share);
 				VCursor->SetMethodEx("response first() const", &PDBCursorFirst);
 				VCursor->SetMethodEx("response last() const", &PDBCursorLast);
 				VCursor->SetMethodEx("response at(usize) const", &PDBCursorAt);
@@ -12074,6 +12291,7 @@ namespace Vitex
 				VConnection->SetMethod("query_state get_state() const", &Network::PDB::Connection::GetState);
 				VConnection->SetMethod("transaction_state get_tx_state() const", &Network::PDB::Connection::GetTxState);
 				VConnection->SetMethod("bool in_transaction() const", &Network::PDB::Connection::InTransaction);
+				VConnection->SetMethod("bool in_pipeline() const", &Network::PDB::Connection::InPipeline);
 				VConnection->SetMethod("bool busy() const", &Network::PDB::Connection::Busy);
 
 				VRequest->SetMethod("cursor& get_result()", &Network::PDB::Request::GetResult);
@@ -12081,16 +12299,30 @@ namespace Vitex
 				VRequest->SetMethod("uint64 get_timing() const", &Network::PDB::Request::GetTiming);
 				VRequest->SetMethod("bool pending() const", &Network::PDB::Request::Pending);
 
+				auto VCacheStatistics = VM->SetPod<Network::PDB::CacheStatistics>("cache_statistics");
+				VCacheStatistics->SetProperty("uint64 hits", &Network::PDB::CacheStatistics::Hits);
+				VCacheStatistics->SetProperty("uint64 misses", &Network::PDB::CacheStatistics::Misses);
+				VCacheStatistics->SetProperty("uint64 evictions", &Network::PDB::CacheStatistics::Evictions);
+				VCacheStatistics->SetProperty("usize entries", &Network::PDB::CacheStatistics::Entries);
+				VCacheStatistics->SetProperty("usize bytes", &Network::PDB::CacheStatistics::Bytes);
+				VCacheStatistics->SetProperty("usize capacity", &Network::PDB::CacheStatistics::Capacity);
+				VCacheStatistics->SetConstructor<Network::PDB::CacheStatistics>("void f()");
+
 				auto VCluster = VM->SetClass<Network::PDB::Cluster>("cluster", false);
 				VCluster->SetFunctionDef("promise<bool>@ reconnect_async(cluster@+, array<string>@+)");
 				VCluster->SetFunctionDef("void notification_async(cluster@+, const notify&in)");
+				VCluster->SetFunctionDef("promise<bool>@ stream_async(cluster@+, const response&in)");
 				VCluster->SetConstructor<Network::PDB::Cluster>("cluster@ f()");
 				VCluster->SetMethod("void clear_cache()", &Network::PDB::Cluster::ClearCache);
 				VCluster->SetMethod("void set_cache_cleanup(uint64)", &Network::PDB::Cluster::SetCacheCleanup);
 				VCluster->SetMethod("void set_cache_duration(query_op, uint64)", &Network::PDB::Cluster::SetCacheDuration);
+				VCluster->SetMethod("void set_cache_capacity(usize)", &Network::PDB::Cluster::SetCacheCapacity);
+				VCluster->SetMethod("void set_statement_capacity(usize)", &Network::PDB::Cluster::SetStatementCapacity);
+				VCluster->SetMethod("void set_pipeline_depth(usize)", &Network::PDB::Cluster::SetPipelineDepth);
 				VCluster->SetMethod("bool remove_channel(const string_view&in, uint64)", &Network::PDB::Cluster::RemoveChannel);
 				VCluster->SetMethod("connection@+ get_connection(query_state)", &Network::PDB::Cluster::GetConnection);
 				VCluster->SetMethod("connection@+ get_any_connection()", &Network::PDB::Cluster::GetAnyConnection);
+				VCluster->SetMethod("cache_statistics get_cache_statistics()", &Network::PDB::Cluster::GetCacheStatistics);
 				VCluster->SetMethod("bool is_connected() const", &Network::PDB::Cluster::IsConnected);
 				VCluster->SetMethodEx("promise<connection@>@ tx_begin(isolation)", &VI_SPROMISIFY_REF(PDBClusterTxBegin, Connection));
 				VCluster->SetMethodEx("promise<connection@>@ tx_start(const string_view&in)", &VI_SPROMISIFY_REF(PDBClusterTxStart, Connection));
@@ -12100,12 +12332,17 @@ namespace Vitex
 				VCluster->SetMethodEx("promise<bool>@ connect(const host_address&in, usize = 1)", &VI_SPROMISIFY(PDBClusterConnect, TypeId::BOOL));
 				VCluster->SetMethodEx("promise<bool>@ disconnect()", &VI_SPROMISIFY(PDBClusterDisconnect, TypeId::BOOL));
 				VCluster->SetMethodEx("promise<cursor>@ query(const string_view&in, usize = 0, connection@+ = null)", &VI_SPROMISIFY_REF(PDBClusterQuery, Cursor));
+				VCluster->SetMethodEx("promise<cursor>@ stream_query(const string_view&in, stream_async@, usize = 0, connection@+ = null)", &VI_SPROMISIFY_REF(PDBClusterStreamQuery, Cursor));
+				VCluster->SetMethodEx("promise<cursor>@ copy_from_stream(const string_view&in, base_stream@+, connection@+ = null)", &VI_SPROMISIFY_REF(PDBClusterCopyFromStream, Cursor));
+				VCluster->SetMethodEx("promise<cursor>@ copy_to_stream(const string_view&in, base_stream@+, connection@+ = null)", &VI_SPROMISIFY_REF(PDBClusterCopyToStream, Cursor));
 				VCluster->SetMethodEx("void set_when_reconnected(reconnect_async@)", &PDBClusterSetWhenReconnected);
 				VCluster->SetMethodEx("uint64 add_channel(const string_view&in, notification_async@)", &PDBClusterAddChannel);
 				VCluster->SetMethodEx("promise<bool>@ listen(array<string>@+)", &VI_SPROMISIFY(PDBClusterListen, TypeId::BOOL));
 				VCluster->SetMethodEx("promise<bool>@ unlisten(array<string>@+)", &VI_SPROMISIFY(PDBClusterUnlisten, TypeId::BOOL));
 				VCluster->SetMethodEx("promise<cursor>@ emplace_query(const string_view&in, array<schema@>@+, usize = 0, connection@+ = null)", &VI_SPROMISIFY_REF(PDBClusterEmplaceQuery, Cursor));
 				VCluster->SetMethodEx("promise<cursor>@ template_query(const string_view&in, dictionary@+, usize = 0, connection@+ = null)", &VI_SPROMISIFY_REF(PDBClusterTemplateQuery, Cursor));
+				VCluster->SetMethodEx("promise<cursor>@ prepared_query(const string_view&in, dictionary@+, usize = 0, connection@+ = null)", &VI_SPROMISIFY_REF(PDBClusterPreparedQuery, Cursor));
+				VCluster->SetMethodEx("promise<cursor>@ parameterized_query(const string_view&in, array<schema@>@+, usize = 0, connection@+ = null)", &VI_SPROMISIFY_REF(PDBClusterParameterizedQuery, Cursor));
 
 				auto VDriver = VM->SetClass<Network::PDB::Driver>("driver", false);
 				VDriver->SetFunctionDef("void query_log_async(const string_view&in)");
@@ -12565,6 +12802,7 @@ namespace Vitex
 				VApplicationDesc->SetProperty<Application::Desc>("string directory", &Application::Desc::Directory);
 				VApplicationDesc->SetProperty<Application::Desc>("usize polling_timeout", &Application::Desc::PollingTimeout);
 				VApplicationDesc->SetProperty<Application::Desc>("usize polling_events", &Application::Desc::PollingEvents);
+				VApplicationDesc->SetProperty<Application::Desc>("usize polling_shards", &Application::Desc::PollingShards);
 				VApplicationDesc->SetProperty<Application::Desc>("usize threads", &Application::Desc::Threads);
 				VApplicationDesc->SetProperty<Application::Desc>("usize usage", &Application::Desc::Usage);
 				VApplicationDesc->SetProperty<Application::Desc>("bool daemon", &Application::Desc::Daemon);
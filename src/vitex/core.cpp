@@ -297,46 +297,107 @@ namespace Vitex
 	{
 		namespace Allocators
 		{
-			DebugAllocator::TracingInfo::TracingInfo() : Thread(std::this_thread::get_id()), Time(0), Size(0), Active(false)
+			DebugAllocator::TracingInfo::TracingInfo() : Thread(std::this_thread::get_id()), Time(0), Size(0), Tag(MemoryTag::Default), Active(false)
 			{
 			}
-			DebugAllocator::TracingInfo::TracingInfo(const char* NewTypeName, MemoryLocation&& NewLocation, time_t NewTime, size_t NewSize, bool IsActive, bool IsStatic) : Thread(std::this_thread::get_id()), TypeName(NewTypeName ? NewTypeName : "void"), Location(std::move(NewLocation)), Time(NewTime), Size(NewSize), Active(IsActive), Static(IsStatic)
+			DebugAllocator::TracingInfo::TracingInfo(const char* NewTypeName, MemoryLocation&& NewLocation, time_t NewTime, size_t NewSize, bool IsActive, bool IsStatic) : Thread(std::this_thread::get_id()), TypeName(NewTypeName ? NewTypeName : "void"), Location(std::move(NewLocation)), Time(NewTime), Size(NewSize), Tag(Memory::GetTag()), Active(IsActive), Static(IsStatic)
 			{
 			}
 
+			DebugAllocator::DebugAllocator(size_t SamplingRateBytes, size_t MaxSamplingSites) : SitesDropped(0), Sites(nullptr), SitesCapacity(0), SamplingRate(SamplingRateBytes)
+			{
+				if (!SamplingRate)
+					return;
+
+				SitesCapacity = std::max<size_t>(1, MaxSamplingSites);
+				Sites = (SamplingSite*)malloc(sizeof(SamplingSite) * SitesCapacity);
+				VI_ASSERT(Sites != nullptr, "not enough memory to malloc %" PRIu64 " bytes", (uint64_t)(sizeof(SamplingSite) * SitesCapacity));
+				if (!Sites)
+				{
+					SitesCapacity = 0;
+					SamplingRate = 0;
+					return;
+				}
+
+				for (size_t i = 0; i < SitesCapacity; i++)
+					new(&Sites[i]) SamplingSite();
+			}
+			DebugAllocator::~DebugAllocator() noexcept
+			{
+				for (size_t i = 0; i < SitesCapacity; i++)
+					Sites[i].~SamplingSite();
+				free(Sites);
+			}
 			void* DebugAllocator::Allocate(size_t Size) noexcept
 			{
 				return Allocate(MemoryLocation("[unknown]", "[external]", "void", 0), Size);
 			}
 			void* DebugAllocator::Allocate(MemoryLocation&& Location, size_t Size) noexcept
 			{
+				if (SamplingRate > 0)
+					return SampleAllocate(std::move(Location), Size);
+
 				void* Address = malloc(Size);
 				VI_ASSERT(Address != nullptr, "not enough memory to malloc %" PRIu64 " bytes", (uint64_t)Size);
 
 				UMutex<std::recursive_mutex> Unique(Mutex);
-				Blocks[Address] = TracingInfo(Location.TypeName, std::move(Location), time(nullptr), Size, true, false);
+				auto& Info = Blocks[Address];
+				Info = TracingInfo(Location.TypeName, std::move(Location), time(nullptr), Size, true, false);
+				Statistics.Tags[(size_t)Info.Tag] += Size;
+				Statistics.BytesAllocated += Size;
+				Statistics.BytesInUse += Size;
+				Statistics.BytesPeak = std::max(Statistics.BytesPeak, Statistics.BytesInUse);
+				++Statistics.Allocations;
 				return Address;
 			}
 			void DebugAllocator::Free(void* Address) noexcept
 			{
+				if (SamplingRate > 0)
+				{
+					void* SourceAddress = nullptr;
+					SamplingBlock* Block = (SamplingBlock*)((char*)Address - sizeof(SamplingBlock));
+					memcpy(&SourceAddress, &Block->Self, sizeof(void*));
+					if (SourceAddress != Address)
+						return free(Address);
+
+					if (Block->Site != nullptr)
+					{
+						Block->Site->LiveBytes -= Block->Weight;
+						--Block->Site->LiveCount;
+					}
+					return free(Block);
+				}
+
 				UMutex<std::recursive_mutex> Unique(Mutex);
 				auto It = Blocks.find(Address);
 				VI_ASSERT(It != Blocks.end() && It->second.Active, "cannot free memory that was not allocated by this allocator at 0x%" PRIXPTR, Address);
+				if (It != Blocks.end() && !It->second.Static)
+				{
+					Statistics.Tags[(size_t)It->second.Tag] -= It->second.Size;
+					Statistics.BytesInUse -= It->second.Size;
+					++Statistics.Deallocations;
+				}
 
 				Blocks.erase(It);
 				free(Address);
 			}
 			void DebugAllocator::Transfer(void* Address, size_t Size) noexcept
 			{
-				VI_ASSERT(false, "invalid allocator transfer call without memory context");
+				VI_ASSERT(SamplingRate > 0, "invalid allocator transfer call without memory context");
 			}
 			void DebugAllocator::Transfer(void* Address, MemoryLocation&& Location, size_t Size) noexcept
 			{
+				if (SamplingRate > 0)
+					return;
+
 				UMutex<std::recursive_mutex> Unique(Mutex);
 				Blocks[Address] = TracingInfo(Location.TypeName, std::move(Location), time(nullptr), Size, true, true);
 			}
 			void DebugAllocator::Watch(MemoryLocation&& Location, void* Address) noexcept
 			{
+				if (SamplingRate > 0)
+					return;
+
 				UMutex<std::recursive_mutex> Unique(Mutex);
 				auto It = Watchers.find(Address);
 
@@ -348,6 +409,9 @@ namespace Vitex
 			}
 			void DebugAllocator::Unwatch(void* Address) noexcept
 			{
+				if (SamplingRate > 0)
+					return;
+
 				UMutex<std::recursive_mutex> Unique(Mutex);
 				auto It = Watchers.find(Address);
 
@@ -360,6 +424,9 @@ namespace Vitex
 			}
 			bool DebugAllocator::IsValid(void* Address) noexcept
 			{
+				if (SamplingRate > 0)
+					return true;
+
 				UMutex<std::recursive_mutex> Unique(Mutex);
 				auto It = Blocks.find(Address);
 
@@ -370,9 +437,46 @@ namespace Vitex
 			{
 				return true;
 			}
+			bool DebugAllocator::GetStatistics(AllocationStatistics* Output) noexcept
+			{
+				VI_ASSERT(Output != nullptr, "output should be set");
+				UMutex<std::recursive_mutex> Unique(Mutex);
+				if (!SamplingRate)
+				{
+					*Output = Statistics;
+					Output->Tagged = true;
+					return true;
+				}
+
+				AllocationStatistics Result;
+				for (size_t i = 0; i < SitesCapacity; i++)
+				{
+					SamplingSite& Site = Sites[i];
+					if (!Site.Ready.load(std::memory_order_acquire))
+						continue;
+
+					size_t LiveBytes = Site.LiveBytes.load(std::memory_order_relaxed);
+					size_t LiveCount = Site.LiveCount.load(std::memory_order_relaxed);
+					size_t TotalCount = Site.TotalCount.load(std::memory_order_relaxed);
+					Result.Tags[(size_t)Site.Tag] += LiveBytes;
+					Result.BytesAllocated += Site.TotalBytes.load(std::memory_order_relaxed);
+					Result.BytesInUse += LiveBytes;
+					Result.Allocations += TotalCount;
+					Result.Deallocations += TotalCount - LiveCount;
+				}
+
+				Statistics.BytesPeak = std::max(Statistics.BytesPeak, Result.BytesInUse);
+				Result.BytesPeak = Statistics.BytesPeak;
+				Result.Tagged = true;
+				*Output = std::move(Result);
+				return true;
+			}
 			bool DebugAllocator::Dump(void* Address)
 			{
 #if VI_DLEVEL >= 4
+				if (SamplingRate > 0)
+					return Address ? false : DumpProfile();
+
 				VI_TRACE("[mem] dump internal memory state on 0x%" PRIXPTR, Address);
 				UMutex<std::recursive_mutex> Unique(Mutex);
 				if (Address != nullptr)
@@ -482,6 +586,48 @@ namespace Vitex
 #endif
 				return false;
 			}
+			bool DebugAllocator::DumpProfile()
+			{
+#if VI_DLEVEL >= 4
+				if (!SamplingRate)
+					return false;
+
+				auto Profile = GetProfile();
+				bool LogActive = ErrorHandling::HasFlag(LogOption::Active);
+				if (!LogActive)
+					ErrorHandling::SetFlag(LogOption::Active, true);
+
+				size_t LiveBytes = 0, LiveSites = 0;
+				for (auto& Item : Profile)
+				{
+					if (Item.LiveCount > 0)
+					{
+						LiveBytes += Item.LiveBytes;
+						++LiveSites;
+					}
+				}
+
+				VI_DEBUG("[mem] heap profile: %" PRIu64 " of %" PRIu64 " sites hold ~%" PRIu64 " bytes (sampling every ~%" PRIu64 " bytes, %" PRIu64 " sites dropped)", (uint64_t)LiveSites, (uint64_t)Profile.size(), (uint64_t)LiveBytes, (uint64_t)SamplingRate, (uint64_t)SitesDropped.load());
+				for (auto& Item : Profile)
+				{
+					if (!Item.LiveCount)
+						continue;
+
+					ErrorHandling::Message(LogLevel::Debug, Item.Location.Line, Item.Location.Source, "[mem] site 0x%" PRIX64 " holds ~%" PRIu64 " bytes in %" PRIu64 " sampled blocks as %s at %s() (~%" PRIu64 " bytes allocated in total)",
+						Item.Hash,
+						(uint64_t)Item.LiveBytes,
+						(uint64_t)Item.LiveCount,
+						Item.Location.TypeName ? Item.Location.TypeName : "void",
+						Item.Location.Function ? Item.Location.Function : "[external]",
+						(uint64_t)Item.TotalBytes);
+				}
+
+				ErrorHandling::SetFlag(LogOption::Active, LogActive);
+				return LiveSites > 0;
+#else
+				return false;
+#endif
+			}
 			bool DebugAllocator::FindBlock(void* Address, TracingInfo* Output)
 			{
 				VI_ASSERT(Address != nullptr, "address should not be null");
@@ -499,6 +645,32 @@ namespace Vitex
 
 				return true;
 			}
+			bool DebugAllocator::IsSampling() const
+			{
+				return SamplingRate > 0;
+			}
+			std::vector<DebugAllocator::SamplingInfo> DebugAllocator::GetProfile() const
+			{
+				std::vector<SamplingInfo> Profile;
+				for (size_t i = 0; i < SitesCapacity; i++)
+				{
+					SamplingSite& Site = Sites[i];
+					if (!Site.Ready.load(std::memory_order_acquire))
+						continue;
+
+					SamplingInfo Info;
+					Info.Location = Site.Location;
+					Info.Hash = Site.Hash.load(std::memory_order_relaxed);
+					Info.LiveBytes = Site.LiveBytes.load(std::memory_order_relaxed);
+					Info.LiveCount = Site.LiveCount.load(std::memory_order_relaxed);
+					Info.TotalBytes = Site.TotalBytes.load(std::memory_order_relaxed);
+					Info.TotalCount = Site.TotalCount.load(std::memory_order_relaxed);
+					Profile.push_back(Info);
+				}
+
+				std::sort(Profile.begin(), Profile.end(), [](const SamplingInfo& A, const SamplingInfo& B) { return A.LiveBytes > B.LiveBytes; });
+				return Profile;
+			}
 			const std::unordered_map<void*, DebugAllocator::TracingInfo>& DebugAllocator::GetBlocks() const
 			{
 				return Blocks;
@@ -507,6 +679,102 @@ namespace Vitex
 			{
 				return Watchers;
 			}
+			void* DebugAllocator::SampleAllocate(MemoryLocation&& Location, size_t Size) noexcept
+			{
+				SamplingBlock* Block = (SamplingBlock*)malloc(sizeof(SamplingBlock) + Size);
+				VI_ASSERT(Block != nullptr, "not enough memory to malloc %" PRIu64 " bytes", (uint64_t)(sizeof(SamplingBlock) + Size));
+				if (!Block)
+					return nullptr;
+
+				Block->Site = nullptr;
+				Block->Weight = 0;
+				Block->Self = (char*)Block + sizeof(SamplingBlock);
+
+				SamplingState& State = GetSamplingState();
+				if (State.Active)
+					return (char*)Block + sizeof(SamplingBlock);
+
+				if (!State.Seed)
+					State.Countdown = GetSampleCountdown(State);
+
+				State.Countdown -= (int64_t)Size;
+				if (State.Countdown > 0)
+					return (char*)Block + sizeof(SamplingBlock);
+
+				double Rate = (double)SamplingRate;
+				Block->Weight = Size > 0 ? (size_t)((double)Size / (1.0 - exp(-(double)Size / Rate))) : SamplingRate;
+				State.Active = true;
+				State.Countdown = GetSampleCountdown(State);
+				Block->Site = Sample(std::move(Location), Block->Weight);
+				State.Active = false;
+				return (char*)Block + sizeof(SamplingBlock);
+			}
+			DebugAllocator::SamplingSite* DebugAllocator::Sample(MemoryLocation&& Location, size_t Weight) noexcept
+			{
+				uint64_t Hash = 14695981039346656037ULL;
+				auto Mix = [&Hash](uint64_t Value)
+				{
+					Hash ^= Value;
+					Hash *= 1099511628211ULL;
+				};
+
+				StackTrace Stack(2, 16);
+				for (auto& Frame : Stack)
+				{
+					Mix((uint64_t)(uintptr_t)Frame.Handle);
+					Mix((uint64_t)Frame.Line);
+				}
+
+				MemoryTag Tag = Memory::GetTag();
+				Mix((uint64_t)(uintptr_t)Location.Source);
+				Mix((uint64_t)Location.Line);
+				Mix((uint64_t)Tag);
+				if (!Hash)
+					Hash = 1;
+
+				size_t Offset = (size_t)(Hash % SitesCapacity);
+				for (size_t i = 0; i < SitesCapacity; i++)
+				{
+					SamplingSite* Site = &Sites[(Offset + i) % SitesCapacity];
+					uint64_t Current = 0;
+					if (Site->Hash.compare_exchange_strong(Current, Hash, std::memory_order_acq_rel))
+					{
+						Site->Location = std::move(Location);
+						Site->Tag = Tag;
+						Site->Ready.store(true, std::memory_order_release);
+						Current = Hash;
+					}
+
+					if (Current != Hash)
+						continue;
+
+					Site->LiveBytes += Weight;
+					Site->TotalBytes += Weight;
+					++Site->LiveCount;
+					++Site->TotalCount;
+					return Site;
+				}
+
+				++SitesDropped;
+				return nullptr;
+			}
+			int64_t DebugAllocator::GetSampleCountdown(SamplingState& State) noexcept
+			{
+				if (!State.Seed)
+					State.Seed = (uint64_t)std::hash<std::thread::id>()(std::this_thread::get_id()) | 1;
+
+				State.Seed ^= State.Seed << 13;
+				State.Seed ^= State.Seed >> 7;
+				State.Seed ^= State.Seed << 17;
+
+				double Uniform = (double)((State.Seed >> 11) + 1) / 9007199254740992.0;
+				return (int64_t)(-log(Uniform) * (double)SamplingRate) + 1;
+			}
+			DebugAllocator::SamplingState& DebugAllocator::GetSamplingState() noexcept
+			{
+				static thread_local SamplingState State;
+				return State;
+			}
 
 			void* DefaultAllocator::Allocate(size_t Size) noexcept
 			{
@@ -575,6 +843,10 @@ namespace Vitex
 
 				PageAddress* Address = Cache->Addresses.back();
 				Cache->Addresses.pop_back();
+				Statistics.BytesAllocated += Cache->Size;
+				Statistics.BytesInUse += Cache->Size;
+				Statistics.BytesPeak = std::max(Statistics.BytesPeak, Statistics.BytesInUse);
+				++Statistics.Allocations;
 				return Address->Address;
 			}
 			void* CachedAllocator::Allocate(MemoryLocation&&, size_t Size) noexcept
@@ -594,9 +866,12 @@ namespace Vitex
 
 				UMutex<std::recursive_mutex> Unique(Mutex);
 				Cache->Addresses.push_back(Source);
+				Statistics.BytesInUse -= Cache->Size;
+				++Statistics.Deallocations;
 
 				if (Cache->Addresses.size() >= Cache->Capacity && (Cache->Capacity == 1 || GetClock() - Cache->Timing > (int64_t)MinimalLifeTime))
 				{
+					Statistics.BytesReserved -= sizeof(PageCache) + (sizeof(PageAddress) + Cache->Size) * Cache->Capacity;
 					Cache->Page.erase(std::find(Cache->Page.begin(), Cache->Page.end(), Cache));
 					Cache->~PageCache();
 					free(Cache);
@@ -625,6 +900,28 @@ namespace Vitex
 			{
 				return false;
 			}
+			bool CachedAllocator::GetStatistics(AllocationStatistics* Output) noexcept
+			{
+				VI_ASSERT(Output != nullptr, "output should be set");
+				UMutex<std::recursive_mutex> Unique(Mutex);
+				*Output = Statistics;
+				Output->Classes.reserve(Pages.size());
+				for (auto& Page : Pages)
+				{
+					AllocationStatistics::SizeClass Next;
+					Next.Size = Page.first;
+					for (auto* Cache : Page.second)
+					{
+						Next.Capacity += Cache->Capacity;
+						Next.Used += Cache->Capacity - Cache->Addresses.size();
+					}
+					if (Next.Capacity > 0)
+						Output->Classes.push_back(Next);
+				}
+
+				std::sort(Output->Classes.begin(), Output->Classes.end(), [](const AllocationStatistics::SizeClass& A, const AllocationStatistics::SizeClass& B) { return A.Size < B.Size; });
+				return true;
+			}
 			CachedAllocator::PageCache* CachedAllocator::GetPageCache(size_t Size)
 			{
 				auto& Page = Pages[Size];
@@ -644,7 +941,8 @@ namespace Vitex
 					return nullptr;
 
 				char* BaseAddress = (char*)Cache + sizeof(PageCache);
-				new(Cache) PageCache(Page, GetClock(), PageElements);
+				new(Cache) PageCache(Page, GetClock(), PageElements, Size);
+				Statistics.BytesReserved += PageSize;
 				for (size_t i = 0; i < PageElements; i++)
 				{
 					PageAddress* Next = (PageAddress*)(BaseAddress + AddressSize * i);
@@ -695,6 +993,418 @@ namespace Vitex
 				return (size_t)Total;
 			}
 
+			ThreadAllocator::ThreadLocal::~ThreadLocal() noexcept
+			{
+				Exiting = true;
+				if (!Cache)
+					return;
+
+				UMutex<std::mutex> Unique(GetRegistryMutex());
+				if (GetRegistry().count(Id) > 0)
+					Cache->Orphaned = true;
+				Cache = nullptr;
+			}
+			ThreadAllocator::ThreadAllocator(uint64_t MinimalLifeTimeMs, size_t SpanSizeBytes) : BytesReserved(0), BytesPeak(0), Caches(nullptr), MinimalLifeTime(MinimalLifeTimeMs), Id(0), SpanSize(SpanSizeBytes)
+			{
+				static std::atomic<uint64_t> Identifiers(0);
+				VI_ASSERT(SpanSize > 0, "span size should be greater then zero");
+				Id = ++Identifiers;
+
+				UMutex<std::mutex> Unique(GetRegistryMutex());
+				GetRegistry().insert(Id);
+			}
+			ThreadAllocator::~ThreadAllocator() noexcept
+			{
+				{
+					UMutex<std::mutex> Unique(GetRegistryMutex());
+					GetRegistry().erase(Id);
+				}
+
+				while (Caches != nullptr)
+				{
+					ThreadCache* Cache = Caches;
+					for (auto& Target : Cache->Bins)
+					{
+						Span* Next = Target.Head;
+						while (Next != nullptr)
+						{
+							Span* Source = Next;
+							Next = Next->Next;
+							Source->~Span();
+							free(Source);
+						}
+					}
+					Caches = Cache->Next;
+					Cache->~ThreadCache();
+					free(Cache);
+				}
+			}
+			void* ThreadAllocator::Allocate(size_t Size) noexcept
+			{
+				ThreadCache* Cache = GetThreadCache();
+				uint8_t Tag = (uint8_t)Memory::GetTag();
+				if (!Cache || Size > MaxClassSize)
+				{
+					Block* Next = (Block*)malloc(sizeof(Block) + Size);
+					VI_ASSERT(Next != nullptr, "not enough memory to malloc %" PRIu64 " bytes", (uint64_t)(sizeof(Block) + Size));
+					if (!Next)
+						return nullptr;
+
+					Next->Source = nullptr;
+					Next->Size = Size;
+					Next->Tag = Tag;
+					Next->Self = (char*)Next + sizeof(Block);
+					Account(Cache, Size, Tag, true);
+					return Next->Self;
+				}
+
+				size_t Index = GetClassIndex(Size);
+				Span* Source = Cache->Bins[Index].Current;
+				if (!Source || !Source->Local)
+				{
+					Source = GetSpan(Cache, Index);
+					if (!Source)
+						return nullptr;
+				}
+
+				Block* Next = (Block*)Source->Local;
+				memcpy(&Source->Local, (char*)Next + sizeof(Block), sizeof(void*));
+				Next->Size = Size;
+				Next->Tag = Tag;
+				Next->Self = (char*)Next + sizeof(Block);
+				++Source->Used;
+				Account(Cache, Size, Tag, true);
+				return Next->Self;
+			}
+			void* ThreadAllocator::Allocate(MemoryLocation&&, size_t Size) noexcept
+			{
+				return Allocate(Size);
+			}
+			void ThreadAllocator::Free(void* Address) noexcept
+			{
+				void* SourceAddress = nullptr;
+				Block* Next = (Block*)((char*)Address - sizeof(Block));
+				memcpy(&SourceAddress, &Next->Self, sizeof(void*));
+				if (SourceAddress != Address)
+					return free(Address);
+
+				ThreadCache* Cache = GetThreadCache();
+				Account(Cache, (size_t)Next->Size, (uint8_t)Next->Tag, false);
+
+				Span* Source = Next->Source;
+				if (!Source)
+					return free(Next);
+
+				if (Cache != nullptr && Cache == Source->Owner)
+				{
+					memcpy(Address, &Source->Local, sizeof(void*));
+					Source->Local = Next;
+					if (--Source->Used > 0 || Cache->Bins[Source->Index].Count < 2)
+						return;
+
+					int64_t Time = GetClock();
+					Source->Timing = Time;
+					if (Time - Cache->Timing > (int64_t)MinimalLifeTime)
+						Release(Cache, Time);
+					return;
+				}
+
+				void* Head = Source->Remote.load(std::memory_order_relaxed);
+				do
+				{
+					memcpy(Address, &Head, sizeof(void*));
+				} while (!Source->Remote.compare_exchange_weak(Head, Next, std::memory_order_release, std::memory_order_relaxed));
+			}
+			void ThreadAllocator::Transfer(void* Address, size_t Size) noexcept
+			{
+			}
+			void ThreadAllocator::Transfer(void* Address, MemoryLocation&& Location, size_t Size) noexcept
+			{
+			}
+			void ThreadAllocator::Watch(MemoryLocation&& Location, void* Address) noexcept
+			{
+			}
+			void ThreadAllocator::Unwatch(void* Address) noexcept
+			{
+			}
+			void ThreadAllocator::Finalize() noexcept
+			{
+			}
+			bool ThreadAllocator::IsValid(void* Address) noexcept
+			{
+				return true;
+			}
+			bool ThreadAllocator::IsFinalizable() noexcept
+			{
+				return false;
+			}
+			bool ThreadAllocator::GetStatistics(AllocationStatistics* Output) noexcept
+			{
+				VI_ASSERT(Output != nullptr, "output should be set");
+				AllocationStatistics Result;
+				UMutex<std::mutex> Unique(Mutex);
+				Summarize(&Result);
+				Result.BytesReserved = BytesReserved.load(std::memory_order_relaxed);
+				Result.BytesPeak = BytesPeak.load(std::memory_order_relaxed);
+				Result.Tagged = true;
+				*Output = std::move(Result);
+				return true;
+			}
+			ThreadAllocator::ThreadCache* ThreadAllocator::GetThreadCache() noexcept
+			{
+				ThreadLocal& Local = GetThreadLocal();
+				if (Local.Id == Id && Local.Cache != nullptr)
+					return Local.Cache;
+				else if (Local.Exiting)
+					return nullptr;
+
+				if (Local.Cache != nullptr)
+				{
+					UMutex<std::mutex> Unique(GetRegistryMutex());
+					if (GetRegistry().count(Local.Id) > 0)
+						Local.Cache->Orphaned = true;
+					Local.Cache = nullptr;
+				}
+
+				UMutex<std::mutex> Unique(Mutex);
+				ThreadCache* Cache = Caches;
+				while (Cache != nullptr)
+				{
+					bool Orphaned = true;
+					if (Cache->Orphaned.compare_exchange_strong(Orphaned, false))
+						break;
+					Cache = Cache->Next;
+				}
+
+				if (!Cache)
+				{
+					Cache = (ThreadCache*)malloc(sizeof(ThreadCache));
+					VI_ASSERT(Cache != nullptr, "not enough memory to malloc %" PRIu64 " bytes", (uint64_t)sizeof(ThreadCache));
+					if (!Cache)
+						return nullptr;
+
+					new(Cache) ThreadCache();
+					Cache->Timing = GetClock();
+					Cache->Next = Caches;
+					Caches = Cache;
+				}
+
+				Local.Cache = Cache;
+				Local.Id = Id;
+				return Cache;
+			}
+			ThreadAllocator::Span* ThreadAllocator::GetSpan(ThreadCache* Cache, size_t Index) noexcept
+			{
+				Bin& Target = Cache->Bins[Index];
+				for (Span* Next = Target.Head; Next != nullptr; Next = Next->Next)
+				{
+					if (Next->Remote.load(std::memory_order_relaxed) != nullptr)
+						Drain(Next);
+
+					if (Next->Local != nullptr)
+					{
+						Target.Current = Next;
+						return Next;
+					}
+				}
+
+				int64_t Time = GetClock();
+				if (Time - Cache->Timing > (int64_t)MinimalLifeTime)
+					Release(Cache, Time);
+
+				size_t Stride = sizeof(Block) + GetClassSize(Index);
+				size_t Offset = (sizeof(Span) + sizeof(Block) - 1) / sizeof(Block) * sizeof(Block);
+				size_t Capacity = std::max<size_t>(8, SpanSize > Offset ? (SpanSize - Offset) / Stride : 0);
+				size_t Size = Offset + Stride * Capacity;
+				Span* Source = (Span*)malloc(Size);
+				VI_ASSERT(Source != nullptr, "not enough memory to malloc %" PRIu64 " bytes", (uint64_t)Size);
+				if (!Source)
+					return nullptr;
+
+				new(Source) Span();
+				Source->Remote = nullptr;
+				Source->Owner = Cache;
+				Source->Next = Target.Head;
+				Source->Prev = nullptr;
+				Source->Local = nullptr;
+				Source->Index = Index;
+				Source->Capacity = Capacity;
+				Source->Used = 0;
+				Source->Timing = Time;
+
+				char* BaseAddress = (char*)Source + Offset;
+				for (size_t i = Capacity; i-- > 0;)
+				{
+					Block* Next = (Block*)(BaseAddress + Stride * i);
+					Next->Source = Source;
+					Next->Size = 0;
+					memcpy((char*)Next + sizeof(Block), &Source->Local, sizeof(void*));
+					Source->Local = Next;
+				}
+
+				if (Target.Head != nullptr)
+					Target.Head->Prev = Source;
+				Target.Head = Source;
+				Target.Current = Source;
+				++Target.Count;
+				BytesReserved += Size;
+
+				UMutex<std::mutex> Unique(Mutex);
+				Summarize(nullptr);
+				return Source;
+			}
+			void ThreadAllocator::Release(ThreadCache* Cache, int64_t Time) noexcept
+			{
+				Cache->Timing = Time;
+				for (auto& Target : Cache->Bins)
+				{
+					Span* Next = Target.Head;
+					while (Next != nullptr && Target.Count > 1)
+					{
+						Span* Source = Next;
+						Next = Next->Next;
+						if (Source->Remote.load(std::memory_order_relaxed) != nullptr)
+							Drain(Source);
+
+						if (Source->Used > 0 || Time - Source->Timing <= (int64_t)MinimalLifeTime)
+							continue;
+
+						if (Source->Prev != nullptr)
+							Source->Prev->Next = Next;
+						else
+							Target.Head = Next;
+						if (Next != nullptr)
+							Next->Prev = Source->Prev;
+						if (Target.Current == Source)
+							Target.Current = Target.Head;
+
+						--Target.Count;
+						BytesReserved -= (sizeof(Span) + sizeof(Block) - 1) / sizeof(Block) * sizeof(Block) + (sizeof(Block) + GetClassSize(Source->Index)) * Source->Capacity;
+						Source->~Span();
+						free(Source);
+					}
+				}
+			}
+			void ThreadAllocator::Account(ThreadCache* Cache, size_t Size, uint8_t Tag, bool Allocation) noexcept
+			{
+				if (!Cache)
+				{
+					if (Allocation)
+					{
+						Detached.Tags[Tag].fetch_add(Size, std::memory_order_relaxed);
+						Detached.BytesAllocated.fetch_add(Size, std::memory_order_relaxed);
+						Detached.Allocations.fetch_add(1, std::memory_order_relaxed);
+					}
+					else
+					{
+						Detached.Tags[Tag].fetch_sub(Size, std::memory_order_relaxed);
+						Detached.BytesDeallocated.fetch_add(Size, std::memory_order_relaxed);
+						Detached.Deallocations.fetch_add(1, std::memory_order_relaxed);
+					}
+					return;
+				}
+
+				auto& Stats = Cache->Stats;
+				if (Allocation)
+				{
+					Stats.Tags[Tag].store(Stats.Tags[Tag].load(std::memory_order_relaxed) + Size, std::memory_order_relaxed);
+					Stats.BytesAllocated.store(Stats.BytesAllocated.load(std::memory_order_relaxed) + Size, std::memory_order_relaxed);
+					Stats.Allocations.store(Stats.Allocations.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+				}
+				else
+				{
+					Stats.Tags[Tag].store(Stats.Tags[Tag].load(std::memory_order_relaxed) - Size, std::memory_order_relaxed);
+					Stats.BytesDeallocated.store(Stats.BytesDeallocated.load(std::memory_order_relaxed) + Size, std::memory_order_relaxed);
+					Stats.Deallocations.store(Stats.Deallocations.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+				}
+			}
+			uint64_t ThreadAllocator::Summarize(AllocationStatistics* Output) noexcept
+			{
+				uint64_t BytesAllocated = 0, BytesDeallocated = 0;
+				auto Append = [&](Counters& Next)
+				{
+					BytesAllocated += Next.BytesAllocated.load(std::memory_order_relaxed);
+					BytesDeallocated += Next.BytesDeallocated.load(std::memory_order_relaxed);
+					if (!Output)
+						return;
+
+					Output->Allocations += Next.Allocations.load(std::memory_order_relaxed);
+					Output->Deallocations += Next.Deallocations.load(std::memory_order_relaxed);
+					for (size_t i = 0; i < (size_t)MemoryTag::Count; i++)
+						Output->Tags[i] += Next.Tags[i].load(std::memory_order_relaxed);
+				};
+
+				Append(Detached);
+				for (ThreadCache* Cache = Caches; Cache != nullptr; Cache = Cache->Next)
+					Append(Cache->Stats);
+
+				uint64_t BytesInUse = BytesAllocated - BytesDeallocated;
+				uint64_t Peak = BytesPeak.load(std::memory_order_relaxed);
+				while (BytesInUse > Peak && !BytesPeak.compare_exchange_weak(Peak, BytesInUse, std::memory_order_relaxed));
+				if (Output != nullptr)
+				{
+					Output->BytesAllocated = BytesAllocated;
+					Output->BytesInUse = BytesInUse;
+				}
+
+				return BytesInUse;
+			}
+			size_t ThreadAllocator::Drain(Span* Source) noexcept
+			{
+				void* Head = Source->Remote.exchange(nullptr, std::memory_order_acquire);
+				size_t Count = 0;
+				while (Head != nullptr)
+				{
+					void* Next = nullptr;
+					memcpy(&Next, (char*)Head + sizeof(Block), sizeof(void*));
+					memcpy((char*)Head + sizeof(Block), &Source->Local, sizeof(void*));
+					Source->Local = Head;
+					Head = Next;
+					++Count;
+				}
+
+				Source->Used -= Count;
+				return Count;
+			}
+			int64_t ThreadAllocator::GetClock() noexcept
+			{
+				return (int64_t)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+			}
+			ThreadAllocator::ThreadLocal& ThreadAllocator::GetThreadLocal() noexcept
+			{
+				static thread_local ThreadLocal Local;
+				return Local;
+			}
+			std::mutex& ThreadAllocator::GetRegistryMutex() noexcept
+			{
+				static std::mutex Mutex;
+				return Mutex;
+			}
+			std::unordered_set<uint64_t>& ThreadAllocator::GetRegistry() noexcept
+			{
+				static std::unordered_set<uint64_t> Registry;
+				return Registry;
+			}
+			size_t ThreadAllocator::GetClassIndex(size_t Size) noexcept
+			{
+				if (Size <= 128)
+					return Size > 0 ? (Size - 1) >> 4 : 0;
+
+				size_t Value = Size - 1, Bits = 7;
+				while (Value >> (Bits + 1))
+					++Bits;
+
+				return 8 + (Bits - 7) * 4 + ((Value - ((size_t)1 << Bits)) >> (Bits - 2));
+			}
+			size_t ThreadAllocator::GetClassSize(size_t Index) noexcept
+			{
+				if (Index < 8)
+					return (Index + 1) << 4;
+
+				size_t Offset = Index - 8, Bits = 7 + Offset / 4;
+				return ((size_t)1 << Bits) + (Offset % 4 + 1) * ((size_t)1 << (Bits - 2));
+			}
+
 			LinearAllocator::LinearAllocator(size_t Size) : Top(nullptr), Bottom(nullptr), LatestSize(0), Sizing(Size)
 			{
 				if (Sizing > 0)
@@ -902,134 +1612,506 @@ namespace Vitex
 				Bottom = Next;
 				Memory::SetLocalAllocator(Current);
 			}
-			void StackAllocator::FlushRegions() noexcept
+			void StackAllocator::FlushRegions() noexcept
+			{
+				LocalAllocator* Current = Memory::GetLocalAllocator();
+				Memory::SetLocalAllocator(nullptr);
+
+				Region* Next = Bottom;
+				Bottom = nullptr;
+				Top = nullptr;
+
+				while (Next != nullptr)
+				{
+					void* Address = (void*)Next;
+					Next = Next->UpperAddress;
+					Memory::Deallocate(Address);
+				}
+
+				Memory::SetLocalAllocator(Current);
+			}
+			size_t StackAllocator::GetLeftovers() const noexcept
+			{
+				if (!Bottom)
+					return 0;
+
+				char* MaxAddress = Bottom->BaseAddress + Bottom->Size;
+				char* OffsetAddress = Bottom->FreeAddress;
+				return MaxAddress - OffsetAddress;
+			}
+		}
+
+		typedef moodycamel::BlockingConcurrentQueue<TaskCallback> FastQueue;
+		typedef moodycamel::ConsumerToken ReceiveToken;
+
+		struct Measurement
+		{
+#ifndef NDEBUG
+			const char* File = nullptr;
+			const char* Function = nullptr;
+			void* Id = nullptr;
+			uint64_t Threshold = 0;
+			uint64_t Time = 0;
+			int Line = 0;
+
+			void NotifyOfOverConsumption()
+			{
+				if (Threshold == (uint64_t)Timings::Infinite)
+					return;
+
+				uint64_t Delta = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count() - Time;
+				if (Delta <= Threshold)
+					return;
+
+				String BackTrace = ErrorHandling::GetMeasureTrace();
+				VI_WARN("[stall] sync operation took %" PRIu64 " ms (%" PRIu64 " us), back trace %s", Delta / 1000, Delta, BackTrace.c_str());
+			}
+#endif
+		};
+
+		struct Cocontext
+		{
+#ifdef VI_FCONTEXT
+			fcontext_t Context = nullptr;
+			char* Stack = nullptr;
+#elif VI_MICROSOFT
+			LPVOID Context = nullptr;
+			bool Main = false;
+#else
+			ucontext_t Context = nullptr;
+			char* Stack = nullptr;
+#endif
+			Cocontext()
+			{
+#ifndef VI_FCONTEXT
+#ifdef VI_MICROSOFT
+				Context = ConvertThreadToFiber(nullptr);
+				Main = true;
+#endif
+#endif
+			}
+			Cocontext(Costate* State)
+			{
+#ifdef VI_FCONTEXT
+				Stack = Memory::Allocate<char>(sizeof(char) * State->Size);
+				Context = make_fcontext(Stack + State->Size, State->Size, [](transfer_t Transfer)
+				{
+					Costate::ExecutionEntry(&Transfer);
+				});
+#elif VI_MICROSOFT
+				Context = CreateFiber(State->Size, &Costate::ExecutionEntry, (LPVOID)State);
+#else
+				getcontext(&Context);
+				Stack = Memory::Allocate<char>(sizeof(char) * State->Size);
+				Context.uc_stack.ss_sp = Stack;
+				Context.uc_stack.ss_size = State->Size;
+				Context.uc_stack.ss_flags = 0;
+				Context.uc_link = &State->Master->Context;
+
+				int X, Y;
+				Pack2_64((void*)State, &X, &Y);
+				makecontext(&Context, (void(*)()) & Costate::ExecutionEntry, 2, X, Y);
+#endif
+			}
+			~Cocontext()
+			{
+#ifdef VI_FCONTEXT
+				Memory::Deallocate(Stack);
+#elif VI_MICROSOFT
+				if (Main)
+					ConvertFiberToThread();
+				else if (Context != nullptr)
+					DeleteFiber(Context);
+#else
+				Memory::Deallocate(Stack);
+#endif
+			}
+		};
+
+		struct ConcurrentSyncQueue
+		{
+			FastQueue Queue;
+		};
+
+		struct ConcurrentAsyncQueue : ConcurrentSyncQueue
+		{
+			std::condition_variable Notify;
+			std::mutex Update;
+			std::atomic<bool> Resync = true;
+		};
+
+		struct ConcurrentTimeoutQueue
+		{
+			static constexpr size_t Levels = 5;
+			static constexpr size_t RootBits = 8;
+			static constexpr size_t LevelBits = 6;
+			static constexpr size_t RootSlots = (size_t)1 << RootBits;
+			static constexpr size_t LevelSlots = (size_t)1 << LevelBits;
+			static constexpr size_t Stripes = 16;
+			static constexpr uint64_t Resolution = 1000;
+
+			struct Node
+			{
+				Timeout Task;
+				Node* Prev = nullptr;
+				Node* Next = nullptr;
+				uint64_t Tick;
+				uint8_t Level = 0;
+				uint8_t Slot = 0;
+				std::atomic<uint32_t> Leases = 0;
+				bool Linked = false;
+				bool Cancelled = false;
+
+				Node(Timeout&& NewTask, uint64_t NewTick) noexcept : Task(std::move(NewTask)), Tick(NewTick)
+				{
+				}
+			};
+
+			struct Lease
+			{
+				ConcurrentTimeoutQueue* Base;
+				Node* Target;
+
+				Lease(ConcurrentTimeoutQueue* NewBase, Node* NewTarget) noexcept : Base(NewBase), Target(NewTarget)
+				{
+					++Target->Leases;
+				}
+				Lease(const Lease& Other) noexcept : Base(Other.Base), Target(Other.Target)
+				{
+					if (Target != nullptr)
+						++Target->Leases;
+				}
+				Lease(Lease&& Other) noexcept : Base(Other.Base), Target(Other.Target)
+				{
+					Other.Target = nullptr;
+				}
+				~Lease() noexcept
+				{
+					if (Target != nullptr && !--Target->Leases)
+						Base->Release(Target);
+				}
+				Lease& operator= (const Lease&) = delete;
+				Lease& operator= (Lease&&) = delete;
+				void operator()()
+				{
+					Node* Next = Target;
+					if (!Next)
+						return;
+
+					Next->Task.Callback();
+					Target = nullptr;
+					if (!--Next->Leases)
+						Base->Rearm(Next);
+				}
+			};
+
+			struct Buffer
+			{
+				Vector<Node*> Queue;
+				std::mutex Update;
+			};
+
+			Node* Wheel[Levels][RootSlots] = { };
+			uint64_t Occupancy[Levels][RootSlots / 64] = { };
+			Buffer Buffers[Stripes];
+			UnorderedMap<TaskId, Node*> Index;
+			Vector<Node*> Batch;
+			std::condition_variable Notify;
+			std::mutex Update;
+			std::atomic<uint64_t> NextWake = 0;
+			std::atomic<size_t> Size = 0;
+			std::atomic<bool> Pending = false;
+			uint64_t Current = 0;
+			bool Resync = true;
+
+			ConcurrentTimeoutQueue()
+			{
+				Current = GetTick(Schedule::GetClock());
+			}
+			~ConcurrentTimeoutQueue()
+			{
+				Clear(nullptr);
+			}
+			void Push(Timeout&& Task, std::chrono::microseconds Expires)
+			{
+				static thread_local size_t Stripe = std::hash<std::thread::id>()(std::this_thread::get_id()) % Stripes;
+				Node* Target = Memory::New<Node>(std::move(Task), GetTick(Expires));
+				uint64_t Deadline = Target->Tick * Resolution;
+				{
+					UMutex<std::mutex> Unique(Buffers[Stripe].Update);
+					Buffers[Stripe].Queue.push_back(Target);
+				}
+
+				++Size;
+				Pending = true;
+				if (Deadline < NextWake.load())
+				{
+					UMutex<std::mutex> Unique(Update);
+					Resync = true;
+					Notify.notify_all();
+				}
+			}
+			void Rearm(Node* Target)
+			{
+				UMutex<std::mutex> Unique(Update);
+				if (Target->Cancelled)
+					return Memory::Delete(Target);
+
+				Target->Tick = GetTick(Schedule::GetClock() + Target->Task.Expires);
+				Link(Target);
+				++Size;
+
+				if (Target->Tick * Resolution < NextWake.load())
+				{
+					Resync = true;
+					Notify.notify_all();
+				}
+			}
+			void Release(Node* Target)
+			{
+				UMutex<std::mutex> Unique(Update);
+				if (!Target->Cancelled)
+					Index.erase(Target->Task.Id);
+				Memory::Delete(Target);
+			}
+			void Flush()
+			{
+				if (!Pending.exchange(false))
+					return;
+
+				for (auto& Next : Buffers)
+				{
+					{
+						UMutex<std::mutex> Unique(Next.Update);
+						if (Next.Queue.empty())
+							continue;
+						Batch.swap(Next.Queue);
+					}
+					for (auto* Target : Batch)
+					{
+						Index[Target->Task.Id] = Target;
+						Link(Target);
+					}
+					Batch.clear();
+				}
+			}
+			bool Cancel(TaskId Id)
+			{
+				Flush();
+				auto It = Index.find(Id);
+				if (It == Index.end())
+					return false;
+
+				Node* Target = It->second;
+				Index.erase(It);
+				if (!Target->Linked)
+				{
+					Target->Cancelled = true;
+					return true;
+				}
+
+				Unlink(Target);
+				Memory::Delete(Target);
+				--Size;
+				return true;
+			}
+			size_t Expire(std::chrono::microseconds Clock, bool Repeatable, Vector<TaskCallback>& Tasks)
+			{
+				Flush();
+				uint64_t Tick = Clock.count() / Resolution;
+				size_t Count = Tasks.size();
+				while (Current <= Tick)
+				{
+					if (!Size)
+					{
+						Current = Tick + 1;
+						break;
+					}
+
+					uint64_t Next = GetNextTick();
+					if (Next > Current)
+					{
+						Current = std::min(Next, Tick + 1);
+						continue;
+					}
+
+					size_t Slot = (size_t)(Current & (RootSlots - 1));
+					if (!Slot && !Cascade(1) && !Cascade(2) && !Cascade(3))
+						Cascade(4);
+
+					Node* Target = Detach(0, Slot);
+					while (Target != nullptr)
+					{
+						Node* Next = Target->Next;
+						Target->Prev = Target->Next = nullptr;
+						Target->Linked = false;
+						--Size;
+
+						if (Target->Task.Alive && Repeatable)
+							Tasks.emplace_back(Lease(this, Target));
+						else
+						{
+							Index.erase(Target->Task.Id);
+							Tasks.emplace_back(std::move(Target->Task.Callback));
+							Memory::Delete(Target);
+						}
+						Target = Next;
+					}
+					++Current;
+				}
+				return Tasks.size() - Count;
+			}
+			size_t Clear(Vector<TaskCallback>* Tasks)
+			{
+				Pending = true;
+				Flush();
+
+				size_t Count = 0;
+				for (size_t Level = 0; Level < Levels; Level++)
+				{
+					for (size_t Slot = 0; Slot < RootSlots; Slot++)
+					{
+						Node* Target = Detach(Level, Slot);
+						while (Target != nullptr)
+						{
+							Node* Next = Target->Next;
+							if (Tasks != nullptr)
+								Tasks->emplace_back(std::move(Target->Task.Callback));
+							Index.erase(Target->Task.Id);
+							Memory::Delete(Target);
+							Target = Next;
+							++Count;
+						}
+					}
+				}
+
+				for (auto& Item : Index)
+					Item.second->Cancelled = true;
+
+				Index.clear();
+				Size = 0;
+				return Count;
+			}
+			std::chrono::microseconds GetWakeup(std::chrono::microseconds Clock, std::chrono::microseconds Idle)
 			{
-				LocalAllocator* Current = Memory::GetLocalAllocator();
-				Memory::SetLocalAllocator(nullptr);
+				if (!Size)
+					return Idle;
 
-				Region* Next = Bottom;
-				Bottom = nullptr;
-				Top = nullptr;
+				uint64_t Deadline = GetNextTick() * Resolution;
+				if (Deadline <= (uint64_t)Clock.count())
+					return std::chrono::microseconds(0);
 
-				while (Next != nullptr)
+				return std::min(std::chrono::microseconds(Deadline - (uint64_t)Clock.count()), Idle);
+			}
+			uint64_t GetNextTick() const
+			{
+				size_t Slot = (size_t)(Current & (RootSlots - 1));
+				if (!Slot)
+					return Current;
+
+				size_t Word = Slot / 64;
+				uint64_t Mask = Occupancy[0][Word] & (~(uint64_t)0 << (Slot % 64));
+				while (true)
 				{
-					void* Address = (void*)Next;
-					Next = Next->UpperAddress;
-					Memory::Deallocate(Address);
+					if (Mask != 0)
+						return Current + (Word * 64 + GetLowestBit(Mask) - Slot);
+					else if (++Word >= RootSlots / 64)
+						return (Current | (RootSlots - 1)) + 1;
+					Mask = Occupancy[0][Word];
 				}
-
-				Memory::SetLocalAllocator(Current);
 			}
-			size_t StackAllocator::GetLeftovers() const noexcept
+			size_t Cascade(size_t Level)
 			{
-				if (!Bottom)
-					return 0;
-
-				char* MaxAddress = Bottom->BaseAddress + Bottom->Size;
-				char* OffsetAddress = Bottom->FreeAddress;
-				return MaxAddress - OffsetAddress;
+				size_t Slot = (size_t)((Current >> (RootBits + (Level - 1) * LevelBits)) & (LevelSlots - 1));
+				Node* Target = Detach(Level, Slot);
+				while (Target != nullptr)
+				{
+					Node* Next = Target->Next;
+					Target->Prev = Target->Next = nullptr;
+					Target->Linked = false;
+					Link(Target);
+					Target = Next;
+				}
+				return Slot;
 			}
-		}
+			Node* Detach(size_t Level, size_t Slot)
+			{
+				Node* Target = Wheel[Level][Slot];
+				if (!Target)
+					return nullptr;
 
-		typedef moodycamel::BlockingConcurrentQueue<TaskCallback> FastQueue;
-		typedef moodycamel::ConsumerToken ReceiveToken;
+				Wheel[Level][Slot] = nullptr;
+				Occupancy[Level][Slot / 64] &= ~((uint64_t)1 << (Slot % 64));
+				return Target;
+			}
+			void Link(Node* Target)
+			{
+				uint64_t Tick = std::max(Target->Tick, Current);
+				uint64_t Delta = Tick - Current;
+				size_t Level = 0, Slot = 0;
+				if (Delta < RootSlots)
+					Slot = (size_t)(Tick & (RootSlots - 1));
+				else
+				{
+					const uint64_t Limit = ((uint64_t)1 << (RootBits + (Levels - 1) * LevelBits)) - 1;
+					if (Delta > Limit)
+						Tick = Current + Limit;
 
-		struct Measurement
-		{
-#ifndef NDEBUG
-			const char* File = nullptr;
-			const char* Function = nullptr;
-			void* Id = nullptr;
-			uint64_t Threshold = 0;
-			uint64_t Time = 0;
-			int Line = 0;
+					for (Level = 1; Level < Levels - 1; Level++)
+					{
+						if (Delta < ((uint64_t)1 << (RootBits + Level * LevelBits)))
+							break;
+					}
+					Slot = (size_t)((Tick >> (RootBits + (Level - 1) * LevelBits)) & (LevelSlots - 1));
+				}
 
-			void NotifyOfOverConsumption()
+				Node*& Head = Wheel[Level][Slot];
+				Target->Level = (uint8_t)Level;
+				Target->Slot = (uint8_t)Slot;
+				Target->Linked = true;
+				Target->Prev = nullptr;
+				Target->Next = Head;
+				if (Head != nullptr)
+					Head->Prev = Target;
+				Head = Target;
+				Occupancy[Level][Slot / 64] |= (uint64_t)1 << (Slot % 64);
+			}
+			void Unlink(Node* Target)
 			{
-				if (Threshold == (uint64_t)Timings::Infinite)
-					return;
+				if (Target->Prev != nullptr)
+					Target->Prev->Next = Target->Next;
+				else
+					Wheel[Target->Level][Target->Slot] = Target->Next;
 
-				uint64_t Delta = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count() - Time;
-				if (Delta <= Threshold)
-					return;
+				if (Target->Next != nullptr)
+					Target->Next->Prev = Target->Prev;
 
-				String BackTrace = ErrorHandling::GetMeasureTrace();
-				VI_WARN("[stall] sync operation took %" PRIu64 " ms (%" PRIu64 " us), back trace %s", Delta / 1000, Delta, BackTrace.c_str());
-			}
-#endif
-		};
+				if (!Wheel[Target->Level][Target->Slot])
+					Occupancy[Target->Level][Target->Slot / 64] &= ~((uint64_t)1 << (Target->Slot % 64));
 
-		struct Cocontext
-		{
-#ifdef VI_FCONTEXT
-			fcontext_t Context = nullptr;
-			char* Stack = nullptr;
-#elif VI_MICROSOFT
-			LPVOID Context = nullptr;
-			bool Main = false;
-#else
-			ucontext_t Context = nullptr;
-			char* Stack = nullptr;
-#endif
-			Cocontext()
-			{
-#ifndef VI_FCONTEXT
-#ifdef VI_MICROSOFT
-				Context = ConvertThreadToFiber(nullptr);
-				Main = true;
-#endif
-#endif
+				Target->Prev = Target->Next = nullptr;
+				Target->Linked = false;
 			}
-			Cocontext(Costate* State)
+			static uint64_t GetTick(std::chrono::microseconds Clock)
 			{
-#ifdef VI_FCONTEXT
-				Stack = Memory::Allocate<char>(sizeof(char) * State->Size);
-				Context = make_fcontext(Stack + State->Size, State->Size, [](transfer_t Transfer)
-				{
-					Costate::ExecutionEntry(&Transfer);
-				});
-#elif VI_MICROSOFT
-				Context = CreateFiber(State->Size, &Costate::ExecutionEntry, (LPVOID)State);
-#else
-				getcontext(&Context);
-				Stack = Memory::Allocate<char>(sizeof(char) * State->Size);
-				Context.uc_stack.ss_sp = Stack;
-				Context.uc_stack.ss_size = State->Size;
-				Context.uc_stack.ss_flags = 0;
-				Context.uc_link = &State->Master->Context;
-
-				int X, Y;
-				Pack2_64((void*)State, &X, &Y);
-				makecontext(&Context, (void(*)()) & Costate::ExecutionEntry, 2, X, Y);
-#endif
+				return ((uint64_t)Clock.count() + Resolution - 1) / Resolution;
 			}
-			~Cocontext()
+			static size_t GetLowestBit(uint64_t Mask)
 			{
-#ifdef VI_FCONTEXT
-				Memory::Deallocate(Stack);
-#elif VI_MICROSOFT
-				if (Main)
-					ConvertFiberToThread();
-				else if (Context != nullptr)
-					DeleteFiber(Context);
+#if defined(__GNUC__) || defined(__clang__)
+				return (size_t)__builtin_ctzll(Mask);
 #else
-				Memory::Deallocate(Stack);
+				size_t Bit = 0;
+				while (!(Mask & 1))
+				{
+					Mask >>= 1;
+					++Bit;
+				}
+				return Bit;
 #endif
 			}
 		};
 
-		struct ConcurrentSyncQueue
-		{
-			FastQueue Queue;
-		};
-
-		struct ConcurrentAsyncQueue : ConcurrentSyncQueue
-		{
-			std::condition_variable Notify;
-			std::mutex Update;
-			std::atomic<bool> Resync = true;
-		};
-
 		BasicException::BasicException(const std::string_view& NewMessage) noexcept : Message(NewMessage)
 		{
 		}
@@ -1280,7 +2362,13 @@ namespace Vitex
 		{
 		}
 
+		bool GlobalAllocator::GetStatistics(AllocationStatistics* Output) noexcept
+		{
+			return false;
+		}
+
 		static thread_local LocalAllocator* InternalAllocator = nullptr;
+		static thread_local MemoryTag InternalTag = MemoryTag::Default;
 		void* Memory::DefaultAllocate(size_t Size) noexcept
 		{
 			VI_ASSERT(Size > 0, "cannot allocate zero bytes");
@@ -1388,6 +2476,13 @@ namespace Vitex
 		{
 			InternalAllocator = NewAllocator;
 		}
+		MemoryTag Memory::SetTag(MemoryTag Tag) noexcept
+		{
+			VI_ASSERT((size_t)Tag < (size_t)MemoryTag::Count, "memory tag should be less than %i", (int)MemoryTag::Count);
+			MemoryTag Previous = InternalTag;
+			InternalTag = Tag;
+			return Previous;
+		}
 		bool Memory::IsValidAddress(void* Address) noexcept
 		{
 			VI_ASSERT(Global != nullptr, "allocator should be set");
@@ -1397,6 +2492,11 @@ namespace Vitex
 
 			return Global->IsValid(Address);
 		}
+		bool Memory::GetStatistics(AllocationStatistics* Output) noexcept
+		{
+			VI_ASSERT(Output != nullptr, "output should be set");
+			return Global != nullptr && Global->GetStatistics(Output);
+		}
 		GlobalAllocator* Memory::GetGlobalAllocator() noexcept
 		{
 			return Global;
@@ -1405,9 +2505,21 @@ namespace Vitex
 		{
 			return InternalAllocator;
 		}
+		MemoryTag Memory::GetTag() noexcept
+		{
+			return InternalTag;
+		}
 		GlobalAllocator* Memory::Global = nullptr;
 		Memory::State* Memory::Context = nullptr;
 
+		MemoryScope::MemoryScope(MemoryTag Tag) noexcept : Previous(Memory::SetTag(Tag))
+		{
+		}
+		MemoryScope::~MemoryScope() noexcept
+		{
+			Memory::SetTag(Previous);
+		}
+
 		StackTrace::StackTrace(size_t Skips, size_t MaxDepth)
 		{
 			Scripting::ImmediateContext* Context = Scripting::ImmediateContext::Get();
@@ -10882,7 +11994,7 @@ namespace Vitex
 		Schedule::Desc::Desc() : Desc(std::max<uint32_t>(2, OS::CPU::GetQuantityInfo().Logical) - 1)
 		{
 		}
-		Schedule::Desc::Desc(size_t Size) : PreallocatedSize(0), StackSize(STACK_SIZE), MaxCoroutines(96), MaxRecycles(64), IdleTimeout(std::chrono::milliseconds(2000)), ClockTimeout(std::chrono::milliseconds((uint64_t)Timings::Intensive)), Parallel(true)
+		Schedule::Desc::Desc(size_t Size) : PreallocatedSize(0), StackSize(STACK_SIZE), MaxCoroutines(96), MaxRecycles(64), IdleTimeout(std::chrono::milliseconds(2000)), ClockTimeout(std::chrono::milliseconds((uint64_t)Timings::Intensive)), WorkStealing(false), Parallel(true)
 		{
 			if (!Size)
 				Size = 1;
@@ -10934,10 +12046,7 @@ namespace Vitex
 			auto Expires = GetClock() + Duration;
 			auto Id = GetTaskId();
 
-			UMutex<std::mutex> Unique(Timeouts->Update);
-			Timeouts->Queue.emplace(std::make_pair(GetTimeout(Expires), Timeout(std::move(Callback), Duration, Id, true)));
-			Timeouts->Resync = true;
-			Timeouts->Notify.notify_all();
+			Timeouts->Push(Timeout(std::move(Callback), Duration, Id, true), Expires);
 			return Id;
 		}
 		TaskId Schedule::SetTimeout(uint64_t Milliseconds, TaskCallback&& Callback)
@@ -10953,10 +12062,7 @@ namespace Vitex
 			auto Expires = GetClock() + Duration;
 			auto Id = GetTaskId();
 
-			UMutex<std::mutex> Unique(Timeouts->Update);
-			Timeouts->Queue.emplace(std::make_pair(GetTimeout(Expires), Timeout(std::move(Callback), Duration, Id, false)));
-			Timeouts->Resync = true;
-			Timeouts->Notify.notify_all();
+			Timeouts->Push(Timeout(std::move(Callback), Duration, Id, false), Expires);
 			return Id;
 		}
 		bool Schedule::SetTask(TaskCallback&& Callback, bool Recyclable)
@@ -10968,7 +12074,13 @@ namespace Vitex
 			ReportThread(ThreadTask::EnqueueTask, 1, GetThread());
 #endif
 			VI_MEASURE(Timings::Atomic);
-			if (!Recyclable || !FastBypassEnqueue(Difficulty::Sync, std::move(Callback)))
+			if (Policy.WorkStealing)
+			{
+				if (!Recyclable || !LocalEnqueue(Difficulty::Sync, std::move(Callback)))
+					Sync->Queue.enqueue(std::move(Callback));
+				WakeupThread(Difficulty::Sync);
+			}
+			else if (!Recyclable || !FastBypassEnqueue(Difficulty::Sync, std::move(Callback)))
 				Sync->Queue.enqueue(std::move(Callback));
 			return true;
 		}
@@ -10981,7 +12093,14 @@ namespace Vitex
 			ReportThread(ThreadTask::EnqueueCoroutine, 1, GetThread());
 #endif
 			VI_MEASURE(Timings::Atomic);
-			if (Recyclable && FastBypassEnqueue(Difficulty::Async, std::move(Callback)))
+			if (Policy.WorkStealing)
+			{
+				if (!Recyclable || !LocalEnqueue(Difficulty::Async, std::move(Callback)))
+					Async->Queue.enqueue(std::move(Callback));
+				WakeupThread(Difficulty::Async);
+				return true;
+			}
+			else if (Recyclable && FastBypassEnqueue(Difficulty::Async, std::move(Callback)))
 				return true;
 
 			Async->Queue.enqueue(std::move(Callback));
@@ -11007,29 +12126,22 @@ namespace Vitex
 				return false;
 
 			UMutex<std::mutex> Unique(Timeouts->Update);
-			for (auto It = Timeouts->Queue.begin(); It != Timeouts->Queue.end(); ++It)
-			{
-				if (It->second.Id == Target)
-				{
-					Timeouts->Resync = true;
-					Timeouts->Queue.erase(It);
-					Timeouts->Notify.notify_all();
-					return true;
-				}
-			}
-			return false;
+			return Timeouts->Cancel(Target);
 		}
 		bool Schedule::TriggerTimers()
 		{
 			VI_MEASURE(Timings::Pass);
-			UMutex<std::mutex> Unique(Timeouts->Update);
-			for (auto& Item : Timeouts->Queue)
-				SetTask(std::move(Item.second.Callback));
+			Vector<TaskCallback> Tasks;
+			{
+				UMutex<std::mutex> Unique(Timeouts->Update);
+				Timeouts->Clear(&Tasks);
+				Timeouts->Resync = true;
+			}
 
-			size_t Size = Timeouts->Queue.size();
-			Timeouts->Resync = true;
-			Timeouts->Queue.clear();
-			return Size > 0;
+			for (auto& Task : Tasks)
+				SetTask(std::move(Task));
+
+			return !Tasks.empty();
 		}
 		bool Schedule::Trigger(Difficulty Type)
 		{
@@ -11038,37 +12150,22 @@ namespace Vitex
 			{
 				case Difficulty::Timeout:
 				{
-					if (Timeouts->Queue.empty())
+					if (!Timeouts->Size)
 						return false;
 					else if (Suspended)
 						return true;
 
-					auto Clock = GetClock();
-					auto It = Timeouts->Queue.begin();
-					if (It->first >= Clock)
-						return true;
-#ifndef NDEBUG
-					ReportThread(ThreadTask::ProcessTimer, 1, nullptr);
-#endif
-					if (It->second.Alive && Active)
-					{
-						Timeout Next(std::move(It->second));
-						Timeouts->Queue.erase(It);
-
-						SetTask([this, Next = std::move(Next)]() mutable
-						{
-							Next.Callback();
-							UMutex<std::mutex> Unique(Timeouts->Update);
-							Timeouts->Queue.emplace(std::make_pair(GetTimeout(GetClock() + Next.Expires), std::move(Next)));
-							Timeouts->Resync = true;
-							Timeouts->Notify.notify_all();
-						});
-					}
-					else
+					Vector<TaskCallback> Tasks;
 					{
-						SetTask(std::move(It->second.Callback));
-						Timeouts->Queue.erase(It);
+						UMutex<std::mutex> Unique(Timeouts->Update);
+						if (!Timeouts->Expire(GetClock(), Active, Tasks))
+							return true;
 					}
+#ifndef NDEBUG
+					ReportThread(ThreadTask::ProcessTimer, Tasks.size(), nullptr);
+#endif
+					for (auto& Task : Tasks)
+						SetTask(std::move(Task));
 #ifndef NDEBUG
 					ReportThread(ThreadTask::Awake, 0, nullptr);
 #endif
@@ -11144,19 +12241,28 @@ namespace Vitex
 
 			size_t Index = 0;
 			for (size_t j = 0; j < Policy.Threads[(size_t)Difficulty::Async]; j++)
-				PushThread(Difficulty::Async, Index++, j, false);
+				Threads[(size_t)Difficulty::Async].emplace_back(Memory::New<ThreadData>(Difficulty::Async, Policy.PreallocatedSize, Index++, j, false));
 
 			for (size_t j = 0; j < Policy.Threads[(size_t)Difficulty::Sync]; j++)
-				PushThread(Difficulty::Sync, Index++, j, false);
+				Threads[(size_t)Difficulty::Sync].emplace_back(Memory::New<ThreadData>(Difficulty::Sync, Policy.PreallocatedSize, Index++, j, false));
 
-			InitializeSpawnTrigger();
 			if (Policy.Threads[(size_t)Difficulty::Timeout] > 0)
 			{
 				if (Policy.Ping)
-					PushThread(Difficulty::Timeout, 0, 0, true);
-				PushThread(Difficulty::Timeout, Index++, 0, false);
+					Threads[(size_t)Difficulty::Timeout].emplace_back(Memory::New<ThreadData>(Difficulty::Timeout, Policy.PreallocatedSize, 0, 0, true));
+				Threads[(size_t)Difficulty::Timeout].emplace_back(Memory::New<ThreadData>(Difficulty::Timeout, Policy.PreallocatedSize, Index++, 0, false));
 			}
 
+			for (auto* Thread : Threads[(size_t)Difficulty::Async])
+				PushThread(Thread);
+
+			for (auto* Thread : Threads[(size_t)Difficulty::Sync])
+				PushThread(Thread);
+
+			InitializeSpawnTrigger();
+			for (auto* Thread : Threads[(size_t)Difficulty::Timeout])
+				PushThread(Thread);
+
 			return true;
 		}
 		bool Schedule::Stop()
@@ -11181,7 +12287,10 @@ namespace Vitex
 				}
 			}
 
-			Timeouts->Queue.clear();
+			{
+				UMutex<std::mutex> Unique(Timeouts->Update);
+				Timeouts->Clear(nullptr);
+			}
 			Terminate = false;
 			Enqueue = true;
 			ChunkCleanup();
@@ -11200,6 +12309,9 @@ namespace Vitex
 						Async->Queue.enqueue_bulk(Dummy, DummySize);
 					else if (Thread->Type == Difficulty::Sync || Thread->Type == Difficulty::Timeout)
 						Sync->Queue.enqueue_bulk(Dummy, DummySize);
+
+					UMutex<std::mutex> Unique(Thread->Update);
+					Thread->Awaken = true;
 					Thread->Notify.notify_all();
 				}
 
@@ -11239,6 +12351,7 @@ namespace Vitex
 				case Difficulty::Timeout:
 				{
 					TaskCallback Event;
+					Vector<TaskCallback> Tasks;
 					ReceiveToken Token(Sync->Queue);
 					if (Thread->Daemon)
 						VI_DEBUG("[schedule] acquire thread %s (timers)", ThreadId.c_str());
@@ -11255,51 +12368,33 @@ namespace Vitex
 #ifndef NDEBUG
 						ReportThread(ThreadTask::Awake, 0, Thread);
 #endif
-						std::chrono::microseconds When = std::chrono::microseconds(0);
-						if (!Timeouts->Queue.empty())
+						auto Clock = GetClock();
+						if (Timeouts->Expire(Clock, true, Tasks) > 0)
 						{
-							auto Clock = GetClock();
-							auto It = Timeouts->Queue.begin();
-							if (It->first <= Clock)
-							{
+							Unique.unlock();
 #ifndef NDEBUG
-								ReportThread(ThreadTask::ProcessTimer, 1, Thread);
+							ReportThread(ThreadTask::ProcessTimer, Tasks.size(), Thread);
 #endif
-								if (It->second.Alive)
-								{
-									Timeout Next(std::move(It->second));
-									Timeouts->Queue.erase(It);
-
-									SetTask([this, Next = std::move(Next)]() mutable
-									{
-										Next.Callback();
-										UMutex<std::mutex> Unique(Timeouts->Update);
-										Timeouts->Queue.emplace(std::make_pair(GetTimeout(GetClock() + Next.Expires), std::move(Next)));
-										Timeouts->Resync = true;
-										Timeouts->Notify.notify_all();
-									});
-								}
-								else
-								{
-									SetTask(std::move(It->second.Callback));
-									Timeouts->Queue.erase(It);
-								}
+							for (auto& Task : Tasks)
+								SetTask(std::move(Task));
 
-								goto Retry;
-							}
-							else
-							{
-								When = It->first - Clock;
-								if (When > Policy.IdleTimeout)
-									When = Policy.IdleTimeout;
-							}
+							Tasks.clear();
+							Unique.lock();
+							goto Retry;
+						}
+
+						auto When = Timeouts->GetWakeup(Clock, Policy.IdleTimeout);
+						Timeouts->NextWake = (uint64_t)(Clock + When).count();
+						if (Timeouts->Pending)
+						{
+							Timeouts->NextWake = 0;
+							goto Retry;
 						}
-						else
-							When = Policy.IdleTimeout;
 #ifndef NDEBUG
 						ReportThread(ThreadTask::Sleep, 0, Thread);
 #endif
 						Timeouts->Notify.wait_for(Unique, When, [this, Thread]() { return !ThreadActive(Thread) || Timeouts->Resync || Sync->Queue.size_approx() > 0; });
+						Timeouts->NextWake = 0;
 						Timeouts->Resync = false;
 						Unique.unlock();
 	
@@ -11342,7 +12437,7 @@ namespace Vitex
 								Event = std::move(Thread->Queue.front());
 								Thread->Queue.pop();
 							}
-							else if (!Async->Queue.try_dequeue(Token, Event))
+							else if (!LocalDequeue(Thread, Event) && !Async->Queue.try_dequeue(Token, Event) && !StealDequeue(Type, Thread, Event))
 								break;
 
 							--Cache;
@@ -11362,10 +12457,28 @@ namespace Vitex
 						ReportThread(ThreadTask::Sleep, 0, Thread);
 #endif
 						std::unique_lock<std::mutex> Unique(Thread->Update);
-						Thread->Notify.wait_for(Unique, Policy.IdleTimeout, [this, &State, Thread]()
+						if (Policy.WorkStealing)
+						{
+							Thread->Idle = State->GetCount() + 1 < Policy.MaxCoroutines;
+							if (Thread->Idle && HasTasks(Type))
+								Thread->Idle = false;
+							else
+							{
+								Thread->Notify.wait_for(Unique, Policy.IdleTimeout, [this, &State, Thread]()
+								{
+									return !ThreadActive(Thread) || State->HasResumableCoroutines() || Thread->Awaken || Async->Resync.load();
+								});
+							}
+							Thread->Awaken = false;
+							Thread->Idle = false;
+						}
+						else
 						{
-							return !ThreadActive(Thread) || State->HasResumableCoroutines() || Async->Resync.load() || (Async->Queue.size_approx() > 0 && State->GetCount() + 1 < Policy.MaxCoroutines);
-						});
+							Thread->Notify.wait_for(Unique, Policy.IdleTimeout, [this, &State, Thread]()
+							{
+								return !ThreadActive(Thread) || State->HasResumableCoroutines() || Async->Resync.load() || (Async->Queue.size_approx() > 0 && State->GetCount() + 1 < Policy.MaxCoroutines);
+							});
+						}
 						Async->Resync = false;
 					} while (ThreadActive(Thread));
 					while (!Thread->Queue.empty())
@@ -11373,6 +12486,8 @@ namespace Vitex
 						Async->Queue.enqueue(std::move(Thread->Queue.front()));
 						Thread->Queue.pop();
 					}
+					while (LocalDequeue(Thread, Event))
+						Async->Queue.enqueue(std::move(Event));
 					break;
 				}
 				case Difficulty::Sync:
@@ -11396,6 +12511,14 @@ namespace Vitex
 							Event = std::move(Thread->Queue.front());
 							Thread->Queue.pop();
 						}
+						else if (Policy.WorkStealing)
+						{
+							if (!LocalDequeue(Thread, Event) && !Sync->Queue.try_dequeue(Token, Event) && !StealDequeue(Type, Thread, Event))
+							{
+								IdleThread(Type, Thread);
+								continue;
+							}
+						}
 						else if (!Sync->Queue.wait_dequeue_timed(Token, Event, Policy.IdleTimeout))
 							continue;
 #ifndef NDEBUG
@@ -11410,6 +12533,8 @@ namespace Vitex
 						Sync->Queue.enqueue(std::move(Thread->Queue.front()));
 						Thread->Queue.pop();
 					}
+					while (LocalDequeue(Thread, Event))
+						Sync->Queue.enqueue(std::move(Event));
 					break;
 				}
 				default:
@@ -11462,12 +12587,11 @@ namespace Vitex
 
 			return true;
 		}
-		bool Schedule::PushThread(Difficulty Type, size_t GlobalIndex, size_t LocalIndex, bool IsDaemon)
+		bool Schedule::PushThread(ThreadData* Thread)
 		{
-			ThreadData* Thread = Memory::New<ThreadData>(Type, Policy.PreallocatedSize, GlobalIndex, LocalIndex, IsDaemon);
 			if (!Thread->Daemon)
 			{
-				Thread->Handle = std::thread(&Schedule::TriggerThread, this, Type, Thread);
+				Thread->Handle = std::thread(&Schedule::TriggerThread, this, Thread->Type, Thread);
 				Thread->Id = Thread->Handle.get_id();
 			}
 			else
@@ -11475,8 +12599,7 @@ namespace Vitex
 #ifndef NDEBUG
 			ReportThread(ThreadTask::Spawn, 0, Thread);
 #endif
-			Threads[(size_t)Type].emplace_back(Thread);
-			return Thread->Daemon ? TriggerThread(Type, Thread) : Thread->Handle.joinable();
+			return Thread->Daemon ? TriggerThread(Thread->Type, Thread) : Thread->Handle.joinable();
 		}
 		bool Schedule::PopThread(ThreadData* Thread)
 		{
@@ -11507,14 +12630,25 @@ namespace Vitex
 			switch (Type)
 			{
 				case Difficulty::Async:
-					return Async->Queue.size_approx() > 0;
+					if (Async->Queue.size_approx() > 0)
+						return true;
+					break;
 				case Difficulty::Sync:
-					return Sync->Queue.size_approx() > 0;
+					if (Sync->Queue.size_approx() > 0)
+						return true;
+					break;
 				case Difficulty::Timeout:
-					return Timeouts->Queue.size() > 0;
+					return Timeouts->Size > 0;
 				default:
 					return false;
 			}
+
+			for (auto* Thread : Threads[(size_t)Type])
+			{
+				if (Thread->Backlog > 0)
+					return true;
+			}
+			return false;
 		}
 		bool Schedule::HasAnyTasks() const
 		{
@@ -11553,6 +12687,85 @@ namespace Vitex
 			Thread->Queue.push(std::move(Callback));
 			return true;
 		}
+		bool Schedule::LocalEnqueue(Difficulty Type, TaskCallback&& Callback)
+		{
+			auto* Thread = (ThreadData*)InitializeThread(nullptr, false);
+			if (!Thread || Thread->Type != Type || !HasParallelThreads(Type))
+				return false;
+
+			UMutex<std::mutex> Unique(Thread->Exchange);
+			Thread->Local.emplace_back(std::move(Callback));
+			++Thread->Backlog;
+			return true;
+		}
+		bool Schedule::LocalDequeue(ThreadData* Thread, TaskCallback& Callback)
+		{
+			if (!Thread->Backlog)
+				return false;
+
+			UMutex<std::mutex> Unique(Thread->Exchange);
+			if (Thread->Local.empty())
+				return false;
+
+			Callback = std::move(Thread->Local.back());
+			Thread->Local.pop_back();
+			--Thread->Backlog;
+			return true;
+		}
+		bool Schedule::StealDequeue(Difficulty Type, ThreadData* Thread, TaskCallback& Callback)
+		{
+			auto& Victims = Threads[(size_t)Type];
+			size_t Count = Victims.size();
+			for (size_t i = 1; i < Count; i++)
+			{
+				auto* Victim = Victims[(Thread->LocalIndex + i) % Count];
+				if (!Victim->Backlog)
+					continue;
+
+				std::unique_lock<std::mutex> Unique(Victim->Exchange, std::try_to_lock);
+				if (!Unique.owns_lock() || Victim->Local.empty())
+					continue;
+
+				Callback = std::move(Victim->Local.front());
+				Victim->Local.pop_front();
+				--Victim->Backlog;
+				return true;
+			}
+			return false;
+		}
+		bool Schedule::WakeupThread(Difficulty Type)
+		{
+			for (auto* Thread : Threads[(size_t)Type])
+			{
+				bool Idle = true;
+				if (!Thread->Idle.compare_exchange_strong(Idle, false))
+					continue;
+
+				UMutex<std::mutex> Unique(Thread->Update);
+				Thread->Awaken = true;
+				Thread->Notify.notify_one();
+				return true;
+			}
+			return false;
+		}
+		bool Schedule::IdleThread(Difficulty Type, ThreadData* Thread)
+		{
+			std::unique_lock<std::mutex> Unique(Thread->Update);
+			Thread->Idle = true;
+			if (HasTasks(Type))
+			{
+				Thread->Idle = false;
+				return false;
+			}
+
+			Thread->Notify.wait_for(Unique, Policy.IdleTimeout, [this, Thread]()
+			{
+				return !ThreadActive(Thread) || Thread->Awaken;
+			});
+			Thread->Awaken = false;
+			Thread->Idle = false;
+			return true;
+		}
 		size_t Schedule::GetThreadGlobalIndex()
 		{
 			auto* Thread = GetThread();
@@ -11613,12 +12826,6 @@ namespace Vitex
 		{
 			return Policy;
 		}
-		std::chrono::microseconds Schedule::GetTimeout(std::chrono::microseconds Clock)
-		{
-			while (Timeouts->Queue.find(Clock) != Timeouts->Queue.end())
-				++Clock;
-			return Clock;
-		}
 		std::chrono::microseconds Schedule::GetClock()
 		{
 			return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch());
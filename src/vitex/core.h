@@ -34,6 +34,8 @@ namespace Vitex
 
 		struct ConcurrentSyncQueue;
 
+		struct ConcurrentTimeoutQueue;
+
 		struct Decimal;
 
 		struct Cocontext;
@@ -81,6 +83,16 @@ namespace Vitex
 			Ready = 2
 		};
 
+		enum class MemoryTag : uint8_t
+		{
+			Default = 0,
+			Network = 1,
+			Database = 2,
+			Scripting = 3,
+			Custom = 4,
+			Count = 16
+		};
+
 		enum class StdColor
 		{
 			Black = 0,
@@ -340,6 +352,26 @@ namespace Vitex
 			MemoryLocation(const char* NewSource, const char* NewFunction, const char* NewTypeName, int NewLine);
 		};
 
+		struct VI_OUT AllocationStatistics
+		{
+			struct SizeClass
+			{
+				size_t Size = 0;
+				size_t Capacity = 0;
+				size_t Used = 0;
+			};
+
+			std::vector<SizeClass> Classes;
+			uint64_t Tags[(size_t)MemoryTag::Count] = { };
+			uint64_t Allocations = 0;
+			uint64_t Deallocations = 0;
+			uint64_t BytesAllocated = 0;
+			uint64_t BytesInUse = 0;
+			uint64_t BytesPeak = 0;
+			uint64_t BytesReserved = 0;
+			bool Tagged = false;
+		};
+
 		class VI_OUT_TS GlobalAllocator
 		{
 		public:
@@ -354,6 +386,7 @@ namespace Vitex
 			virtual void Finalize() noexcept = 0;
 			virtual bool IsValid(void* Address) noexcept = 0;
 			virtual bool IsFinalizable() noexcept = 0;
+			virtual bool GetStatistics(AllocationStatistics* Output) noexcept;
 		};
 
 		class VI_OUT LocalAllocator
@@ -388,9 +421,12 @@ namespace Vitex
 			static void Cleanup() noexcept;
 			static void SetGlobalAllocator(GlobalAllocator* NewAllocator) noexcept;
 			static void SetLocalAllocator(LocalAllocator* NewAllocator) noexcept;
+			static MemoryTag SetTag(MemoryTag Tag) noexcept;
 			static bool IsValidAddress(void* Address) noexcept;
+			static bool GetStatistics(AllocationStatistics* Output) noexcept;
 			static GlobalAllocator* GetGlobalAllocator() noexcept;
 			static LocalAllocator* GetLocalAllocator() noexcept;
+			static MemoryTag GetTag() noexcept;
 
 		public:
 			template <typename T>
@@ -517,6 +553,20 @@ namespace Vitex
 #endif
 		};
 
+		class VI_OUT MemoryScope
+		{
+		private:
+			MemoryTag Previous;
+
+		public:
+			MemoryScope(MemoryTag Tag) noexcept;
+			MemoryScope(const MemoryScope&) = delete;
+			MemoryScope(MemoryScope&&) = delete;
+			~MemoryScope() noexcept;
+			MemoryScope& operator= (const MemoryScope&) = delete;
+			MemoryScope& operator= (MemoryScope&&) = delete;
+		};
+
 		template <typename T>
 		class StandardAllocator
 		{
@@ -751,6 +801,7 @@ namespace Vitex
 					MemoryLocation Location;
 					time_t Time;
 					size_t Size;
+					MemoryTag Tag;
 					bool Active;
 					bool Static;
 
@@ -758,13 +809,56 @@ namespace Vitex
 					TracingInfo(const char* NewTypeName, MemoryLocation&& NewLocation, time_t NewTime, size_t NewSize, bool IsActive, bool IsStatic);
 				};
 
+				struct VI_OUT_TS SamplingInfo
+				{
+					MemoryLocation Location;
+					uint64_t Hash = 0;
+					size_t LiveBytes = 0;
+					size_t LiveCount = 0;
+					size_t TotalBytes = 0;
+					size_t TotalCount = 0;
+				};
+
+			private:
+				struct SamplingSite
+				{
+					std::atomic<uint64_t> Hash;
+					std::atomic<bool> Ready;
+					std::atomic<size_t> LiveBytes;
+					std::atomic<size_t> LiveCount;
+					std::atomic<size_t> TotalBytes;
+					std::atomic<size_t> TotalCount;
+					MemoryLocation Location;
+					MemoryTag Tag;
+				};
+
+				struct alignas(16) SamplingBlock
+				{
+					SamplingSite* Site;
+					size_t Weight;
+					void* Self;
+				};
+
+				struct SamplingState
+				{
+					uint64_t Seed = 0;
+					int64_t Countdown = 0;
+					bool Active = false;
+				};
+
 			private:
 				std::unordered_map<void*, TracingInfo> Blocks;
 				std::unordered_map<void*, TracingInfo> Watchers;
 				std::recursive_mutex Mutex;
+				std::atomic<size_t> SitesDropped;
+				AllocationStatistics Statistics;
+				SamplingSite* Sites;
+				size_t SitesCapacity;
+				size_t SamplingRate;
 
 			public:
-				~DebugAllocator() override = default;
+				DebugAllocator(size_t SamplingRateBytes = 0, size_t MaxSamplingSites = 4096);
+				~DebugAllocator() noexcept override;
 				Unique<void> Allocate(size_t Size) noexcept override;
 				Unique<void> Allocate(MemoryLocation&& Origin, size_t Size) noexcept override;
 				void Free(Unique<void> Address) noexcept override;
@@ -775,10 +869,22 @@ namespace Vitex
 				void Finalize() noexcept override;
 				bool IsValid(void* Address) noexcept override;
 				bool IsFinalizable() noexcept override;
+				bool GetStatistics(AllocationStatistics* Output) noexcept override;
 				bool Dump(void* Address);
+				bool DumpProfile();
 				bool FindBlock(void* Address, TracingInfo* Output);
+				bool IsSampling() const;
+				std::vector<SamplingInfo> GetProfile() const;
 				const std::unordered_map<void*, TracingInfo>& GetBlocks() const;
 				const std::unordered_map<void*, TracingInfo>& GetWatchers() const;
+
+			private:
+				Unique<void> SampleAllocate(MemoryLocation&& Origin, size_t Size) noexcept;
+				SamplingSite* Sample(MemoryLocation&& Origin, size_t Weight) noexcept;
+				int64_t GetSampleCountdown(SamplingState& State) noexcept;
+
+			private:
+				static SamplingState& GetSamplingState() noexcept;
 			};
 
 			class VI_OUT_TS DefaultAllocator final : public GlobalAllocator
@@ -816,8 +922,9 @@ namespace Vitex
 					PageGroup& Page;
 					int64_t Timing;
 					size_t Capacity;
+					size_t Size;
 
-					inline PageCache(PageGroup& NewPage, int64_t Time, size_t Size) : Page(NewPage), Timing(Time), Capacity(Size)
+					inline PageCache(PageGroup& NewPage, int64_t Time, size_t NewCapacity, size_t NewSize) : Page(NewPage), Timing(Time), Capacity(NewCapacity), Size(NewSize)
 					{
 						Addresses.resize(Capacity);
 					}
@@ -827,6 +934,7 @@ namespace Vitex
 			private:
 				std::unordered_map<size_t, PageGroup> Pages;
 				std::recursive_mutex Mutex;
+				AllocationStatistics Statistics;
 				uint64_t MinimalLifeTime;
 				double ElementsReducingFactor;
 				size_t ElementsReducingBase;
@@ -845,6 +953,7 @@ namespace Vitex
 				void Finalize() noexcept override;
 				bool IsValid(void* Address) noexcept override;
 				bool IsFinalizable() noexcept override;
+				bool GetStatistics(AllocationStatistics* Output) noexcept override;
 
 			private:
 				PageCache* GetPageCache(size_t Size);
@@ -852,6 +961,112 @@ namespace Vitex
 				size_t GetElementsCount(PageGroup& Page, size_t Size);
 			};
 
+			class VI_OUT_TS ThreadAllocator final : public GlobalAllocator
+			{
+			public:
+				static constexpr size_t MaxClasses = 40;
+				static constexpr size_t MaxClassSize = 32768;
+
+			private:
+				struct ThreadCache;
+
+				struct Span
+				{
+					std::atomic<void*> Remote;
+					ThreadCache* Owner;
+					Span* Next;
+					Span* Prev;
+					void* Local;
+					size_t Index;
+					size_t Capacity;
+					size_t Used;
+					int64_t Timing;
+				};
+
+				struct alignas(16) Block
+				{
+					Span* Source;
+					uint64_t Size : 56;
+					uint64_t Tag : 8;
+					uint64_t Padding;
+					void* Self;
+				};
+
+				struct Counters
+				{
+					std::atomic<uint64_t> Tags[(size_t)MemoryTag::Count] = { };
+					std::atomic<uint64_t> Allocations = 0;
+					std::atomic<uint64_t> Deallocations = 0;
+					std::atomic<uint64_t> BytesAllocated = 0;
+					std::atomic<uint64_t> BytesDeallocated = 0;
+				};
+
+				struct Bin
+				{
+					Span* Head = nullptr;
+					Span* Current = nullptr;
+					size_t Count = 0;
+				};
+
+				struct ThreadCache
+				{
+					Bin Bins[MaxClasses];
+					Counters Stats;
+					std::atomic<bool> Orphaned = false;
+					ThreadCache* Next = nullptr;
+					int64_t Timing = 0;
+				};
+
+				struct ThreadLocal
+				{
+					ThreadCache* Cache = nullptr;
+					uint64_t Id = 0;
+					bool Exiting = false;
+					~ThreadLocal() noexcept;
+				};
+
+			private:
+				std::atomic<uint64_t> BytesReserved;
+				std::atomic<uint64_t> BytesPeak;
+				Counters Detached;
+				ThreadCache* Caches;
+				std::mutex Mutex;
+				uint64_t MinimalLifeTime;
+				uint64_t Id;
+				size_t SpanSize;
+
+			public:
+				ThreadAllocator(uint64_t MinimalLifeTimeMs = 2000, size_t SpanSizeBytes = 65536);
+				~ThreadAllocator() noexcept override;
+				Unique<void> Allocate(size_t Size) noexcept override;
+				Unique<void> Allocate(MemoryLocation&& Origin, size_t Size) noexcept override;
+				void Free(Unique<void> Address) noexcept override;
+				void Transfer(Unique<void> Address, size_t Size) noexcept override;
+				void Transfer(Unique<void> Address, MemoryLocation&& Origin, size_t Size) noexcept override;
+				void Watch(MemoryLocation&& Origin, void* Address) noexcept override;
+				void Unwatch(void* Address) noexcept override;
+				void Finalize() noexcept override;
+				bool IsValid(void* Address) noexcept override;
+				bool IsFinalizable() noexcept override;
+				bool GetStatistics(AllocationStatistics* Output) noexcept override;
+
+			private:
+				ThreadCache* GetThreadCache() noexcept;
+				Span* GetSpan(ThreadCache* Cache, size_t Index) noexcept;
+				void Release(ThreadCache* Cache, int64_t Time) noexcept;
+				void Account(ThreadCache* Cache, size_t Size, uint8_t Tag, bool Allocation) noexcept;
+				uint64_t Summarize(AllocationStatistics* Output) noexcept;
+				size_t Drain(Span* Source) noexcept;
+				int64_t GetClock() noexcept;
+
+			private:
+				static ThreadLocal& GetThreadLocal() noexcept;
+				static std::mutex& GetRegistryMutex() noexcept;
+				static std::unordered_set<uint64_t>& GetRegistry() noexcept;
+				static size_t GetClassIndex(size_t Size) noexcept;
+				static size_t GetClassSize(size_t Index) noexcept;
+			};
+
 			class VI_OUT LinearAllocator final : public LocalAllocator
 			{
 			private:
@@ -2367,14 +2582,6 @@ namespace Vitex
 			static void ConvertToWide(const std::string_view& Input, wchar_t* Output, size_t OutputSize);
 		};
 
-		struct VI_OUT ConcurrentTimeoutQueue
-		{
-			OrderedMap<std::chrono::microseconds, Timeout> Queue;
-			std::condition_variable Notify;
-			std::mutex Update;
-			bool Resync = true;
-		};
-
 		struct VI_OUT InlineArgs
 		{
 		public:
@@ -3779,17 +3986,22 @@ namespace Vitex
 			struct VI_OUT ThreadData
 			{
 				SingleQueue<TaskCallback> Queue;
+				DoubleQueue<TaskCallback> Local;
 				std::condition_variable Notify;
+				std::mutex Exchange;
 				std::mutex Update;
 				std::thread Handle;
 				std::thread::id Id;
+				std::atomic<size_t> Backlog;
+				std::atomic<bool> Idle;
 				Allocators::LinearAllocator Allocator;
 				Difficulty Type;
 				size_t GlobalIndex;
 				size_t LocalIndex;
+				bool Awaken;
 				bool Daemon;
 
-				ThreadData(Difficulty NewType, size_t PreallocatedSize, size_t NewGlobalIndex, size_t NewLocalIndex, bool IsDaemon) : Allocator(PreallocatedSize), Type(NewType), GlobalIndex(NewGlobalIndex), LocalIndex(NewLocalIndex), Daemon(IsDaemon)
+				ThreadData(Difficulty NewType, size_t PreallocatedSize, size_t NewGlobalIndex, size_t NewLocalIndex, bool IsDaemon) : Backlog(0), Idle(false), Allocator(PreallocatedSize), Type(NewType), GlobalIndex(NewGlobalIndex), LocalIndex(NewLocalIndex), Awaken(false), Daemon(IsDaemon)
 				{
 				}
 				~ThreadData() = default;
@@ -3820,6 +4032,7 @@ namespace Vitex
 				std::chrono::milliseconds ClockTimeout;
 				SpawnerCallback Initialize;
 				ActivityCallback Ping;
+				bool WorkStealing;
 				bool Parallel;
 
 				Desc();
@@ -3884,14 +4097,18 @@ namespace Vitex
 			const ThreadData* InitializeThread(ThreadData* Source, bool Update) const;
 			void InitializeSpawnTrigger();
 			bool FastBypassEnqueue(Difficulty Type, TaskCallback&& Callback);
+			bool LocalEnqueue(Difficulty Type, TaskCallback&& Callback);
+			bool LocalDequeue(ThreadData* Thread, TaskCallback& Callback);
+			bool StealDequeue(Difficulty Type, ThreadData* Thread, TaskCallback& Callback);
+			bool WakeupThread(Difficulty Type);
+			bool IdleThread(Difficulty Type, ThreadData* Thread);
 			bool ReportThread(ThreadTask State, size_t Tasks, const ThreadData* Thread);
 			bool TriggerThread(Difficulty Type, ThreadData* Thread);
 			bool SleepThread(Difficulty Type, ThreadData* Thread);
 			bool ThreadActive(ThreadData* Thread);
 			bool ChunkCleanup();
-			bool PushThread(Difficulty Type, size_t GlobalIndex, size_t LocalIndex, bool IsDaemon);
+			bool PushThread(ThreadData* Thread);
 			bool PopThread(ThreadData* Thread);
-			std::chrono::microseconds GetTimeout(std::chrono::microseconds Clock);
 			TaskId GetTaskId();
 
 		public:
@@ -1310,9 +1310,9 @@ namespace Vitex
 			if (Control.Usage & (size_t)USE_NETWORKING)
 			{
 				if (Network::Multiplexer::HasInstance())
-					Network::Multiplexer::Get()->Rescale(Control.PollingTimeout, Control.PollingEvents);
+					Network::Multiplexer::Get()->Rescale(Control.PollingTimeout, Control.PollingEvents, Control.PollingShards);
 				else
-					new Network::Multiplexer(Control.PollingTimeout, Control.PollingEvents);
+					new Network::Multiplexer(Control.PollingTimeout, Control.PollingEvents, Control.PollingShards);
 			}
 
 			if (Control.Usage & (size_t)USE_SCRIPTING)
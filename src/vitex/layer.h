@@ -360,6 +360,7 @@ namespace Vitex
 				Core::String Directory;
 				size_t PollingTimeout = 100;
 				size_t PollingEvents = 256;
+				size_t PollingShards = 1;
 				size_t Threads = 0;
 				size_t Usage =
 					(size_t)USE_PROCESSING |
@@ -231,6 +231,7 @@ namespace Vitex
 					Series::UnpackA(Network->Find("socket-timeout"), &Router->SocketTimeout);
 					Series::Unpack(Network->Find("graceful-time-wait"), &Router->GracefulTimeWait);
 					Series::UnpackA(Network->Find("max-connections"), &Router->MaxConnections);
+					Series::UnpackA(Network->Find("max-listeners"), &Router->MaxListeners);
 					Series::Unpack(Network->Find("enable-no-delay"), &Router->EnableNoDelay);
 					Series::UnpackA(Network->Find("max-uploadable-resources"), &Router->MaxUploadableResources);
 					Series::Unpack(Network->Find("temporary-directory"), &Router->TemporaryDirectory);
@@ -243,6 +244,13 @@ namespace Vitex
 					Series::Unpack(Network->Fetch("session.cookie.http-only"), &Router->Session.Cookie.HttpOnly);
 					Series::Unpack(Network->Fetch("session.directory"), &Router->Session.Directory);
 					Series::Unpack(Network->Fetch("session.expires"), &Router->Session.Expires);
+					Series::Unpack(Network->Fetch("session.max-entries"), &Router->Session.MaxEntries);
+					Series::Unpack(Network->Fetch("session.write-behind"), &Router->Session.WriteBehind);
+					Series::Unpack(Network->Fetch("http2.enabled"), &Router->Http2.Enabled);
+					Series::UnpackA(Network->Fetch("http2.max-concurrent-streams"), &Router->Http2.MaxConcurrentStreams);
+					Series::UnpackA(Network->Fetch("http2.initial-window-size"), &Router->Http2.InitialWindowSize);
+					Series::UnpackA(Network->Fetch("http2.max-frame-size"), &Router->Http2.MaxFrameSize);
+					Series::UnpackA(Network->Fetch("http2.header-table-size"), &Router->Http2.HeaderTableSize);
 					Core::Stringify::EvalEnvs(Router->Session.Directory, BaseDirectory, NetAddresses);
 					Core::Stringify::EvalEnvs(Router->TemporaryDirectory, BaseDirectory, NetAddresses);
 
@@ -327,7 +335,23 @@ namespace Vitex
 							Series::UnpackA(Base->Find("static-file-max-age"), &Route->StaticFileMaxAge);
 							Series::Unpack(Base->Find("allow-directory-listing"), &Route->AllowDirectoryListing);
 							Series::Unpack(Base->Find("allow-web-socket"), &Route->AllowWebSocket);
+							Series::Unpack(Base->Find("allow-web-socket-compression"), &Route->AllowWebSocketCompression);
+							Series::UnpackA(Base->Fetch("web-socket-compression.max-message-size"), &Route->WebSocketCompression.MaxMessageSize);
+							Series::Unpack(Base->Fetch("web-socket-compression.server-context-takeover"), &Route->WebSocketCompression.LocalContextTakeover);
+							Series::Unpack(Base->Fetch("web-socket-compression.client-context-takeover"), &Route->WebSocketCompression.RemoteContextTakeover);
+							if (Series::Unpack(Base->Fetch("web-socket-compression.server-window-bits"), &Route->WebSocketCompression.LocalWindowBits))
+								Route->WebSocketCompression.LocalWindowBits = Compute::Math32::Clamp(Route->WebSocketCompression.LocalWindowBits, 9, 15);
+
+							if (Series::Unpack(Base->Fetch("web-socket-compression.client-window-bits"), &Route->WebSocketCompression.RemoteWindowBits))
+								Route->WebSocketCompression.RemoteWindowBits = Compute::Math32::Clamp(Route->WebSocketCompression.RemoteWindowBits, 9, 15);
+
+							if (Series::Unpack(Base->Fetch("web-socket-compression.quality-level"), &Route->WebSocketCompression.QualityLevel))
+								Route->WebSocketCompression.QualityLevel = Compute::Math32::Clamp(Route->WebSocketCompression.QualityLevel, 0, 9);
+
+							if (Series::Unpack(Base->Fetch("web-socket-compression.memory-level"), &Route->WebSocketCompression.MemoryLevel))
+								Route->WebSocketCompression.MemoryLevel = Compute::Math32::Clamp(Route->WebSocketCompression.MemoryLevel, 1, 9);
 							Series::Unpack(Base->Find("allow-send-file"), &Route->AllowSendFile);
+							Series::Unpack(Base->Find("allow-file-cache"), &Route->AllowFileCache);
 							Series::Unpack(Base->Find("proxy-ip-address"), &Route->ProxyIpAddress);
 							if (Series::Unpack(Base->Find("files-directory"), &Route->FilesDirectory))
 								Core::Stringify::EvalEnvs(Route->FilesDirectory, BaseDirectory, NetAddresses);
@@ -32,6 +32,7 @@
 #include <sys/select.h>
 #include <sys/socket.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #ifdef NET_EPOLL
 #include <sys/epoll.h>
 #include <sys/sendfile.h>
@@ -53,6 +54,10 @@
 #define MAX_READ_UNTIL 512
 #define CLOSE_TIMEOUT 10
 #define SERVER_BLOCKED_WAIT_US 100
+#define MAX_WRITE_VECTOR 64
+#if defined(__linux__) && defined(SOCK_NONBLOCK) && defined(SOCK_CLOEXEC)
+#define NET_ACCEPT4
+#endif
 #pragma warning(push)
 #pragma warning(disable: 4996)
 #include <concurrentqueue.h>
@@ -86,17 +91,33 @@ namespace Vitex
 
 			return Socket;
 		}
-		static Core::ExpectsIO<socket_t> ExecuteAccept(socket_t Fd, sockaddr* Address, socket_size_t* AddressLength)
+		static Core::ExpectsIO<socket_t> ExecuteAccept(socket_t Fd, sockaddr* Address, socket_size_t* AddressLength, bool Nonblocking = false)
 		{
 			if (!Core::OS::Control::Has(Core::AccessOption::Net))
 				return std::make_error_condition(std::errc::permission_denied);
-
+#ifdef NET_ACCEPT4
+			socket_t Socket = (socket_t)accept4(Fd, Address, AddressLength, Nonblocking ? SOCK_NONBLOCK | SOCK_CLOEXEC : 0);
+#else
 			socket_t Socket = (socket_t)accept(Fd, Address, AddressLength);
+#endif
 			if (Socket == INVALID_SOCKET)
 				return Utils::GetLastError(nullptr, -1);
 
 			return Socket;
 		}
+		static Core::ExpectsIO<void> ExecuteAcceptBatch(socket_t Fd, SocketAccept* Incoming)
+		{
+			char Address[ADDRESS_SIZE];
+			socket_size_t Length = sizeof(Address);
+			auto NewFd = ExecuteAccept(Fd, (sockaddr*)&Address, &Length, true);
+			if (!NewFd)
+				return NewFd.Error();
+
+			VI_DEBUG("[net] accept fd %i on %i fd", (int)*NewFd, (int)Fd);
+			Incoming->Address = SocketAddress(std::string_view(), 0, (sockaddr*)&Address, Length);
+			Incoming->Fd = *NewFd;
+			return Core::Expectation::Met;
+		}
 		static Core::ExpectsIO<void> SetSocketBlocking(socket_t Fd, bool Enabled)
 		{
 			VI_TRACE("[net] fd %i setopt: blocking %s", (int)Fd, Enabled ? "on" : "off");
@@ -1940,23 +1961,51 @@ namespace Vitex
 			});
 		}
 
+		Multiplexer::Shard::Shard(size_t MaxEvents) noexcept : Handle(MaxEvents)
+		{
+			Fds.resize(MaxEvents);
+		}
+
 		Multiplexer::Multiplexer() noexcept : Multiplexer(100, 256)
 		{
 		}
-		Multiplexer::Multiplexer(uint64_t DispatchTimeout, size_t MaxEvents) noexcept : Handle(MaxEvents), Activations(0), DefaultTimeout(DispatchTimeout)
+		Multiplexer::Multiplexer(uint64_t DispatchTimeout, size_t MaxEvents, size_t MaxShards) noexcept : Activations(0), DefaultTimeout(DispatchTimeout)
 		{
-			VI_TRACE("[net] OK initialize multiplexer (%" PRIu64 " events)", (uint64_t)MaxEvents);
-			Fds.resize(MaxEvents);
+			VI_TRACE("[net] OK initialize multiplexer (%" PRIu64 " events, %" PRIu64 " shards)", (uint64_t)MaxEvents, (uint64_t)MaxShards);
+			Shards.reserve(std::max<size_t>(1, MaxShards));
+			for (size_t i = 0; i < std::max<size_t>(1, MaxShards); i++)
+				Shards.push_back(Core::Memory::New<Shard>(MaxEvents));
 		}
 		Multiplexer::~Multiplexer() noexcept
 		{
 			Shutdown();
+			for (auto* Target : Shards)
+				Core::Memory::Delete(Target);
+			Shards.clear();
 			VI_TRACE("[net] free multiplexer");
 		}
-		void Multiplexer::Rescale(uint64_t DispatchTimeout, size_t MaxEvents) noexcept
+		void Multiplexer::Rescale(uint64_t DispatchTimeout, size_t MaxEvents, size_t MaxShards) noexcept
 		{
 			DefaultTimeout = DispatchTimeout;
-			Handle = EpollHandle(MaxEvents);
+			if (Activations > 0)
+				MaxShards = Shards.size();
+			else
+				MaxShards = std::max<size_t>(1, MaxShards);
+
+			while (Shards.size() > MaxShards)
+			{
+				Core::Memory::Delete(Shards.back());
+				Shards.pop_back();
+			}
+
+			for (auto* Target : Shards)
+			{
+				Target->Handle = EpollHandle(MaxEvents);
+				Target->Fds.resize(MaxEvents);
+			}
+
+			while (Shards.size() < MaxShards)
+				Shards.push_back(Core::Memory::New<Shard>(MaxEvents));
 		}
 		void Multiplexer::Activate() noexcept
 		{
@@ -1969,64 +2018,81 @@ namespace Vitex
 		void Multiplexer::Shutdown() noexcept
 		{
 			VI_MEASURE(Core::Timings::FileSystem);
-			DispatchTimers(Core::Schedule::GetClock());
+			auto Time = Core::Schedule::GetClock();
+			for (auto* Target : Shards)
+			{
+				DispatchTimers(Target, Time);
 
-			Core::OrderedMap<std::chrono::microseconds, Socket*> DirtyTimers;
-			Core::UnorderedSet<Socket*> DirtyTrackers;
-			Core::UMutex<std::mutex> Unique(Exclusive);
-			VI_DEBUG("[net] shutdown multiplexer on fds (sockets = %i)", (int)(Timers.size() + Trackers.size()));
-			DirtyTimers.swap(Timers);
-			DirtyTrackers.swap(Trackers);
+				Core::OrderedMap<std::chrono::microseconds, Socket*> DirtyTimers;
+				Core::UnorderedSet<Socket*> DirtyTrackers;
+				Core::UMutex<std::mutex> Unique(Target->Exclusive);
+				VI_DEBUG("[net] shutdown multiplexer on fds (sockets = %i)", (int)(Target->Timers.size() + Target->Trackers.size()));
+				DirtyTimers.swap(Target->Timers);
+				DirtyTrackers.swap(Target->Trackers);
 
-			for (auto& Item : DirtyTrackers)
-			{
-				VI_DEBUG("[net] sock reset on fd %i", (int)Item->Fd);
-				Item->Events.Expiration = std::chrono::microseconds(0);
-				CancelEvents(Item, SocketPoll::Reset);
-			}
+				for (auto& Item : DirtyTrackers)
+				{
+					VI_DEBUG("[net] sock reset on fd %i", (int)Item->Fd);
+					Item->Events.Expiration = std::chrono::microseconds(0);
+					CancelEvents(Item, SocketPoll::Reset);
+				}
 
-			for (auto& Item : DirtyTimers)
-			{
-				VI_DEBUG("[net] sock timeout on fd %i", (int)Item.second->Fd);
-				Item.second->Events.Expiration = std::chrono::microseconds(0);
-				CancelEvents(Item.second, SocketPoll::Timeout);
+				for (auto& Item : DirtyTimers)
+				{
+					VI_DEBUG("[net] sock timeout on fd %i", (int)Item.second->Fd);
+					Item.second->Events.Expiration = std::chrono::microseconds(0);
+					CancelEvents(Item.second, SocketPoll::Timeout);
+				}
 			}
 		}
 		int Multiplexer::Dispatch(uint64_t EventTimeout) noexcept
 		{
-			int Count = Handle.Wait(Fds.data(), Fds.size(), EventTimeout);
+			int Count = 0;
+			for (size_t i = 0; i < Shards.size(); i++)
+			{
+				int Events = DispatchShard(i, i + 1 < Shards.size() ? 0 : EventTimeout);
+				if (Events > 0)
+					Count += Events;
+			}
+			return Count;
+		}
+		int Multiplexer::DispatchShard(size_t Index, uint64_t EventTimeout) noexcept
+		{
+			VI_ASSERT(Index < Shards.size(), "shard index should be less than shards count");
+			auto* Target = Shards[Index];
+			int Count = Target->Handle.Wait(Target->Fds.data(), Target->Fds.size(), EventTimeout);
 			auto Time = Core::Schedule::GetClock();
 			if (Count > 0)
 			{
 				VI_MEASURE(Core::Timings::FileSystem);
 				size_t Size = (size_t)Count;
 				for (size_t i = 0; i < Size; i++)
-					DispatchEvents(Fds[i], Time);
+					DispatchEvents(Target, Target->Fds[i], Time);
 			}
 
-			DispatchTimers(Time);
+			DispatchTimers(Target, Time);
 			return Count;
 		}
-		void Multiplexer::DispatchTimers(const std::chrono::microseconds& Time) noexcept
+		void Multiplexer::DispatchTimers(Shard* Target, const std::chrono::microseconds& Time) noexcept
 		{
 			VI_MEASURE(Core::Timings::FileSystem);
-			if (Timers.empty())
+			if (Target->Timers.empty())
 				return;
 
-			Core::UMutex<std::mutex> Unique(Exclusive);
-			while (!Timers.empty())
+			Core::UMutex<std::mutex> Unique(Target->Exclusive);
+			while (!Target->Timers.empty())
 			{
-				auto It = Timers.begin();
+				auto It = Target->Timers.begin();
 				if (It->first > Time)
 					break;
 
 				VI_DEBUG("[net] sock timeout on fd %i", (int)It->second->Fd);
 				It->second->Events.Expiration = std::chrono::microseconds(0);
 				CancelEvents(It->second, SocketPoll::Timeout);
-				Timers.erase(It);
+				Target->Timers.erase(It);
 			}
 		}
-		bool Multiplexer::DispatchEvents(const EpollFd& Fd, const std::chrono::microseconds& Time) noexcept
+		bool Multiplexer::DispatchEvents(Shard* Target, const EpollFd& Fd, const std::chrono::microseconds& Time) noexcept
 		{
 			VI_ASSERT(Fd.Base != nullptr, "no socket is connected to epoll fd");
 			VI_TRACE("[net] sock event:%s%s%s on fd %i", Fd.Closeable ? "c" : "", Fd.Readable ? "r" : "", Fd.Writeable ? "w" : "", (int)Fd.Base->Fd);
@@ -2047,13 +2113,13 @@ namespace Vitex
 			if (StillListeningRead || StillListeningWrite)
 			{
 				if (WasListeningRead != StillListeningRead || WasListeningWrite != StillListeningWrite)
-					Handle.Update(Fd.Base, StillListeningRead, StillListeningWrite);
-				UpdateTimeout(Fd.Base, Time);
+					Target->Handle.Update(Fd.Base, StillListeningRead, StillListeningWrite);
+				UpdateTimeout(Target, Fd.Base, Time);
 			}
 			else if (WasListeningRead || WasListeningWrite)
 			{
-				Handle.Remove(Fd.Base);
-				RemoveTimeout(Fd.Base);
+				Target->Handle.Remove(Fd.Base);
+				RemoveTimeout(Target, Fd.Base);
 			}
 
 			if (Fd.Readable && Fd.Writeable)
@@ -2089,15 +2155,33 @@ namespace Vitex
 		}
 		bool Multiplexer::WhenReadable(Socket* Value, PollEventCallback&& WhenReady) noexcept
 		{
-			VI_ASSERT(Value != nullptr && Value->Fd != INVALID_SOCKET, "socket should be set and valid");
+			VI_ASSERT(Value != nullptr && Value->IsValid(), "socket should be set and valid");
 			VI_ASSERT(WhenReady != nullptr, "readable callback should be set");
+			if (Value->Channel != nullptr)
+			{
+				auto* Target = GetShard(Value);
+				Core::UMutex<std::mutex> Unique(Value->Events.Mutex);
+				bool WasListening = Value->Events.ReadCallback || Value->Events.WriteCallback;
+				Value->Events.ReadCallback.swap(WhenReady);
+				if (!WasListening)
+					AddTimeout(Target, Value, Core::Schedule::GetClock());
+
+				Unique.Negate();
+				if (WhenReady)
+					Core::Cospawn([WhenReady = std::move(WhenReady)]() mutable { WhenReady(SocketPoll::Cancel); });
+				if (Value->Channel->IsReadable())
+					NotifyEvents(Value, true, false);
+				return true;
+			}
+
+			auto* Target = GetShard(Value);
 			Core::UMutex<std::mutex> Unique(Value->Events.Mutex);
 			bool WasListeningRead = !!Value->Events.ReadCallback;
 			bool StillListeningWrite = !!Value->Events.WriteCallback;
 			Value->Events.ReadCallback.swap(WhenReady);
-			bool Listening = (WhenReady ? Handle.Update(Value, true, StillListeningWrite) : Handle.Add(Value, true, StillListeningWrite));
+			bool Listening = (WhenReady ? Target->Handle.Update(Value, true, StillListeningWrite) : Target->Handle.Add(Value, true, StillListeningWrite));
 			if (!WasListeningRead && !StillListeningWrite)
-				AddTimeout(Value, Core::Schedule::GetClock());
+				AddTimeout(Target, Value, Core::Schedule::GetClock());
 
 			Unique.Negate();
 			if (WhenReady)
@@ -2107,14 +2191,32 @@ namespace Vitex
 		}
 		bool Multiplexer::WhenWriteable(Socket* Value, PollEventCallback&& WhenReady) noexcept
 		{
-			VI_ASSERT(Value != nullptr && Value->Fd != INVALID_SOCKET, "socket should be set and valid");
+			VI_ASSERT(Value != nullptr && Value->IsValid(), "socket should be set and valid");
+			if (Value->Channel != nullptr)
+			{
+				auto* Target = GetShard(Value);
+				Core::UMutex<std::mutex> Unique(Value->Events.Mutex);
+				bool WasListening = Value->Events.ReadCallback || Value->Events.WriteCallback;
+				Value->Events.WriteCallback.swap(WhenReady);
+				if (!WasListening)
+					AddTimeout(Target, Value, Core::Schedule::GetClock());
+
+				Unique.Negate();
+				if (WhenReady)
+					Core::Cospawn([WhenReady = std::move(WhenReady)]() mutable { WhenReady(SocketPoll::Cancel); });
+				if (Value->Channel->IsWriteable())
+					NotifyEvents(Value, false, true);
+				return true;
+			}
+
+			auto* Target = GetShard(Value);
 			Core::UMutex<std::mutex> Unique(Value->Events.Mutex);
 			bool StillListeningRead = !!Value->Events.ReadCallback;
 			bool WasListeningWrite = !!Value->Events.WriteCallback;
 			Value->Events.WriteCallback.swap(WhenReady);
-			bool Listening = (WhenReady ? Handle.Update(Value, StillListeningRead, true) : Handle.Add(Value, StillListeningRead, true));
+			bool Listening = (WhenReady ? Target->Handle.Update(Value, StillListeningRead, true) : Target->Handle.Add(Value, StillListeningRead, true));
 			if (!WasListeningWrite && !StillListeningRead)
-				AddTimeout(Value, Core::Schedule::GetClock());
+				AddTimeout(Target, Value, Core::Schedule::GetClock());
 
 			Unique.Negate();
 			if (WhenReady)
@@ -2125,14 +2227,15 @@ namespace Vitex
 		bool Multiplexer::CancelEvents(Socket* Value, SocketPoll Event) noexcept
 		{
 			VI_ASSERT(Value != nullptr, "socket should be set and valid");
+			auto* Target = GetShard(Value);
 			Core::UMutex<std::mutex> Unique(Value->Events.Mutex);
 			PollEventCallback ReadCallback, WriteCallback;
 			Value->Events.ReadCallback.swap(ReadCallback);
 			Value->Events.WriteCallback.swap(WriteCallback);
 			bool WasListening = ReadCallback || WriteCallback;
-			bool NotListening = WasListening && Value->IsValid() ? Handle.Remove(Value) : true;
+			bool NotListening = WasListening && Value->Fd != INVALID_SOCKET ? Target->Handle.Remove(Value) : true;
 			if (WasListening)
-				RemoveTimeout(Value);
+				RemoveTimeout(Target, Value);
 
 			Unique.Negate();
 			if (Packet::IsDone(Event) || !WasListening)
@@ -2158,74 +2261,107 @@ namespace Vitex
 		{
 			return CancelEvents(Value, SocketPoll::Finish);
 		}
+		bool Multiplexer::NotifyEvents(Socket* Value, bool Readable, bool Writeable) noexcept
+		{
+			VI_ASSERT(Value != nullptr, "socket should be set and valid");
+			auto* Target = GetShard(Value);
+			Core::UMutex<std::mutex> Unique(Value->Events.Mutex);
+			PollEventCallback ReadCallback, WriteCallback;
+			if (Readable)
+				Value->Events.ReadCallback.swap(ReadCallback);
+			if (Writeable)
+				Value->Events.WriteCallback.swap(WriteCallback);
+			if ((ReadCallback || WriteCallback) && !Value->Events.ReadCallback && !Value->Events.WriteCallback)
+				RemoveTimeout(Target, Value);
+
+			Unique.Negate();
+			if (!ReadCallback && !WriteCallback)
+				return false;
+
+			Core::Cospawn([ReadCallback = std::move(ReadCallback), WriteCallback = std::move(WriteCallback)]() mutable
+			{
+				if (WriteCallback)
+					WriteCallback(SocketPoll::Finish);
+				if (ReadCallback)
+					ReadCallback(SocketPoll::Finish);
+			});
+			return true;
+		}
 		bool Multiplexer::IsListening() noexcept
 		{
 			return Activations > 0;
 		}
-		void Multiplexer::AddTimeout(Socket* Value, const std::chrono::microseconds& Time) noexcept
+		void Multiplexer::AddTimeout(Shard* Target, Socket* Value, const std::chrono::microseconds& Time) noexcept
 		{
 			if (Value->Events.Timeout > 0)
 			{
 				VI_TRACE("[net] sock set timeout on fd %i (time = %i)", (int)Value->Fd, (int)Value->Events.Timeout);
 				auto Expiration = Time + std::chrono::milliseconds(Value->Events.Timeout);
-				Core::UMutex<std::mutex> Unique(Exclusive);
-				while (Timers.find(Expiration) != Timers.end())
+				Core::UMutex<std::mutex> Unique(Target->Exclusive);
+				while (Target->Timers.find(Expiration) != Target->Timers.end())
 					++Expiration;
 
-				Timers[Expiration] = Value;
+				Target->Timers[Expiration] = Value;
 				Value->Events.Expiration = Expiration;
 			}
 			else
 			{
-				Core::UMutex<std::mutex> Unique(Exclusive);
+				Core::UMutex<std::mutex> Unique(Target->Exclusive);
 				Value->Events.Expiration = std::chrono::microseconds(-1);
-				Trackers.insert(Value);
+				Target->Trackers.insert(Value);
 			}
 		}
-		void Multiplexer::UpdateTimeout(Socket* Value, const std::chrono::microseconds& Time) noexcept
+		void Multiplexer::UpdateTimeout(Shard* Target, Socket* Value, const std::chrono::microseconds& Time) noexcept
 		{
-			RemoveTimeout(Value);
-			AddTimeout(Value, Time);
+			RemoveTimeout(Target, Value);
+			AddTimeout(Target, Value, Time);
 		}
-		void Multiplexer::RemoveTimeout(Socket* Value) noexcept
+		void Multiplexer::RemoveTimeout(Shard* Target, Socket* Value) noexcept
 		{
 			VI_TRACE("[net] sock cancel timeout on fd %i", (int)Value->Fd);
 			if (Value->Events.Expiration > std::chrono::microseconds(0))
 			{
-				Core::UMutex<std::mutex> Unique(Exclusive);
-				auto It = Timers.find(Value->Events.Expiration);
-				VI_ASSERT(It != Timers.end(), "socket timeout update de-sync happend");
+				Core::UMutex<std::mutex> Unique(Target->Exclusive);
+				auto It = Target->Timers.find(Value->Events.Expiration);
+				VI_ASSERT(It != Target->Timers.end(), "socket timeout update de-sync happend");
 				Value->Events.Expiration = std::chrono::microseconds(0);
-				if (It != Timers.end())
-					Timers.erase(It);
+				if (It != Target->Timers.end())
+					Target->Timers.erase(It);
 			}
 			else if (Value->Events.Expiration < std::chrono::microseconds(0))
 			{
-				Core::UMutex<std::mutex> Unique(Exclusive);
+				Core::UMutex<std::mutex> Unique(Target->Exclusive);
 				Value->Events.Expiration = std::chrono::microseconds(0);
-				Trackers.erase(Value);
+				Target->Trackers.erase(Value);
 			}
 		}
-		void Multiplexer::TryDispatch() noexcept
+		void Multiplexer::TryDispatch(size_t Index) noexcept
 		{
 			auto* Queue = Core::Schedule::Get();
-			Dispatch(Queue->HasParallelThreads(Core::Difficulty::Sync) ? DefaultTimeout : 5);
-			TryEnqueue();
+			size_t Threads = Queue->GetThreads(Core::Difficulty::Sync);
+			size_t Pollers = std::max<size_t>(1, std::min<size_t>(Shards.size(), Threads > 1 ? Threads - 1 : 1));
+			if (Index >= Pollers)
+				return;
+
+			for (size_t i = Index; i < Shards.size(); i += Pollers)
+				DispatchShard(i, i + Pollers < Shards.size() ? 0 : DefaultTimeout);
+			TryEnqueue(Index);
 		}
-		void Multiplexer::TryEnqueue() noexcept
+		void Multiplexer::TryEnqueue(size_t Index) noexcept
 		{
 			if (!Activations)
 				return;
 
 			auto* Queue = Core::Schedule::Get();
-			Queue->SetTask(std::bind(&Multiplexer::TryDispatch, this));
+			Queue->SetTask([this, Index]() { TryDispatch(Index); });
 		}
 		void Multiplexer::TryListen() noexcept
 		{
 			if (!Activations++)
 			{
-				VI_DEBUG("[net] start events polling");
-				TryEnqueue();
+				VI_DEBUG("[net] start events polling (shards = %i)", (int)Shards.size());
+				for (size_t i = 0; i < Shards.size(); i++)
+					TryEnqueue(i);
 			}
 		}
 		void Multiplexer::TryUnlisten() noexcept
@@ -2238,6 +2374,20 @@ namespace Vitex
 		{
 			return Activations;
 		}
+		size_t Multiplexer::GetShards() const noexcept
+		{
+			return Shards.size();
+		}
+		Multiplexer::Shard* Multiplexer::GetShard(Socket* Value) noexcept
+		{
+			if (Shards.size() == 1)
+				return Shards.front();
+#ifdef VI_MICROSOFT
+			return Shards[((size_t)Value->Fd >> 2) % Shards.size()];
+#else
+			return Shards[(size_t)Value->Fd % Shards.size()];
+#endif
+		}
 
 		Uplinks::Uplinks() noexcept : MaxDuplicates(1)
 		{
@@ -2701,17 +2851,18 @@ namespace Vitex
 			return *this;
 		}
 
-		Socket::Socket() noexcept : Device(nullptr), Fd(INVALID_SOCKET), Income(0), Outcome(0)
+		Socket::Socket() noexcept : Channel(nullptr), Device(nullptr), Fd(INVALID_SOCKET), Income(0), Outcome(0)
 		{
 			VI_WATCH(this, "socket fd (empty)");
 		}
-		Socket::Socket(socket_t FromFd) noexcept : Device(nullptr), Fd(FromFd), Income(0), Outcome(0)
+		Socket::Socket(socket_t FromFd) noexcept : Channel(nullptr), Device(nullptr), Fd(FromFd), Income(0), Outcome(0)
 		{
 			VI_WATCH(this, "socket fd");
 		}
-		Socket::Socket(Socket&& Other) noexcept : Events(std::move(Other.Events)), Device(Other.Device), Fd(Other.Fd), Income(Other.Income), Outcome(Other.Outcome)
+		Socket::Socket(Socket&& Other) noexcept : Events(std::move(Other.Events)), Channel(Other.Channel), Device(Other.Device), Fd(Other.Fd), Income(Other.Income), Outcome(Other.Outcome)
 		{
 			VI_WATCH(this, "socket fd (moved)");
+			Other.Channel = nullptr;
 			Other.Device = nullptr;
 			Other.Fd = INVALID_SOCKET;
 		}
@@ -2727,10 +2878,12 @@ namespace Vitex
 
 			Shutdown();
 			Events = std::move(Other.Events);
+			Channel = Other.Channel;
 			Device = Other.Device;
 			Fd = Other.Fd;
 			Income = Other.Income;
 			Outcome = Other.Outcome;
+			Other.Channel = nullptr;
 			Other.Device = nullptr;
 			Other.Fd = INVALID_SOCKET;
 			return *this;
@@ -2765,7 +2918,7 @@ namespace Vitex
 					return;
 				}
 
-				while (Accept(&Incoming))
+				while (ExecuteAcceptBatch(Fd, &Incoming))
 				{
 					if (!Callback(Incoming))
 						break;
@@ -2821,7 +2974,9 @@ namespace Vitex
 			}
 #endif
 			ClearEvents(Gracefully);
-			if (Fd == INVALID_SOCKET)
+			if (TryCloseChannel())
+				return Core::Expectation::Met;
+			else if (Fd == INVALID_SOCKET)
 				return std::make_error_condition(std::errc::bad_file_descriptor);
 
 			uint8_t Buffer;
@@ -2848,7 +3003,9 @@ namespace Vitex
 			}
 #endif
 			ClearEvents(false);
-			if (Fd == INVALID_SOCKET)
+			if (TryCloseChannel())
+				return Core::Expectation::Met;
+			else if (Fd == INVALID_SOCKET)
 				return std::make_error_condition(std::errc::bad_file_descriptor);
 
 			int Error = 1;
@@ -2896,7 +3053,12 @@ namespace Vitex
 			}
 #endif
 			ClearEvents(false);
-			if (Fd == INVALID_SOCKET)
+			if (TryCloseChannel())
+			{
+				Callback(Core::Optional::None);
+				return Core::Expectation::Met;
+			}
+			else if (Fd == INVALID_SOCKET)
 			{
 				Callback(std::make_error_condition(std::errc::bad_file_descriptor));
 				return std::make_error_condition(std::errc::bad_file_descriptor);
@@ -2962,12 +3124,25 @@ namespace Vitex
 			Callback(Core::Optional::None);
 			return Core::Expectation::Met;
 		}
+		bool Socket::TryCloseChannel()
+		{
+			if (!Channel)
+				return false;
+
+			VI_DEBUG("[net] sock channel 0x%" PRIXPTR " detached", (uintptr_t)Channel);
+			Channel->Detach();
+			Core::Memory::Release(Channel);
+			return true;
+		}
 		Core::ExpectsIO<size_t> Socket::WriteFile(FILE* Stream, size_t Offset, size_t Size)
 		{
 			VI_ASSERT(Stream != nullptr, "stream should be set");
 			VI_ASSERT(Offset >= 0, "offset should be set and positive");
 			VI_ASSERT(Size > 0, "size should be set and greater than zero");
 			VI_MEASURE(Core::Timings::Networking);
+			if (Channel != nullptr)
+				return std::make_error_condition(std::errc::not_supported);
+
 			VI_TRACE("[net] fd %i sendfile %" PRId64 " off, %" PRId64 " bytes", (int)Fd, Offset, Size);
 			off_t Seek = (off_t)Offset, Length = (off_t)Size;
 #ifdef VI_OPENSSL
@@ -3018,7 +3193,7 @@ namespace Vitex
 			VI_ASSERT(Callback != nullptr, "callback should be set");
 			VI_ASSERT(Offset >= 0, "offset should be set and positive");
 			VI_ASSERT(Size > 0, "size should be set and greater than zero");
-			if (Fd == INVALID_SOCKET)
+			if (!IsValid())
 			{
 				Callback(SocketPoll::Reset);
 				return std::make_error_condition(std::errc::bad_file_descriptor);
@@ -3072,7 +3247,14 @@ namespace Vitex
 		Core::ExpectsIO<size_t> Socket::Write(const uint8_t* Buffer, size_t Size)
 		{
 			VI_MEASURE(Core::Timings::Networking);
-			if (Fd == INVALID_SOCKET)
+			if (Channel != nullptr)
+			{
+				auto Written = Channel->Write(Buffer, Size);
+				if (Written)
+					Outcome += *Written;
+				return Written;
+			}
+			else if (Fd == INVALID_SOCKET)
 				return std::make_error_condition(std::errc::bad_file_descriptor);
 
 			VI_TRACE("[net] fd %i write %i bytes", (int)Fd, (int)Size);
@@ -3102,7 +3284,7 @@ namespace Vitex
 		{
 			VI_ASSERT(Buffer != nullptr && Size > 0, "buffer should be set");
 			VI_ASSERT(Callback != nullptr, "callback should be set");
-			if (Fd == INVALID_SOCKET)
+			if (!IsValid())
 			{
 				if (CopyBufferWhenAsync && TempBuffer != nullptr)
 					Core::Memory::Deallocate(TempBuffer);
@@ -3179,11 +3361,230 @@ namespace Vitex
 			}, CopyBufferWhenAsync);
 			return Future;
 		}
+		Core::ExpectsIO<size_t> Socket::WriteVector(const std::string_view* Buffers, size_t Count)
+		{
+			VI_ASSERT(Buffers != nullptr && Count > 0, "buffers should be set");
+			VI_MEASURE(Core::Timings::Networking);
+			if (Channel != nullptr)
+			{
+				size_t Written = 0;
+				for (size_t i = 0; i < Count; i++)
+				{
+					if (Buffers[i].empty())
+						continue;
+
+					auto Value = Channel->Write((uint8_t*)Buffers[i].data(), Buffers[i].size());
+					if (!Value)
+					{
+						if (Written > 0)
+							break;
+
+						return Value;
+					}
+
+					Written += *Value;
+					if (*Value < Buffers[i].size())
+						break;
+				}
+
+				Outcome += Written;
+				return Written;
+			}
+			else if (Fd == INVALID_SOCKET)
+				return std::make_error_condition(std::errc::bad_file_descriptor);
+
+			VI_TRACE("[net] fd %i write %i buffers", (int)Fd, (int)Count);
+#ifdef VI_OPENSSL
+			if (Device != nullptr)
+			{
+				size_t Written = 0;
+				for (size_t i = 0; i < Count; i++)
+				{
+					if (Buffers[i].empty())
+						continue;
+
+					int Value = SSL_write(Device, Buffers[i].data(), (int)std::min<size_t>(Buffers[i].size(), (size_t)std::numeric_limits<int>::max()));
+					if (Value <= 0)
+					{
+						if (Written > 0)
+							break;
+
+						return Utils::GetLastError(Device, Value);
+					}
+
+					Written += (size_t)Value;
+					if ((size_t)Value < Buffers[i].size())
+						break;
+				}
+
+				Outcome += Written;
+				return Written;
+			}
+#endif
+			Count = std::min<size_t>(Count, MAX_WRITE_VECTOR);
+#ifdef VI_MICROSOFT
+			WSABUF Vector[MAX_WRITE_VECTOR];
+			for (size_t i = 0; i < Count; i++)
+			{
+				Vector[i].buf = (char*)Buffers[i].data();
+				Vector[i].len = (ULONG)Buffers[i].size();
+			}
+
+			DWORD Sent = 0;
+			if (WSASend(Fd, Vector, (DWORD)Count, &Sent, 0, nullptr, nullptr) != 0)
+				return Utils::GetLastError(Device, -1);
+
+			size_t Written = (size_t)Sent;
+#else
+			iovec Vector[MAX_WRITE_VECTOR];
+			for (size_t i = 0; i < Count; i++)
+			{
+				Vector[i].iov_base = (void*)Buffers[i].data();
+				Vector[i].iov_len = Buffers[i].size();
+			}
+
+			ssize_t Value = writev(Fd, Vector, (int)Count);
+			if (Value < 0)
+				return Utils::GetLastError(Device, -1);
+
+			size_t Written = (size_t)Value;
+#endif
+			if (Written == 0)
+				return std::make_error_condition(std::errc::operation_would_block);
+
+			Outcome += Written;
+			return Written;
+		}
+		Core::ExpectsIO<size_t> Socket::WriteVectorQueued(const std::string_view* Buffers, size_t Count, SocketWrittenCallback&& Callback, bool CopyBufferWhenAsync)
+		{
+			VI_ASSERT(Buffers != nullptr && Count > 0, "buffers should be set");
+			VI_ASSERT(Callback != nullptr, "callback should be set");
+			if (!IsValid())
+			{
+				Callback(SocketPoll::Reset);
+				return std::make_error_condition(std::errc::bad_file_descriptor);
+			}
+
+			size_t Index = 0, Offset = 0, Written = 0;
+			while (Index < Count)
+			{
+				if (Offset >= Buffers[Index].size())
+				{
+					Offset = 0;
+					++Index;
+					continue;
+				}
+
+				std::string_view Vector[MAX_WRITE_VECTOR];
+				size_t Size = std::min<size_t>(Count - Index, MAX_WRITE_VECTOR);
+				Vector[0] = Buffers[Index].substr(Offset);
+				for (size_t i = 1; i < Size; i++)
+					Vector[i] = Buffers[Index + i];
+
+				auto Status = WriteVector(Vector, Size);
+				if (!Status)
+				{
+					if (Status.Error() != std::errc::operation_would_block)
+					{
+						Callback(SocketPoll::Reset);
+						return Status;
+					}
+
+					if (CopyBufferWhenAsync)
+					{
+						size_t Remaining = Buffers[Index].size() - Offset;
+						for (size_t i = Index + 1; i < Count; i++)
+							Remaining += Buffers[i].size();
+
+						uint8_t* TempBuffer = Core::Memory::Allocate<uint8_t>(Remaining);
+						size_t TempOffset = Buffers[Index].size() - Offset;
+						memcpy(TempBuffer, Buffers[Index].data() + Offset, TempOffset);
+						for (size_t i = Index + 1; i < Count; i++)
+						{
+							memcpy(TempBuffer + TempOffset, Buffers[i].data(), Buffers[i].size());
+							TempOffset += Buffers[i].size();
+						}
+
+						Multiplexer::Get()->WhenWriteable(this, [this, TempBuffer, Remaining, Callback = std::move(Callback)](SocketPoll Event) mutable
+						{
+							if (!Packet::IsDone(Event))
+							{
+								Core::Memory::Deallocate(TempBuffer);
+								Callback(Event);
+							}
+							else
+								WriteQueued(TempBuffer, Remaining, std::move(Callback), true, TempBuffer, 0);
+						});
+					}
+					else
+					{
+						Core::Vector<std::string_view> Pending;
+						Pending.reserve(Count - Index);
+						Pending.push_back(Buffers[Index].substr(Offset));
+						Pending.insert(Pending.end(), Buffers + Index + 1, Buffers + Count);
+						Multiplexer::Get()->WhenWriteable(this, [this, Pending = std::move(Pending), Callback = std::move(Callback)](SocketPoll Event) mutable
+						{
+							if (!Packet::IsDone(Event))
+								return Callback(Event);
+
+							WriteVectorQueued(Pending.data(), Pending.size(), [Callback = std::move(Callback)](SocketPoll Event) mutable
+							{
+								Callback(Event == SocketPoll::FinishSync ? SocketPoll::Finish : Event);
+							}, false);
+						});
+					}
+
+					return Status;
+				}
+
+				size_t WrittenSize = *Status;
+				Written += WrittenSize;
+				while (WrittenSize > 0 && Index < Count)
+				{
+					size_t Left = Buffers[Index].size() - Offset;
+					if (WrittenSize < Left)
+					{
+						Offset += WrittenSize;
+						break;
+					}
+
+					WrittenSize -= Left;
+					Offset = 0;
+					++Index;
+				}
+			}
+
+			Callback(SocketPoll::FinishSync);
+			return Written;
+		}
+		Core::ExpectsPromiseIO<size_t> Socket::WriteVectorDeferred(const std::string_view* Buffers, size_t Count, bool CopyBufferWhenAsync)
+		{
+			size_t Size = 0;
+			for (size_t i = 0; i < Count; i++)
+				Size += Buffers[i].size();
+
+			Core::ExpectsPromiseIO<size_t> Future;
+			WriteVectorQueued(Buffers, Count, [Future, Size](SocketPoll Event) mutable
+			{
+				if (Packet::IsDone(Event))
+					Future.Set(Size);
+				else
+					Future.Set(Packet::ToCondition(Event));
+			}, CopyBufferWhenAsync);
+			return Future;
+		}
 		Core::ExpectsIO<size_t> Socket::Read(uint8_t* Buffer, size_t Size)
 		{
 			VI_ASSERT(Buffer != nullptr, "buffer should be set");
 			VI_MEASURE(Core::Timings::Networking);
-			if (Fd == INVALID_SOCKET)
+			if (Channel != nullptr)
+			{
+				auto Received = Channel->Read(Buffer, Size);
+				if (Received)
+					Income += *Received;
+				return Received;
+			}
+			else if (Fd == INVALID_SOCKET)
 				return std::make_error_condition(std::errc::bad_file_descriptor);
 
 			VI_TRACE("[net] fd %i read %i bytes", (int)Fd, (int)Size);
@@ -3213,7 +3614,7 @@ namespace Vitex
 		{
 			VI_ASSERT(Callback != nullptr, "callback should be set");
 			VI_MEASURE(Core::Timings::Networking);
-			if (Fd == INVALID_SOCKET)
+			if (!IsValid())
 			{
 				Callback(SocketPoll::Reset, nullptr, 0);
 				return std::make_error_condition(std::errc::bad_file_descriptor);
@@ -3284,7 +3685,7 @@ namespace Vitex
 			VI_ASSERT(!Match.empty(), "match should be set");
 			VI_ASSERT(Callback != nullptr, "callback should be set");
 			VI_MEASURE(Core::Timings::Networking);
-			if (Fd == INVALID_SOCKET)
+			if (!IsValid())
 			{
 				Callback(SocketPoll::Reset, nullptr, 0);
 				return std::make_error_condition(std::errc::bad_file_descriptor);
@@ -3337,7 +3738,7 @@ namespace Vitex
 			VI_ASSERT(!Match.empty(), "match should be set");
 			VI_ASSERT(Callback != nullptr, "callback should be set");
 			VI_MEASURE(Core::Timings::Networking);
-			if (Fd == INVALID_SOCKET)
+			if (!IsValid())
 			{
 				Callback(SocketPoll::Reset, nullptr, 0);
 				return std::make_error_condition(std::errc::bad_file_descriptor);
@@ -3431,7 +3832,7 @@ namespace Vitex
 			VI_ASSERT(!Match.empty(), "match should be set");
 			VI_ASSERT(Callback != nullptr, "callback should be set");
 			VI_MEASURE(Core::Timings::Networking);
-			if (Fd == INVALID_SOCKET)
+			if (!IsValid())
 			{
 				Callback(SocketPoll::Reset, nullptr, 0);
 				return std::make_error_condition(std::errc::bad_file_descriptor);
@@ -3489,7 +3890,7 @@ namespace Vitex
 			VI_ASSERT(!Match.empty(), "match should be set");
 			VI_ASSERT(Callback != nullptr, "callback should be set");
 			VI_MEASURE(Core::Timings::Networking);
-			if (Fd == INVALID_SOCKET)
+			if (!IsValid())
 			{
 				Callback(SocketPoll::Reset, nullptr, 0);
 				return std::make_error_condition(std::errc::bad_file_descriptor);
@@ -3723,6 +4124,16 @@ namespace Vitex
 			Fd = NewFd;
 			return Status;
 		}
+		Core::ExpectsIO<void> Socket::MigrateToChannel(SocketChannel* NewChannel, bool Gracefully)
+		{
+			VI_ASSERT(NewChannel != nullptr, "channel should be set");
+			VI_ASSERT(Fd == INVALID_SOCKET, "socket should not be bound to fd");
+			VI_TRACE("[net] migrate fd %i to channel 0x%" PRIXPTR, (int)Fd, (uintptr_t)NewChannel);
+			auto Status = Gracefully ? ClearEvents(false) : Core::ExpectsIO<void>(Core::Expectation::Met);
+			TryCloseChannel();
+			Channel = NewChannel;
+			return Status;
+		}
 		Core::ExpectsIO<void> Socket::SetCloseOnExec()
 		{
 			VI_TRACE("[net] fd %i setopt: cloexec", (int)Fd);
@@ -3784,6 +4195,14 @@ namespace Vitex
 		{
 			return SetSocketFlag(SO_KEEPALIVE, (Enabled ? 1 : 0));
 		}
+		Core::ExpectsIO<void> Socket::SetReusePort(bool Enabled)
+		{
+#ifdef SO_REUSEPORT
+			return SetSocketFlag(SO_REUSEPORT, (Enabled ? 1 : 0));
+#else
+			return std::make_error_condition(std::errc::not_supported);
+#endif
+		}
 		Core::ExpectsIO<void> Socket::SetTimeout(int Timeout)
 		{
 			VI_TRACE("[net] fd %i setopt: rwtimeout %i", (int)Fd, Timeout);
@@ -3871,9 +4290,13 @@ namespace Vitex
 		{
 			return Device;
 		}
+		SocketChannel* Socket::GetChannel() const
+		{
+			return Channel;
+		}
 		bool Socket::IsValid() const
 		{
-			return Fd != INVALID_SOCKET;
+			return Fd != INVALID_SOCKET || Channel != nullptr;
 		}
 		bool Socket::IsAwaitingEvents()
 		{
@@ -4041,24 +4464,36 @@ namespace Vitex
 				return Core::SystemException("configure server: invalid listeners", std::make_error_condition(std::errc::invalid_argument));
 			}
 
+			size_t MaxListeners = std::max<size_t>(1, Router->MaxListeners);
 			for (auto&& It : Router->Listeners)
 			{
-				SocketListener* Host = new SocketListener(It.first, It.second.Address, It.second.IsSecure);
-				auto Status = Host->Stream->Open(Host->Address);
-				if (!Status)
-					return Core::SystemException(Core::Stringify::Text("open %s listener error", GetAddressIdentification(Host->Address).c_str()), std::move(Status.Error()));
+				for (size_t i = 0; i < MaxListeners; i++)
+				{
+					SocketListener* Host = new SocketListener(It.first, It.second.Address, It.second.IsSecure);
+					Listeners.push_back(Host);
 
-				Status = Host->Stream->Bind(Host->Address);
-				if (!Status)
-					return Core::SystemException(Core::Stringify::Text("bind %s listener error", GetAddressIdentification(Host->Address).c_str()), std::move(Status.Error()));
+					auto Status = Host->Stream->Open(Host->Address);
+					if (!Status)
+						return Core::SystemException(Core::Stringify::Text("open %s listener error", GetAddressIdentification(Host->Address).c_str()), std::move(Status.Error()));
 
-				Status = Host->Stream->Listen((int)Router->BacklogQueue);
-				if (!Status)
-					return Core::SystemException(Core::Stringify::Text("listen %s listener error", GetAddressIdentification(Host->Address).c_str()), std::move(Status.Error()));
+					if (MaxListeners > 1)
+					{
+						Status = Host->Stream->SetReusePort(true);
+						if (!Status)
+							return Core::SystemException(Core::Stringify::Text("reuse port %s listener error", GetAddressIdentification(Host->Address).c_str()), std::move(Status.Error()));
+					}
+
+					Status = Host->Stream->Bind(Host->Address);
+					if (!Status)
+						return Core::SystemException(Core::Stringify::Text("bind %s listener error", GetAddressIdentification(Host->Address).c_str()), std::move(Status.Error()));
 
-				Host->Stream->SetCloseOnExec();
-				Host->Stream->SetBlocking(false);
-				Listeners.push_back(Host);
+					Status = Host->Stream->Listen((int)Router->BacklogQueue);
+					if (!Status)
+						return Core::SystemException(Core::Stringify::Text("listen %s listener error", GetAddressIdentification(Host->Address).c_str()), std::move(Status.Error()));
+
+					Host->Stream->SetCloseOnExec();
+					Host->Stream->SetBlocking(false);
+				}
 			}
 #ifdef VI_OPENSSL
 			for (auto&& It : Router->Certificates)
@@ -4226,10 +4661,12 @@ namespace Vitex
 			Base->Address = std::move(Incoming.Address);
 			Base->Stream->SetIoTimeout(Router->SocketTimeout);
 			Base->Stream->MigrateTo(Incoming.Fd, false);
+#ifndef NET_ACCEPT4
 			Base->Stream->SetCloseOnExec();
+			Base->Stream->SetBlocking(false);
+#endif
 			Base->Stream->SetNoDelay(Router->EnableNoDelay);
 			Base->Stream->SetKeepAlive(true);
-			Base->Stream->SetBlocking(false);
 
 			if (Router->GracefulTimeWait >= 0)
 				Base->Stream->SetTimeWait((int)Router->GracefulTimeWait);
@@ -400,40 +400,52 @@ namespace Vitex
 		class VI_OUT_TS Multiplexer final : public Core::Singleton<Multiplexer>
 		{
 		private:
-			std::mutex Exclusive;
-			Core::UnorderedSet<Socket*> Trackers;
-			Core::Vector<EpollFd> Fds;
-			Core::OrderedMap<std::chrono::microseconds, Socket*> Timers;
-			EpollHandle Handle;
+			struct Shard
+			{
+				std::mutex Exclusive;
+				Core::UnorderedSet<Socket*> Trackers;
+				Core::Vector<EpollFd> Fds;
+				Core::OrderedMap<std::chrono::microseconds, Socket*> Timers;
+				EpollHandle Handle;
+
+				Shard(size_t MaxEvents) noexcept;
+			};
+
+		private:
+			Core::Vector<Shard*> Shards;
 			std::atomic<size_t> Activations;
 			uint64_t DefaultTimeout;
 
 		public:
 			Multiplexer() noexcept;
-			Multiplexer(uint64_t DispatchTimeout, size_t MaxEvents) noexcept;
+			Multiplexer(uint64_t DispatchTimeout, size_t MaxEvents, size_t MaxShards = 1) noexcept;
 			virtual ~Multiplexer() noexcept override;
-			void Rescale(uint64_t DispatchTimeout, size_t MaxEvents) noexcept;
+			void Rescale(uint64_t DispatchTimeout, size_t MaxEvents, size_t MaxShards = 1) noexcept;
 			void Activate() noexcept;
 			void Deactivate() noexcept;
 			void Shutdown() noexcept;
 			int Dispatch(uint64_t Timeout) noexcept;
+			int DispatchShard(size_t Index, uint64_t Timeout) noexcept;
 			bool WhenReadable(Socket* Value, PollEventCallback&& WhenReady) noexcept;
 			bool WhenWriteable(Socket* Value, PollEventCallback&& WhenReady) noexcept;
 			bool CancelEvents(Socket* Value, SocketPoll Event = SocketPoll::Cancel) noexcept;
 			bool ClearEvents(Socket* Value) noexcept;
+			bool NotifyEvents(Socket* Value, bool Readable, bool Writeable) noexcept;
 			bool IsListening() noexcept;
 			size_t GetActivations() noexcept;
+			size_t GetShards() const noexcept;
 
 		private:
-			void DispatchTimers(const std::chrono::microseconds& Time) noexcept;
-			bool DispatchEvents(const EpollFd& Fd, const std::chrono::microseconds& Time) noexcept;
-			void TryDispatch() noexcept;
-			void TryEnqueue() noexcept;
+			Shard* GetShard(Socket* Value) noexcept;
+			void DispatchTimers(Shard* Target, const std::chrono::microseconds& Time) noexcept;
+			bool DispatchEvents(Shard* Target, const EpollFd& Fd, const std::chrono::microseconds& Time) noexcept;
+			void TryDispatch(size_t Index) noexcept;
+			void TryEnqueue(size_t Index) noexcept;
 			void TryListen() noexcept;
 			void TryUnlisten() noexcept;
-			void AddTimeout(Socket* Value, const std::chrono::microseconds& Time) noexcept;
-			void UpdateTimeout(Socket* Value, const std::chrono::microseconds& Time) noexcept;
-			void RemoveTimeout(Socket* Value) noexcept;
+			void AddTimeout(Shard* Target, Socket* Value, const std::chrono::microseconds& Time) noexcept;
+			void UpdateTimeout(Shard* Target, Socket* Value, const std::chrono::microseconds& Time) noexcept;
+			void RemoveTimeout(Shard* Target, Socket* Value) noexcept;
 		};
 
 		class VI_OUT_TS Uplinks final : public Core::Singleton<Uplinks>
@@ -494,6 +506,18 @@ namespace Vitex
 			void* GetPrivateKeyEVP_PKEY();
 		};
 
+		class VI_OUT SocketChannel : public Core::Reference<SocketChannel>
+		{
+		public:
+			SocketChannel() = default;
+			virtual ~SocketChannel() noexcept = default;
+			virtual Core::ExpectsIO<size_t> Read(uint8_t* Buffer, size_t Size) = 0;
+			virtual Core::ExpectsIO<size_t> Write(const uint8_t* Buffer, size_t Size) = 0;
+			virtual void Detach() = 0;
+			virtual bool IsReadable() = 0;
+			virtual bool IsWriteable() = 0;
+		};
+
 		class VI_OUT Socket final : public Core::Reference<Socket>
 		{
 			friend EpollHandle;
@@ -515,6 +539,7 @@ namespace Vitex
 			} Events;
 
 		private:
+			SocketChannel* Channel;
 			ssl_st* Device;
 			socket_t Fd;
 
@@ -543,6 +568,9 @@ namespace Vitex
 			Core::ExpectsIO<size_t> Write(const uint8_t* Buffer, size_t Size);
 			Core::ExpectsIO<size_t> WriteQueued(const uint8_t* Buffer, size_t Size, SocketWrittenCallback&& Callback, bool CopyBufferWhenAsync = true, uint8_t* TempBuffer = nullptr, size_t TempOffset = 0);
 			Core::ExpectsPromiseIO<size_t> WriteDeferred(const uint8_t* Buffer, size_t Size, bool CopyBufferWhenAsync = true);
+			Core::ExpectsIO<size_t> WriteVector(const std::string_view* Buffers, size_t Count);
+			Core::ExpectsIO<size_t> WriteVectorQueued(const std::string_view* Buffers, size_t Count, SocketWrittenCallback&& Callback, bool CopyBufferWhenAsync = true);
+			Core::ExpectsPromiseIO<size_t> WriteVectorDeferred(const std::string_view* Buffers, size_t Count, bool CopyBufferWhenAsync = true);
 			Core::ExpectsIO<size_t> Read(uint8_t* Buffer, size_t Size);
 			Core::ExpectsIO<size_t> ReadQueued(size_t Size, SocketReadCallback&& Callback, size_t TempBuffer = 0);
 			Core::ExpectsPromiseIO<Core::String> ReadDeferred(size_t Size);
@@ -561,6 +589,7 @@ namespace Vitex
 			Core::ExpectsIO<void> Listen(int Backlog);
 			Core::ExpectsIO<void> ClearEvents(bool Gracefully);
 			Core::ExpectsIO<void> MigrateTo(socket_t Fd, bool Gracefully = true);
+			Core::ExpectsIO<void> MigrateToChannel(SocketChannel* NewChannel, bool Gracefully = true);
 			Core::ExpectsIO<void> SetCloseOnExec();
 			Core::ExpectsIO<void> SetTimeWait(int Timeout);
 			Core::ExpectsIO<void> SetSocket(int Option, void* Value, size_t Size);
@@ -570,6 +599,7 @@ namespace Vitex
 			Core::ExpectsIO<void> SetBlocking(bool Enabled);
 			Core::ExpectsIO<void> SetNoDelay(bool Enabled);
 			Core::ExpectsIO<void> SetKeepAlive(bool Enabled);
+			Core::ExpectsIO<void> SetReusePort(bool Enabled);
 			Core::ExpectsIO<void> SetTimeout(int Timeout);
 			Core::ExpectsIO<void> GetSocket(int Option, void* Value, size_t* Size);
 			Core::ExpectsIO<void> GetAny(int Level, int Option, void* Value, size_t* Size);
@@ -581,6 +611,7 @@ namespace Vitex
 			void SetIoTimeout(uint64_t TimeoutMs);
 			socket_t GetFd() const;
 			ssl_st* GetDevice() const;
+			SocketChannel* GetChannel() const;
 			bool IsAwaitingReadable();
 			bool IsAwaitingWriteable();
 			bool IsAwaitingEvents();
@@ -589,6 +620,7 @@ namespace Vitex
 
 		private:
 			Core::ExpectsIO<void> TryCloseQueued(SocketStatusCallback&& Callback, const std::chrono::microseconds& Time, bool KeepTrying);
+			bool TryCloseChannel();
 		};
 
 		class VI_OUT SocketListener final : public Core::Reference<SocketListener>
@@ -614,6 +646,7 @@ namespace Vitex
 			size_t BacklogQueue = 20;
 			size_t SocketTimeout = 10000;
 			size_t MaxConnections = 0;
+			size_t MaxListeners = 1;
 			int64_t KeepAliveMaxCount = 0;
 			int64_t GracefulTimeWait = -1;
 			bool EnableNoDelay = false;
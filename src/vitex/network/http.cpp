@@ -20,6 +20,13 @@
 #endif
 #include <random>
 #include <string>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define HTTP_AVX2
+#elif defined(__SSE4_2__)
+#include <nmmintrin.h>
+#define HTTP_SSE42
+#endif
 extern "C"
 {
 #ifdef VI_ZLIB
@@ -44,7 +51,12 @@ extern "C"
 #define HTTP_WEBSOCKET_LEGACY_KEY_SIZE 8
 #define HTTP_MAX_REDIRECTS 128
 #define HTTP_HRM_SIZE 1024 * 1024 * 4
+#define HTTP_FILE_CACHE_SIZE 1024
+#define HTTP_FILE_CACHE_TIMEOUT 1000
+#define HTTP_VARIANT_CACHE_SIZE 1024 * 1024 * 32
 #define HTTP_KIMV_LOAD_FACTOR 48
+#define HTTP2_PAYLOAD_LIMIT 1024 * 256
+#define HTTP2_WRITE_LIMIT 1024 * 64
 #define GZ_HEADER_SIZE 17
 #pragma warning(push)
 #pragma warning(disable: 4996)
@@ -157,6 +169,122 @@ namespace Vitex
 				else
 					Map.clear();
 			}
+#if defined(HTTP_AVX2)
+			static size_t MaskOffset(uint32_t Mask)
+			{
+#ifdef _MSC_VER
+				unsigned long Index;
+				_BitScanForward(&Index, Mask);
+				return (size_t)Index;
+#else
+				return (size_t)__builtin_ctz(Mask);
+#endif
+			}
+			static uint32_t MaskInRange(__m256i Value, uint8_t Min, uint8_t Max)
+			{
+				__m256i Offset = _mm256_sub_epi8(Value, _mm256_set1_epi8((char)Min));
+				return (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_min_epu8(Offset, _mm256_set1_epi8((char)(Max - Min))), Offset));
+			}
+			static const uint8_t* SkipHeaderName(const uint8_t* Buffer, const uint8_t* BufferEnd)
+			{
+				while (BufferEnd - Buffer >= 32)
+				{
+					__m256i Value = _mm256_loadu_si256((const __m256i*)Buffer);
+					uint32_t Mask = MaskInRange(_mm256_or_si256(Value, _mm256_set1_epi8(0x20)), 'a', 'z') | MaskInRange(Value, '0', '9') | (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(Value, _mm256_set1_epi8('-')));
+					if (Mask != 0xFFFFFFFF)
+						return Buffer + MaskOffset(~Mask);
+					Buffer += 32;
+				}
+				return Buffer;
+			}
+			static const uint8_t* SkipHeaderValue(const uint8_t* Buffer, const uint8_t* BufferEnd)
+			{
+				while (BufferEnd - Buffer >= 32)
+				{
+					__m256i Value = _mm256_loadu_si256((const __m256i*)Buffer);
+					uint32_t Mask = (MaskInRange(Value, 0x00, 0x1F) & ~(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(Value, _mm256_set1_epi8('\t')))) | (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(Value, _mm256_set1_epi8(0x7F)));
+					if (Mask != 0)
+						return Buffer + MaskOffset(Mask);
+					Buffer += 32;
+				}
+				return Buffer;
+			}
+			static const uint8_t* SkipRequestToken(const uint8_t* Buffer, const uint8_t* BufferEnd)
+			{
+				while (BufferEnd - Buffer >= 32)
+				{
+					__m256i Value = _mm256_loadu_si256((const __m256i*)Buffer);
+					uint32_t Mask = MaskInRange(Value, 0x00, 0x20) | (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(Value, _mm256_set1_epi8(0x7F)));
+					if (Mask != 0)
+						return Buffer + MaskOffset(Mask);
+					Buffer += 32;
+				}
+				return Buffer;
+			}
+			static const uint8_t* SkipLine(const uint8_t* Buffer, const uint8_t* BufferEnd)
+			{
+				while (BufferEnd - Buffer >= 32)
+				{
+					__m256i Value = _mm256_loadu_si256((const __m256i*)Buffer);
+					uint32_t Mask = (uint32_t)_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(Value, _mm256_set1_epi8('\r')), _mm256_cmpeq_epi8(Value, _mm256_set1_epi8('\n'))));
+					if (Mask != 0)
+						return Buffer + MaskOffset(Mask);
+					Buffer += 32;
+				}
+				return Buffer;
+			}
+#elif defined(HTTP_SSE42)
+			static const uint8_t* SkipRanges(const uint8_t* Buffer, const uint8_t* BufferEnd, const char* Ranges, int RangesSize, bool Negate)
+			{
+				__m128i Range = _mm_loadu_si128((const __m128i*)Ranges);
+				while (BufferEnd - Buffer >= 16)
+				{
+					__m128i Value = _mm_loadu_si128((const __m128i*)Buffer);
+					int Index = Negate ? _mm_cmpestri(Range, RangesSize, Value, 16, _SIDD_UBYTE_OPS | _SIDD_CMP_RANGES | _SIDD_NEGATIVE_POLARITY) : _mm_cmpestri(Range, RangesSize, Value, 16, _SIDD_UBYTE_OPS | _SIDD_CMP_RANGES);
+					if (Index != 16)
+						return Buffer + Index;
+					Buffer += 16;
+				}
+				return Buffer;
+			}
+			static const uint8_t* SkipHeaderName(const uint8_t* Buffer, const uint8_t* BufferEnd)
+			{
+				alignas(16) static const char Ranges[16] = "AZaz09--";
+				return SkipRanges(Buffer, BufferEnd, Ranges, 8, true);
+			}
+			static const uint8_t* SkipHeaderValue(const uint8_t* Buffer, const uint8_t* BufferEnd)
+			{
+				alignas(16) static const char Ranges[16] = "\000\010\012\037\177\177";
+				return SkipRanges(Buffer, BufferEnd, Ranges, 6, false);
+			}
+			static const uint8_t* SkipRequestToken(const uint8_t* Buffer, const uint8_t* BufferEnd)
+			{
+				alignas(16) static const char Ranges[16] = "\000\040\177\177";
+				return SkipRanges(Buffer, BufferEnd, Ranges, 4, false);
+			}
+			static const uint8_t* SkipLine(const uint8_t* Buffer, const uint8_t* BufferEnd)
+			{
+				alignas(16) static const char Ranges[16] = "\r\r\n\n";
+				return SkipRanges(Buffer, BufferEnd, Ranges, 4, false);
+			}
+#else
+			static const uint8_t* SkipHeaderName(const uint8_t* Buffer, const uint8_t* BufferEnd)
+			{
+				return Buffer;
+			}
+			static const uint8_t* SkipHeaderValue(const uint8_t* Buffer, const uint8_t* BufferEnd)
+			{
+				return Buffer;
+			}
+			static const uint8_t* SkipRequestToken(const uint8_t* Buffer, const uint8_t* BufferEnd)
+			{
+				return Buffer;
+			}
+			static const uint8_t* SkipLine(const uint8_t* Buffer, const uint8_t* BufferEnd)
+			{
+				return Buffer;
+			}
+#endif
 
 			MimeStatic::MimeStatic(const std::string_view& Ext, const std::string_view& T) : Extension(Ext), Type(T)
 			{
@@ -172,7 +300,26 @@ namespace Vitex
 				SetExpires(0);
 			}
 
-			WebSocketFrame::WebSocketFrame(Socket* NewStream, void* NewUserData) : Stream(NewStream), Codec(new WebCodec()), State((uint32_t)WebSocketState::Open), Tunneling((uint32_t)Tunnel::Healthy), Active(true), Deadly(false), Busy(false), UserData(NewUserData)
+			struct SharedFrame
+			{
+				std::atomic<size_t> References;
+				Core::String Data;
+
+				SharedFrame() : References(1)
+				{
+				}
+				void AddRef()
+				{
+					++References;
+				}
+				void Release()
+				{
+					if (!--References)
+						Core::Memory::Delete(this);
+				}
+			};
+
+			WebSocketFrame::WebSocketFrame(Socket* NewStream, void* NewUserData) : Stream(NewStream), Codec(new WebCodec()), Backlog(0), State((uint32_t)WebSocketState::Open), Tunneling((uint32_t)Tunnel::Healthy), Active(true), Deadly(false), Busy(false), UserData(NewUserData)
 			{
 			}
 			WebSocketFrame::~WebSocketFrame() noexcept
@@ -180,6 +327,8 @@ namespace Vitex
 				while (!Messages.empty())
 				{
 					auto& Next = Messages.front();
+					if (Next.Shared != nullptr)
+						Next.Shared->Release();
 					Core::Memory::Deallocate(Next.Buffer);
 					Messages.pop();
 				}
@@ -201,26 +350,31 @@ namespace Vitex
 				Busy = true;
 				Unique.Negate();
 
+				Core::String Copy;
+				bool Deflated = (!Buffer.empty() && (Opcode == WebSocketOp::Text || Opcode == WebSocketOp::Binary) && Codec->IsDeflated() && Codec->Compress(Buffer, Copy));
+				if (!Deflated)
+					Copy.assign(Buffer.data(), Buffer.size());
+
 				uint8_t Header[14];
 				size_t HeaderLength = 1;
-				Header[0] = 0x80 + ((size_t)Opcode & 0xF);
+				Header[0] = 0x80 + (Deflated ? 0x40 : 0x00) + ((size_t)Opcode & 0xF);
 
-				if (Buffer.size() < 126)
+				if (Copy.size() < 126)
 				{
-					Header[1] = (uint8_t)Buffer.size();
+					Header[1] = (uint8_t)Copy.size();
 					HeaderLength = 2;
 				}
-				else if (Buffer.size() <= 65535)
+				else if (Copy.size() <= 65535)
 				{
-					uint16_t Length = htons((uint16_t)Buffer.size());
+					uint16_t Length = htons((uint16_t)Copy.size());
 					Header[1] = 126;
 					HeaderLength = 4;
 					memcpy(Header + 2, &Length, 2);
 				}
 				else
 				{
-					uint32_t Length1 = htonl((uint64_t)Buffer.size() >> 32);
-					uint32_t Length2 = htonl((uint64_t)Buffer.size() & 0xFFFFFFFF);
+					uint32_t Length1 = htonl((uint64_t)Copy.size() >> 32);
+					uint32_t Length2 = htonl((uint64_t)Copy.size() & 0xFFFFFFFF);
 					Header[1] = 127;
 					HeaderLength = 10;
 					memcpy(Header + 2, &Length1, 4);
@@ -234,7 +388,6 @@ namespace Vitex
 					HeaderLength += 4;
 				}
 
-				Core::String Copy = Core::String(Buffer);
 				auto Status = Stream->WriteQueued(Header, HeaderLength, [this, Copy = std::move(Copy), Callback = std::move(Callback)](SocketPoll Event) mutable
 				{
 					if (Packet::IsDone(Event))
@@ -331,6 +484,10 @@ namespace Vitex
 
 				return Core::Expectation::Met;
 			}
+			bool WebSocketFrame::SetDeflate(const WebSocketDeflate& Options)
+			{
+				return Codec->SetDeflate(Options);
+			}
 			void WebSocketFrame::Dequeue()
 			{
 				Core::UMutex<std::mutex> Unique(Section);
@@ -338,12 +495,39 @@ namespace Vitex
 					return;
 
 				Message Next = std::move(Messages.front());
+				Backlog -= Next.Size;
 				Messages.pop();
-				Unique.Negate();
 
+				if (Next.Shared != nullptr)
+				{
+					Busy = true;
+					Unique.Negate();
+					return Transmit(Next.Shared);
+				}
+
+				Unique.Negate();
 				Send(Next.Mask, std::string_view(Next.Buffer, Next.Size), Next.Opcode, std::move(Next.Callback));
 				Core::Memory::Deallocate(Next.Buffer);
 			}
+			void WebSocketFrame::Transmit(SharedFrame* Frame)
+			{
+				Stream->WriteQueued((uint8_t*)Frame->Data.data(), Frame->Data.size(), [this, Frame](SocketPoll Event)
+				{
+					Frame->Release();
+					if (Packet::IsDone(Event) || Packet::IsSkip(Event))
+					{
+						bool Ignore = IsIgnore();
+						Busy = false;
+						if (!Ignore)
+							Dequeue();
+					}
+					else if (Packet::IsError(Event))
+					{
+						Tunneling = (uint32_t)Tunnel::Gone;
+						Busy = false;
+					}
+				}, false);
+			}
 			void WebSocketFrame::Finalize()
 			{
 				if (Tunneling == (uint32_t)Tunnel::Healthy)
@@ -430,18 +614,18 @@ namespace Vitex
 						}
 					}
 
-					WebSocketOp Opcode;
-					if (!Codec->GetFrame(&Opcode, &Codec->Data))
+					WebSocketOp Opcode; std::string_view Frame;
+					if (!Codec->GetFrame(&Opcode, &Frame))
 						goto Retry;
 
 					State = (uint32_t)WebSocketState::Process;
 					if (Opcode == WebSocketOp::Text || Opcode == WebSocketOp::Binary)
 					{
-						VI_DEBUG("[websocket] sock %i frame data: %.*s", (int)Stream->GetFd(), (int)Codec->Data.size(), Codec->Data.data());
+						VI_DEBUG("[websocket] sock %i frame data: %.*s", (int)Stream->GetFd(), (int)Frame.size(), Frame.data());
 						if (Receive)
 						{
 							Unique.Negate();
-							if (!Receive(this, Opcode, std::string_view(Codec->Data.data(), Codec->Data.size())))
+							if (!Receive(this, Opcode, Frame))
 								Next();
 						}
 					}
@@ -523,22 +707,269 @@ namespace Vitex
 				Next.Size = Buffer.size();
 				Next.Opcode = Opcode;
 				Next.Callback = Callback;
+				Next.Shared = nullptr;
 				if (Next.Buffer != nullptr)
 					memcpy(Next.Buffer, Buffer.data(), sizeof(char) * Buffer.size());
 
+				Backlog += Next.Size;
+				Messages.emplace(std::move(Next));
+				return true;
+			}
+			bool WebSocketFrame::Broadcast(SharedFrame* Frame, BroadcastPolicy Policy, size_t MaxBacklog)
+			{
+				Core::UMutex<std::mutex> Unique(Section);
+				if (IsIgnore())
+					return false;
+
+				if (IsWriteable())
+				{
+					Busy = true;
+					Unique.Negate();
+					Frame->AddRef();
+					Transmit(Frame);
+					return true;
+				}
+
+				if (Policy != BroadcastPolicy::Buffer && Backlog + Frame->Data.size() > MaxBacklog)
+				{
+					if (Policy == BroadcastPolicy::Drop)
+						return false;
+
+					Tunneling = (uint32_t)Tunnel::Gone;
+					Unique.Negate();
+					Stream->Shutdown();
+					return false;
+				}
+
+				Message Next;
+				Next.Mask = 0;
+				Next.Buffer = nullptr;
+				Next.Size = Frame->Data.size();
+				Next.Opcode = WebSocketOp::Continue;
+				Next.Shared = Frame;
+				Frame->AddRef();
+
+				Backlog += Next.Size;
 				Messages.emplace(std::move(Next));
 				return true;
 			}
 
-			RouterGroup::RouterGroup(const std::string_view& NewMatch, RouteMode NewMode) noexcept : Match(NewMatch), Mode(NewMode)
+			struct RouterAutomaton
+			{
+				enum class Literal : uint8_t
+				{
+					Contains,
+					Prefix,
+					Suffix,
+					Exact
+				};
+
+				struct Node
+				{
+					Core::Vector<std::pair<uint8_t, uint32_t>> Next;
+					Core::Vector<uint32_t> Terminals;
+					uint32_t Fail = 0;
+					uint32_t Output = 0;
+				};
+
+				struct Pattern
+				{
+					Core::String Required;
+					uint32_t Index = 0;
+					bool Anchored = false;
+				};
+
+				struct Entry
+				{
+					uint32_t Length = 0;
+					Literal Type = Literal::Contains;
+				};
+
+				Core::Vector<Node> Nodes;
+				Core::Vector<Entry> Entries;
+				Core::Vector<Pattern> Patterns;
+				size_t Size = 0;
+
+				RouterAutomaton(const Core::Vector<RouterEntry*>& Routes) : Size(Routes.size())
+				{
+					Nodes.emplace_back();
+					Entries.resize(Routes.size());
+					for (size_t i = 0; i < Routes.size(); i++)
+					{
+						auto& Location = Routes[i]->Location;
+						std::string_view Source = Location.GetRegex();
+						bool Anchored = (!Source.empty() && Source.front() == '^');
+						if (Anchored)
+							Source.remove_prefix(1);
+
+						bool Ended = (!Source.empty() && Source.back() == '$');
+						if (Ended)
+							Source.remove_suffix(1);
+
+						if (!Location.IgnoreCase && !Source.empty() && Source.find_first_of("^$().[]*+?|\\") == std::string_view::npos)
+						{
+							Entries[i].Length = (uint32_t)Source.size();
+							Entries[i].Type = (Anchored ? (Ended ? Literal::Exact : Literal::Prefix) : (Ended ? Literal::Suffix : Literal::Contains));
+							Insert(Source, (uint32_t)i);
+							continue;
+						}
+
+						Pattern Next;
+						Next.Index = (uint32_t)i;
+						Next.Anchored = Anchored;
+						if (!Location.IgnoreCase && Source.find('|') == std::string_view::npos)
+						{
+							size_t Offset = Source.find_first_of("^$().[]*+?|\\");
+							if (Offset != std::string_view::npos && Offset > 0 && (Source[Offset] == '*' || Source[Offset] == '+' || Source[Offset] == '?'))
+								--Offset;
+							Next.Required = Source.substr(0, Offset);
+						}
+						Patterns.emplace_back(std::move(Next));
+					}
+					Link();
+				}
+				RouterEntry* Find(const Core::Vector<RouterEntry*>& Routes, const std::string_view& Location, Compute::RegexResult& Result)
+				{
+					size_t Best = Routes.size();
+					uint32_t State = 0;
+					for (size_t i = 0; i < Location.size(); i++)
+					{
+						State = Transition(State, (uint8_t)Location[i]);
+						for (uint32_t Target = (Nodes[State].Terminals.empty() ? Nodes[State].Output : State); Target != 0; Target = Nodes[Target].Output)
+						{
+							for (uint32_t Index : Nodes[Target].Terminals)
+							{
+								if (Index >= Best)
+									break;
+
+								auto& Next = Entries[Index];
+								bool Starts = (i + 1 == Next.Length), Ends = (i + 1 == Location.size());
+								if (Next.Type == Literal::Contains || (Next.Type == Literal::Prefix && Starts) || (Next.Type == Literal::Suffix && Ends) || (Next.Type == Literal::Exact && Starts && Ends))
+								{
+									Best = Index;
+									break;
+								}
+							}
+						}
+					}
+
+					for (auto& Next : Patterns)
+					{
+						if (Next.Index >= Best)
+							break;
+
+						if (!Next.Required.empty())
+						{
+							if (Next.Anchored ? !Core::Stringify::StartsWith(Location, Next.Required) : Location.find(Next.Required) == std::string_view::npos)
+								continue;
+						}
+
+						if (Compute::Regex::Match(&Routes[Next.Index]->Location, Result, Location))
+							return Routes[Next.Index];
+					}
+
+					if (Best < Routes.size() && Compute::Regex::Match(&Routes[Best]->Location, Result, Location))
+						return Routes[Best];
+
+					Result = Compute::RegexResult();
+					return nullptr;
+				}
+				void Insert(const std::string_view& Source, uint32_t Index)
+				{
+					uint32_t State = 0;
+					for (char Symbol : Source)
+					{
+						uint32_t Next = Child(State, (uint8_t)Symbol);
+						if (!Next)
+						{
+							Next = (uint32_t)Nodes.size();
+							Nodes[State].Next.emplace_back((uint8_t)Symbol, Next);
+							Nodes.emplace_back();
+						}
+						State = Next;
+					}
+					Nodes[State].Terminals.push_back(Index);
+				}
+				void Link()
+				{
+					Core::Vector<uint32_t> Queue;
+					Queue.reserve(Nodes.size());
+					for (auto& Next : Nodes.front().Next)
+						Queue.push_back(Next.second);
+
+					for (size_t i = 0; i < Queue.size(); i++)
+					{
+						uint32_t State = Queue[i];
+						for (auto& Next : Nodes[State].Next)
+						{
+							uint32_t Fail = Nodes[State].Fail;
+							while (Fail != 0 && !Child(Fail, Next.first))
+								Fail = Nodes[Fail].Fail;
+
+							uint32_t Target = Child(Fail, Next.first);
+							auto& Base = Nodes[Next.second];
+							Base.Fail = (Target != Next.second ? Target : 0);
+							Base.Output = (Nodes[Base.Fail].Terminals.empty() ? Nodes[Base.Fail].Output : Base.Fail);
+							Queue.push_back(Next.second);
+						}
+					}
+				}
+				uint32_t Transition(uint32_t State, uint8_t Symbol)
+				{
+					while (true)
+					{
+						uint32_t Next = Child(State, Symbol);
+						if (Next != 0 || State == 0)
+							return Next;
+
+						State = Nodes[State].Fail;
+					}
+				}
+				uint32_t Child(uint32_t State, uint8_t Symbol)
+				{
+					for (auto& Next : Nodes[State].Next)
+					{
+						if (Next.first == Symbol)
+							return Next.second;
+					}
+					return 0;
+				}
+			};
+
+			RouterGroup::RouterGroup(const std::string_view& NewMatch, RouteMode NewMode) noexcept : Match(NewMatch), Mode(NewMode), Automaton(nullptr)
 			{
 			}
 			RouterGroup::~RouterGroup() noexcept
 			{
+				Invalidate();
 				for (auto* Entry : Routes)
 					Core::Memory::Release(Entry);
 				Routes.clear();
 			}
+			void RouterGroup::Compile()
+			{
+				Invalidate();
+				Automaton = Core::Memory::New<RouterAutomaton>(Routes);
+			}
+			void RouterGroup::Invalidate()
+			{
+				Core::Memory::Delete(Automaton);
+				Automaton = nullptr;
+			}
+			RouterEntry* RouterGroup::Find(const std::string_view& Location, Compute::RegexResult& Result)
+			{
+				if (Automaton != nullptr && Automaton->Size == Routes.size())
+					return Automaton->Find(Routes, Location, Result);
+
+				for (auto* Next : Routes)
+				{
+					VI_ASSERT(Next != nullptr, "route should be set");
+					if (Compute::Regex::Match(&Next->Location, Result, Location))
+						return Next;
+				}
+
+				return nullptr;
+			}
 
 			RouterEntry* RouterEntry::From(const RouterEntry& Other, const Compute::RegexSource& Source)
 			{
@@ -562,6 +993,7 @@ namespace Vitex
 
 				Groups.clear();
 				Core::Memory::Release(Base);
+				Core::Memory::Release(Session.Store);
 			}
 			void MapRouter::Sort()
 			{
@@ -594,6 +1026,7 @@ namespace Vitex
 						return A->Location.GetRegex().size() > B->Location.GetRegex().size();
 					};
 					VI_SORT(Group->Routes.begin(), Group->Routes.end(), Comparator);
+					Group->Compile();
 				}
 			}
 			RouterGroup* MapRouter::Group(const std::string_view& Match, RouteMode Mode)
@@ -670,6 +1103,7 @@ namespace Vitex
 				{
 					HTTP::RouterEntry* Result = HTTP::RouterEntry::From(*From, Compute::RegexSource(Pattern));
 					Group->Routes.push_back(Result);
+					Group->Invalidate();
 					return Result;
 				}
 
@@ -677,6 +1111,7 @@ namespace Vitex
 				Result->Location = Compute::RegexSource(Pattern);
 				Result->Router = this;
 				Group->Routes.push_back(Result);
+				Group->Invalidate();
 				return Result;
 			}
 			bool MapRouter::Remove(RouterEntry* Source)
@@ -689,6 +1124,7 @@ namespace Vitex
 					{
 						Core::Memory::Release(*It);
 						Group->Routes.erase(It);
+						Group->Invalidate();
 						return true;
 					}
 				}
@@ -1553,6 +1989,11 @@ namespace Vitex
 			}
 			Connection::~Connection() noexcept
 			{
+				if (Cache != nullptr)
+					FileCache::Get()->Discard(Cache);
+				if (WebSocket != nullptr && Root != nullptr)
+					Root->Unsubscribe(WebSocket);
+				Core::Memory::Release(Current);
 				Core::Memory::Release(Resolver);
 				Core::Memory::Release(WebSocket);
 			}
@@ -1561,8 +2002,25 @@ namespace Vitex
 				VI_ASSERT(!Route || (Route->Router && Route->Router->Base), "router should be valid");
 				if (!Fully)
 					Info.Abort = (Info.Abort || Response.StatusCode <= 0);
+				if (Current != nullptr)
+				{
+					if (ConnectionValid(this))
+					{
+						auto Status = Current->Write(this);
+						if (!Status)
+							VI_ERR("[http] session %s write error: %s", Current->SessionId.c_str(), Status.Error().what());
+					}
+					Core::Memory::Release(Current);
+				}
 				if (Route != nullptr)
 					Route = Route->Router->Base;
+				if (Cache != nullptr)
+				{
+					FileCache::Get()->Discard(Cache);
+					Cache = nullptr;
+				}
+				if (Fully)
+					Pipeline.clear();
 				Request.Cleanup();
 				Response.Cleanup();
 				SocketConnection::Reset(Fully);
@@ -1743,10 +2201,11 @@ namespace Vitex
 					Route->Callbacks.Headers(this, *Content);
 
 				Content->append("\r\n", 2);
+				std::string_view Buffers[2] = { *Content, std::string_view() };
 				if (ApplyBodyInlining)
-					Content->append(Response.Content.Data.begin(), Response.Content.Data.end());
+					Buffers[1] = std::string_view(Response.Content.Data.data(), Response.Content.Data.size());
 
-				auto Status = Stream->WriteQueued((uint8_t*)Content->c_str(), Content->size(), [this, Content, Callback = std::move(Callback)](SocketPoll Event) mutable
+				auto Status = Stream->WriteVectorQueued(Buffers, Buffers[1].empty() ? 1 : 2, [this, Content, Callback = std::move(Callback)](SocketPoll Event) mutable
 				{
 					HrmCache::Get()->Push(Content);
 					Callback(this, Event);
@@ -1759,7 +2218,7 @@ namespace Vitex
 			}
 			bool Connection::BodyInliningRequested()
 			{
-				return !Response.Content.Data.empty() && Response.Content.Data.size() <= INLINING_SIZE;
+				return !Response.Content.Data.empty() && memcmp(Request.Method, "HEAD", 4) != 0;
 			}
 			bool Connection::WaitingForWebSocket()
 			{
@@ -1769,6 +2228,8 @@ namespace Vitex
 					return true;
 				}
 
+				if (WebSocket != nullptr)
+					Root->Unsubscribe(WebSocket);
 				Core::Memory::Release(WebSocket);
 				return false;
 			}
@@ -1795,10 +2256,10 @@ namespace Vitex
 				{
 					if (!Chunk.empty())
 					{
-						Core::String Content = Core::Stringify::Text("%X\r\n", (uint32_t)Chunk.size());
-						Content.append(Chunk);
-						Content.append("\r\n");
-						Stream->WriteQueued((uint8_t*)Content.c_str(), Content.size(), std::bind(Callback, this, std::placeholders::_1));
+						char Length[32];
+						int LengthSize = snprintf(Length, sizeof(Length), "%X\r\n", (uint32_t)Chunk.size());
+						std::string_view Buffers[3] = { std::string_view(Length, (size_t)LengthSize), Chunk, std::string_view("\r\n", 2) };
+						Stream->WriteVectorQueued(Buffers, 3, std::bind(Callback, this, std::placeholders::_1));
 					}
 					else
 						Stream->WriteQueued((uint8_t*)"0\r\n\r\n", 5, std::bind(Callback, this, std::placeholders::_1), false);
@@ -1865,16 +2326,18 @@ namespace Vitex
 					{
 						size_t DecodedSize = Request.Content.Data.size();
 						int64_t Subresult = Resolver->ParseDecodeChunked((uint8_t*)Request.Content.Data.data(), &DecodedSize);
+						if (Subresult > 0)
+							Pipeline.assign(Request.Content.Data.data() + DecodedSize, (size_t)Subresult);
 						Request.Content.Data.resize(DecodedSize);
 						if (!Eat && Callback && !Request.Content.Data.empty())
 							Callback(this, SocketPoll::Next, std::string_view(Request.Content.Data.data(), Request.Content.Data.size()));
 
-						if (Subresult == -1 || Subresult == 0)
+						if (Subresult >= 0 || Subresult == -1)
 						{
 							Request.Content.Finalize();
 							if (Callback)
 								Callback(this, SocketPoll::FinishSync, "");
-							return Subresult == 0;
+							return Subresult >= 0;
 						}
 					}
 					else if (!Eat && Callback)
@@ -1890,6 +2353,8 @@ namespace Vitex
 							int64_t Result = Resolver->ParseDecodeChunked((uint8_t*)Buffer, &Recv);
 							if (Result == -1)
 								return false;
+							else if (Result > 0)
+								Pipeline.assign((char*)Buffer + Recv, (size_t)Result);
 
 							Request.Content.Offset += Recv;
 							if (Eat)
@@ -2164,6 +2629,27 @@ namespace Vitex
 				Response.StatusCode = StatusCode;
 				return Next();
 			}
+			Session* Connection::GetSession()
+			{
+				VI_ASSERT(ConnectionValid(this), "connection should be valid");
+				if (Current != nullptr)
+					return Current;
+				else if (!Route->Router->Session.Store)
+					return nullptr;
+
+				Current = new Session();
+				auto Status = Current->Read(this);
+				if (!Status && Status.Error().error() == std::errc::operation_canceled)
+				{
+					VI_ERR("[http] session not created: %s", Status.Error().what());
+					Core::Memory::Release(Current);
+					return nullptr;
+				}
+				else if (!Status)
+					VI_DEBUG("[http] session %s not loaded: %s", Current->SessionId.c_str(), Status.Error().what());
+
+				return Current;
+			}
 			bool Connection::IsSkipRequired() const
 			{
 				if (!Request.Content.Resources.empty() || Request.Content.IsFinalized() || Request.Content.Exceeds || !Stream->IsValid())
@@ -2180,11 +2666,7 @@ namespace Vitex
 						return Core::String(ProxyAddress);
 				}
 
-				auto Address = Stream->GetPeerAddress();
-				if (!Address)
-					return Address.Error();
-
-				return Address->GetIpAddress();
+				return Address.GetIpAddress();
 			}
 
 			Query::Query() : Object(Core::Var::Set::Object())
@@ -2469,91 +2951,337 @@ namespace Vitex
 				return Base->Set(Key, Core::Var::String(""));
 			}
 
-			Session::Session()
-			{
-				Query = Core::Var::Set::Object();
-			}
-			Session::~Session() noexcept
+			Core::ExpectsSystem<void> SessionStore::Flush()
 			{
-				Core::Memory::Release(Query);
+				return Core::Expectation::Met;
 			}
-			Core::ExpectsSystem<void> Session::Write(Connection* Base)
-			{
-				VI_ASSERT(ConnectionValid(Base), "connection should be valid");
-				auto* Router = Base->Route->Router;
-				Core::String Path = Router->Session.Directory + FindSessionId(Base);
-				auto Stream = Core::OS::File::Open(Path.c_str(), "wb");
-				if (!Stream)
-					return Core::SystemException("session write error", std::move(Stream.Error()));
 
-				SessionExpires = time(nullptr) + Router->Session.Expires;
-				fwrite(&SessionExpires, sizeof(int64_t), 1, *Stream);
-				Query->ConvertToJSONB(Query, [&Stream](Core::VarForm, const std::string_view& Buffer)
-				{
-					if (!Buffer.empty())
-						fwrite(Buffer.data(), Buffer.size(), 1, *Stream);
-				});
-				Core::OS::File::Close(*Stream);
-				return Core::Expectation::Met;
+			FileSessionStore::FileSessionStore(const std::string_view& NewDirectory) noexcept : Directory(NewDirectory)
+			{
 			}
-			Core::ExpectsSystem<void> Session::Read(Connection* Base)
+			Core::ExpectsSystem<void> FileSessionStore::Load(Session* Target)
 			{
-				VI_ASSERT(ConnectionValid(Base), "connection should be valid");
-				Core::String Path = Base->Route->Router->Session.Directory + FindSessionId(Base);
+				VI_ASSERT(Target != nullptr, "session should be set");
+				Core::String Path = Directory + Target->SessionId;
 				auto Stream = Core::OS::File::Open(Path.c_str(), "rb");
 				if (!Stream)
 					return Core::SystemException("session read error", std::move(Stream.Error()));
 
-				if (fread(&SessionExpires, 1, sizeof(int64_t), *Stream) != sizeof(int64_t))
+				int64_t Expires = 0;
+				if (fread(&Expires, 1, sizeof(int64_t), *Stream) != sizeof(int64_t))
 				{
 					Core::OS::File::Close(*Stream);
 					return Core::SystemException("session read error: invalid format", std::make_error_condition(std::errc::bad_message));
 				}
 
-				if (SessionExpires <= time(nullptr))
+				if (Expires <= time(nullptr))
 				{
-					SessionId.clear();
+					Target->SessionId.clear();
 					Core::OS::File::Close(*Stream);
 					Core::OS::File::Remove(Path.c_str());
 					return Core::SystemException("session read error: expired", std::make_error_condition(std::errc::timed_out));
 				}
 
-				Core::Memory::Release(Query);
 				auto Result = Core::Schema::ConvertFromJSONB([&Stream](uint8_t* Buffer, size_t Size) { return fread(Buffer, sizeof(uint8_t), Size, *Stream) == Size; });
 				Core::OS::File::Close(*Stream);
 				if (!Result)
 					return Core::SystemException(Result.Error().message(), std::make_error_condition(std::errc::bad_message));
 
-				Query = *Result;
+				Core::Memory::Release(Target->Query);
+				Target->Query = *Result;
+				Target->SessionExpires = Expires;
 				return Core::Expectation::Met;
 			}
-			void Session::Clear()
+			Core::ExpectsSystem<void> FileSessionStore::Store(Session* Target)
 			{
-				if (Query != nullptr)
-					Query->Clear();
+				VI_ASSERT(Target != nullptr, "session should be set");
+				Core::String Path = Directory + Target->SessionId;
+				auto Stream = Core::OS::File::Open(Path.c_str(), "wb");
+				if (!Stream)
+					return Core::SystemException("session write error", std::move(Stream.Error()));
+
+				fwrite(&Target->SessionExpires, sizeof(int64_t), 1, *Stream);
+				Target->Query->ConvertToJSONB(Target->Query, [&Stream](Core::VarForm, const std::string_view& Buffer)
+				{
+					if (!Buffer.empty())
+						fwrite(Buffer.data(), Buffer.size(), 1, *Stream);
+				});
+				Core::OS::File::Close(*Stream);
+				return Core::Expectation::Met;
 			}
-			Core::String& Session::FindSessionId(Connection* Base)
+			Core::ExpectsSystem<void> FileSessionStore::Remove(const std::string_view& SessionId)
 			{
-				if (!SessionId.empty())
-					return SessionId;
+				Core::String Path = Directory + Core::String(SessionId);
+				auto Status = Core::OS::File::Remove(Path.c_str());
+				if (!Status)
+					return Core::SystemException("session remove error", std::move(Status.Error()));
+
+				return Core::Expectation::Met;
+			}
+			const Core::String& FileSessionStore::GetDirectory() const
+			{
+				return Directory;
+			}
+
+			MemorySessionStore::MemorySessionStore(size_t MaxEntries, size_t MaxShards, SessionStore* NewBacking) noexcept : Backing(NewBacking)
+			{
+				MaxShards = std::max<size_t>(1, MaxShards);
+				Capacity = std::max<size_t>(1, MaxEntries / MaxShards);
+				Shards.reserve(MaxShards);
+				for (size_t i = 0; i < MaxShards; i++)
+					Shards.push_back(Core::Memory::New<Shard>());
+			}
+			MemorySessionStore::~MemorySessionStore() noexcept
+			{
+				Flush();
+				for (auto* Target : Shards)
+				{
+					for (auto& Item : Target->Entries)
+						Core::Memory::Release(Item.Data);
+					Core::Memory::Delete(Target);
+				}
+				Shards.clear();
+				Core::Memory::Release(Backing);
+			}
+			Core::ExpectsSystem<void> MemorySessionStore::Load(Session* Target)
+			{
+				VI_ASSERT(Target != nullptr, "session should be set");
+				auto* Base = GetShard(Target->SessionId);
+				Core::UMutex<std::mutex> Unique(Base->Exclusive);
+				auto It = Base->Index.find(Target->SessionId);
+				if (It != Base->Index.end())
+				{
+					auto Item = It->second;
+					if (Item->Data->SessionExpires > time(nullptr))
+					{
+						Base->Entries.splice(Base->Entries.begin(), Base->Entries, Item);
+						Core::Memory::Release(Target->Query);
+						Target->Query = Item->Data->Query->Copy();
+						Target->SessionExpires = Item->Data->SessionExpires;
+						return Core::Expectation::Met;
+					}
+
+					Core::Memory::Release(Item->Data);
+					Base->Entries.erase(Item);
+					Base->Index.erase(It);
+					Target->SessionId.clear();
+					return Core::SystemException("session read error: expired", std::make_error_condition(std::errc::timed_out));
+				}
+
+				Unique.Negate();
+				if (!Backing)
+					return Core::SystemException("session read error: not found", std::make_error_condition(std::errc::no_such_file_or_directory));
+
+				auto Status = Backing->Load(Target);
+				if (!Status)
+					return Status;
+
+				Entry Item;
+				Item.Data = new Session();
+				Item.Data->SessionId = Target->SessionId;
+				Item.Data->SessionExpires = Target->SessionExpires;
+				Core::Memory::Release(Item.Data->Query);
+				Item.Data->Query = Target->Query->Copy();
+
+				Core::Vector<Entry> Expired;
+				Unique.Negate();
+				auto Next = Base->Index.find(Target->SessionId);
+				if (Next == Base->Index.end())
+				{
+					Base->Entries.emplace_front(std::move(Item));
+					Base->Index[Target->SessionId] = Base->Entries.begin();
+					Evict(Base, time(nullptr), Expired);
+				}
+				else
+					Core::Memory::Release(Item.Data);
+				Unique.Negate();
+
+				for (auto& Next : Expired)
+				{
+					if (Next.Dirty && Backing != nullptr)
+						Backing->Store(Next.Data);
+					Core::Memory::Release(Next.Data);
+				}
+				return Core::Expectation::Met;
+			}
+			Core::ExpectsSystem<void> MemorySessionStore::Store(Session* Target)
+			{
+				VI_ASSERT(Target != nullptr, "session should be set");
+				VI_ASSERT(Target->Query != nullptr, "session data should be set");
+				auto* Copy = Target->Query->Copy();
+				auto* Base = GetShard(Target->SessionId);
+				Core::Vector<Entry> Expired;
+				Core::UMutex<std::mutex> Unique(Base->Exclusive);
+				auto It = Base->Index.find(Target->SessionId);
+				if (It == Base->Index.end())
+				{
+					Entry Item;
+					Item.Data = new Session();
+					Item.Data->SessionId = Target->SessionId;
+					Base->Entries.emplace_front(std::move(Item));
+					It = Base->Index.insert(std::make_pair(Target->SessionId, Base->Entries.begin())).first;
+				}
+				else
+					Base->Entries.splice(Base->Entries.begin(), Base->Entries, It->second);
+
+				auto& Item = *It->second;
+				Core::Memory::Release(Item.Data->Query);
+				Item.Data->Query = Copy;
+				Item.Data->SessionExpires = Target->SessionExpires;
+				Item.Dirty = true;
+				Evict(Base, time(nullptr), Expired);
+				Unique.Negate();
+
+				for (auto& Next : Expired)
+				{
+					if (Next.Dirty && Backing != nullptr)
+						Backing->Store(Next.Data);
+					Core::Memory::Release(Next.Data);
+				}
+				return Core::Expectation::Met;
+			}
+			Core::ExpectsSystem<void> MemorySessionStore::Remove(const std::string_view& SessionId)
+			{
+				auto* Base = GetShard(SessionId);
+				Core::UMutex<std::mutex> Unique(Base->Exclusive);
+				auto It = Base->Index.find(Core::String(SessionId));
+				if (It != Base->Index.end())
+				{
+					Core::Memory::Release(It->second->Data);
+					Base->Entries.erase(It->second);
+					Base->Index.erase(It);
+				}
+
+				Unique.Negate();
+				return Backing ? Backing->Remove(SessionId) : Core::Expectation::Met;
+			}
+			Core::ExpectsSystem<void> MemorySessionStore::Flush()
+			{
+				if (!Backing)
+					return Core::Expectation::Met;
+
+				Core::Vector<Session*> Dirty;
+				for (auto* Base : Shards)
+				{
+					Core::UMutex<std::mutex> Unique(Base->Exclusive);
+					for (auto& Item : Base->Entries)
+					{
+						if (!Item.Dirty)
+							continue;
+
+						Item.Data->AddRef();
+						Item.Dirty = false;
+						Dirty.push_back(Item.Data);
+					}
+				}
+
+				Core::ExpectsSystem<void> Result = Core::Expectation::Met;
+				for (auto* Item : Dirty)
+				{
+					auto Status = Backing->Store(Item);
+					if (!Status && Result)
+						Result = std::move(Status);
+					Core::Memory::Release(Item);
+				}
+				return Result;
+			}
+			SessionStore* MemorySessionStore::GetBacking()
+			{
+				return Backing;
+			}
+			size_t MemorySessionStore::GetSize()
+			{
+				size_t Size = 0;
+				for (auto* Base : Shards)
+				{
+					Core::UMutex<std::mutex> Unique(Base->Exclusive);
+					Size += Base->Entries.size();
+				}
+				return Size;
+			}
+			MemorySessionStore::Shard* MemorySessionStore::GetShard(const std::string_view& SessionId)
+			{
+				return Shards[std::hash<std::string_view>()(SessionId) % Shards.size()];
+			}
+			void MemorySessionStore::Evict(Shard* Target, int64_t Time, Core::Vector<Entry>& Expired)
+			{
+				while (!Target->Entries.empty())
+				{
+					auto& Item = Target->Entries.back();
+					if (Target->Entries.size() <= Capacity && Item.Data->SessionExpires > Time)
+						break;
+
+					if (Item.Data->SessionExpires <= Time)
+						Item.Dirty = false;
+
+					Target->Index.erase(Item.Data->SessionId);
+					Expired.push_back(Item);
+					Target->Entries.pop_back();
+				}
+			}
+
+			Session::Session()
+			{
+				Query = Core::Var::Set::Object();
+			}
+			Session::~Session() noexcept
+			{
+				Core::Memory::Release(Query);
+			}
+			Core::ExpectsSystem<void> Session::Write(Connection* Base)
+			{
+				VI_ASSERT(ConnectionValid(Base), "connection should be valid");
+				auto* Router = Base->Route->Router;
+				if (!Router->Session.Store)
+					return Core::SystemException("session write error: no session store", std::make_error_condition(std::errc::not_supported));
+
+				auto Status = FindSessionId(Base);
+				if (!Status)
+					return Status;
+
+				SessionExpires = time(nullptr) + Router->Session.Expires;
+				return Router->Session.Store->Store(this);
+			}
+			Core::ExpectsSystem<void> Session::Read(Connection* Base)
+			{
+				VI_ASSERT(ConnectionValid(Base), "connection should be valid");
+				auto* Router = Base->Route->Router;
+				if (!Router->Session.Store)
+					return Core::SystemException("session read error: no session store", std::make_error_condition(std::errc::not_supported));
+
+				auto Status = FindSessionId(Base);
+				if (!Status)
+					return Status;
+
+				return Router->Session.Store->Load(this);
+			}
+			void Session::Clear()
+			{
+				if (Query != nullptr)
+					Query->Clear();
+			}
+			Core::ExpectsSystem<void> Session::FindSessionId(Connection* Base)
+			{
+				if (!SessionId.empty())
+					return Core::Expectation::Met;
 
 				VI_ASSERT(ConnectionValid(Base), "connection should be valid");
 				auto Value = Base->Request.GetCookie(Base->Route->Router->Session.Cookie.Name.c_str());
-				if (Value.empty())
+				if (Value.empty() || Value.size() > 128 || !std::all_of(Value.begin(), Value.end(), [](char V) { return Core::Stringify::IsAlphanum(V); }))
 					return GenerateSessionId(Base);
 
-				return SessionId.assign(Value);
+				SessionId.assign(Value);
+				return Core::Expectation::Met;
 			}
-			Core::String& Session::GenerateSessionId(Connection* Base)
+			Core::ExpectsSystem<void> Session::GenerateSessionId(Connection* Base)
 			{
 				VI_ASSERT(ConnectionValid(Base), "connection should be valid");
-				int64_t Time = time(nullptr);
-				auto Hash = Compute::Crypto::HashHex(Compute::Digests::MD5(), Base->Request.Location + Core::ToString(Time));
-				if (Hash)
-					SessionId = *Hash;
-				else
-					SessionId = Core::ToString(Time);
+				auto Random = Compute::Crypto::RandomBytes(24);
+				if (!Random)
+					return Core::SystemException("session id error: " + Random.Error().message(), std::make_error_condition(std::errc::operation_canceled));
 
+				int64_t Time = time(nullptr);
+				SessionId = Compute::Codec::HexEncode(*Random);
 				auto* Router = Base->Route->Router;
 				if (SessionExpires == 0)
 					SessionExpires = Time + Router->Session.Expires;
@@ -2568,8 +3296,7 @@ namespace Vitex
 				Result.HttpOnly = Router->Session.Cookie.HttpOnly;
 				Result.SetExpires(Time + (int64_t)Router->Session.Cookie.Expires);
 				Base->Response.SetCookie(std::move(Result));
-
-				return SessionId;
+				return Core::Expectation::Met;
 			}
 			Core::ExpectsSystem<void> Session::InvalidateCache(const std::string_view& Path)
 			{
@@ -3048,6 +3775,7 @@ namespace Vitex
 				VI_ASSERT(Out != nullptr, "output should be set");
 
 				const uint8_t* TokenStart = Buffer;
+				Buffer = SkipHeaderValue(Buffer, BufferEnd);
 				while (BufferEnd - Buffer >= 8)
 				{
 					for (int i = 0; i < 8; i++)
@@ -3122,6 +3850,9 @@ namespace Vitex
 
 				while (true)
 				{
+					if (!Result)
+						Buffer = SkipLine(Buffer, BufferEnd);
+
 					if (Buffer == BufferEnd)
 					{
 						*Out = -2;
@@ -3204,12 +3935,13 @@ namespace Vitex
 					return nullptr;
 				}
 
-				if (*(Buffer++) != '1')
+				if (*Buffer != '1' && *Buffer != '2')
 				{
 					*Out = -1;
 					return nullptr;
 				}
 
+				Buffer++;
 				if (*(Buffer++) != '.')
 				{
 					*Out = -1;
@@ -3248,9 +3980,9 @@ namespace Vitex
 					"\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0";
 
 				if (Message.Headers != nullptr)
-					Message.Headers->clear();
+					CleanupHashMap(*Message.Headers);
 				if (Message.Cookies != nullptr)
-					Message.Cookies->clear();
+					CleanupHashMap(*Message.Cookies);
 
 				while (true)
 				{
@@ -3286,6 +4018,13 @@ namespace Vitex
 					if (!(*Buffer == ' ' || *Buffer == '\t'))
 					{
 						const uint8_t* Name = Buffer;
+						Buffer = SkipHeaderName(Buffer, BufferEnd);
+						if (Buffer == BufferEnd)
+						{
+							*Out = -2;
+							return nullptr;
+						}
+
 						while (true)
 						{
 							if (*Buffer == ':')
@@ -3441,6 +4180,7 @@ namespace Vitex
 				} while (*Buffer == ' ');
 
 				TokenStart = Buffer;
+				Buffer = SkipRequestToken(Buffer, BufferEnd);
 				if (Buffer == BufferEnd)
 				{
 					*Out = -2;
@@ -3609,140 +4349,452 @@ namespace Vitex
 				return ProcessHeaders(Buffer, BufferEnd, Out);
 			}
 
-			WebCodec::WebCodec() : State(Bytecode::Begin), Fragment(0)
-			{
-			}
-			bool WebCodec::ParseFrame(const uint8_t* Buffer, size_t Size)
+			static void UnmaskPayload(char* Data, size_t Length, const uint8_t Mask[4], uint8_t* Offset)
 			{
-				if (!Buffer || !Size)
-					return !Queue.empty();
+				uint8_t Index = *Offset;
+				size_t i = 0;
+				while (i < Length && ((uintptr_t)(Data + i) & 7) != 0)
+					Data[i++] ^= Mask[Index++ % 4];
 
-				if (Payload.capacity() <= Size)
-					Payload.resize(Size);
+				uint8_t Key[8];
+				for (size_t j = 0; j < sizeof(Key); j++)
+					Key[j] = Mask[(Index + j) % 4];
 
-				memcpy(Payload.data(), Buffer, sizeof(char) * Size);
-				char* Data = Payload.data();
-			ParsePayload:
-				while (Size)
+				uint64_t Key64;
+				memcpy(&Key64, Key, sizeof(Key64));
+#ifdef HTTP_AVX2
+				__m256i Key256 = _mm256_set1_epi64x((long long)Key64);
+				for (; i + 32 <= Length; i += 32)
 				{
-					uint8_t Index = *Data;
-					switch (State)
-					{
-						case Bytecode::Begin:
-						{
-							uint8_t Op = Index & 0x0f;
-							if (Index & 0x70)
-								return !Queue.empty();
-
-							Final = (Index & 0x80) ? 1 : 0;
-							if (Op == 0)
-							{
-								if (!Fragment)
-									return !Queue.empty();
-
-								Control = 0;
-							}
-							else if (Op & 0x8)
-							{
-								if (Op != (uint8_t)WebSocketOp::Ping && Op != (uint8_t)WebSocketOp::Pong && Op != (uint8_t)WebSocketOp::Close)
-									return !Queue.empty();
-
-								if (!Final)
-									return !Queue.empty();
+					__m256i Value = _mm256_loadu_si256((const __m256i*)(Data + i));
+					_mm256_storeu_si256((__m256i*)(Data + i), _mm256_xor_si256(Value, Key256));
+				}
+#endif
+				for (; i + 8 <= Length; i += 8)
+				{
+					uint64_t Value;
+					memcpy(&Value, Data + i, sizeof(Value));
+					Value ^= Key64;
+					memcpy(Data + i, &Value, sizeof(Value));
+				}
 
-								Control = 1;
-								Opcode = (WebSocketOp)Op;
-							}
-							else
-							{
-								if (Op != (uint8_t)WebSocketOp::Text && Op != (uint8_t)WebSocketOp::Binary)
-									return !Queue.empty();
+				while (i < Length)
+					Data[i++] ^= Mask[Index++ % 4];
+				*Offset = Index;
+			}
 
-								Control = 0;
-								Fragment = !Final;
-								Opcode = (WebSocketOp)Op;
-							}
+			static bool NegotiateDeflate(const std::string_view& Extensions, const WebSocketDeflate& Policy, bool IsServer, WebSocketDeflate* Result, Core::String* Response)
+			{
+				for (auto& Offer : Core::Stringify::Split(Extensions, ','))
+				{
+					auto Parameters = Core::Stringify::Split(Offer, ';');
+					if (Parameters.empty() || Core::Stringify::Trim(Parameters.front()) != "permessage-deflate")
+						continue;
 
-							State = Bytecode::Length;
-							Data++; Size--;
-							break;
-						}
-						case Bytecode::Length:
+					WebSocketDeflate Next = Policy;
+					bool LocalWindowBits = false, RemoteWindowBits = false, Valid = true;
+					Next.LocalWindowBits = Compute::Math32::Clamp(Policy.LocalWindowBits, 9, 15);
+					Next.RemoteWindowBits = 15;
+					for (size_t i = 1; i < Parameters.size() && Valid; i++)
+					{
+						auto& Parameter = Core::Stringify::Trim(Parameters[i]);
+						size_t Offset = Parameter.find('=');
+						Core::String Name = Parameter.substr(0, Offset), Value = (Offset != std::string::npos ? Parameter.substr(Offset + 1) : Core::String());
+						Core::Stringify::Trim(Name);
+						Core::Stringify::Trim(Value);
+						if (Value.size() >= 2 && Value.front() == '"' && Value.back() == '"')
+							Value = Value.substr(1, Value.size() - 2);
+
+						int Bits = 0;
+						if (!Value.empty())
 						{
-							uint8_t Length = Index & 0x7f;
-							Masked = (Index & 0x80) ? 1 : 0;
-							Masks = 0;
-
-							if (Control)
-							{
-								if (Length > 125)
-									return !Queue.empty();
-
-								Remains = Length;
-								State = Masked ? Bytecode::Mask_0 : Bytecode::End;
-							}
-							else if (Length < 126)
-							{
-								Remains = Length;
-								State = Masked ? Bytecode::Mask_0 : Bytecode::End;
-							}
-							else if (Length == 126)
-								State = Bytecode::Length_16_0;
-							else
-								State = Bytecode::Length_64_0;
-
-							Data++; Size--;
-							if (State == Bytecode::End && Remains == 0)
+							auto Number = Core::FromString<int>(Value);
+							if (!Number || *Number < 8 || *Number > 15)
 							{
-								Queue.emplace(std::make_pair(Opcode, Core::Vector<char>()));
-								goto FetchPayload;
+								Valid = false;
+								break;
 							}
-							break;
-						}
-						case Bytecode::Length_16_0:
-						{
-							Remains = (uint64_t)Index << 8;
-							State = Bytecode::Length_16_1;
-							Data++; Size--;
-							break;
+							Bits = *Number;
 						}
-						case Bytecode::Length_16_1:
-						{
-							Remains |= (uint64_t)Index << 0;
-							State = Masked ? Bytecode::Mask_0 : Bytecode::End;
-							if (Remains < 126)
-								return !Queue.empty();
 
-							Data++; Size--;
-							break;
-						}
-						case Bytecode::Length_64_0:
+						if (Name == "server_no_context_takeover" && Value.empty())
 						{
-							Remains = (uint64_t)Index << 56;
-							State = Bytecode::Length_64_1;
-							Data++; Size--;
-							break;
+							if (IsServer)
+								Next.LocalContextTakeover = false;
+							else
+								Next.RemoteContextTakeover = false;
 						}
-						case Bytecode::Length_64_1:
+						else if (Name == "client_no_context_takeover" && Value.empty())
 						{
-							Remains |= (uint64_t)Index << 48;
-							State = Bytecode::Length_64_2;
-							Data++; Size--;
-							break;
+							if (IsServer)
+								Next.RemoteContextTakeover = false;
+							else
+								Next.LocalContextTakeover = false;
 						}
-						case Bytecode::Length_64_2:
+						else if (Name == "server_max_window_bits" && Bits > 0)
 						{
-							Remains |= (uint64_t)Index << 40;
-							State = Bytecode::Length_64_3;
-							Data++; Size--;
-							break;
+							if (IsServer)
+							{
+								LocalWindowBits = true;
+								Next.LocalWindowBits = std::min(Next.LocalWindowBits, Bits);
+							}
+							else
+								Next.RemoteWindowBits = Bits;
 						}
-						case Bytecode::Length_64_3:
+						else if (Name == "client_max_window_bits" && (IsServer || Bits > 0))
 						{
-							Remains |= (uint64_t)Index << 32;
-							State = Bytecode::Length_64_4;
-							Data++; Size--;
-							break;
+							if (IsServer)
+							{
+								RemoteWindowBits = true;
+								Next.RemoteWindowBits = std::min(Bits > 0 ? Bits : 15, Compute::Math32::Clamp(Policy.RemoteWindowBits, 9, 15));
+							}
+							else
+								Next.LocalWindowBits = std::min(Next.LocalWindowBits, Bits);
+						}
+						else
+							Valid = false;
+					}
+
+					if (!Valid || Next.LocalWindowBits < 9)
+					{
+						if (IsServer)
+							continue;
+
+						return false;
+					}
+
+					if (Response != nullptr)
+					{
+						Response->assign("permessage-deflate");
+						if (!Next.LocalContextTakeover)
+							Response->append("; server_no_context_takeover");
+						if (!Next.RemoteContextTakeover)
+							Response->append("; client_no_context_takeover");
+						if (LocalWindowBits && Next.LocalWindowBits < 15)
+							Response->append("; server_max_window_bits=").append(Core::ToString(Next.LocalWindowBits));
+						if (RemoteWindowBits && Next.RemoteWindowBits < 15)
+							Response->append("; client_max_window_bits=").append(Core::ToString(Next.RemoteWindowBits));
+					}
+
+					*Result = Next;
+					return true;
+				}
+
+				return false;
+			}
+			static Core::String OfferDeflate(const WebSocketDeflate& Policy)
+			{
+				Core::String Offer = "permessage-deflate; client_max_window_bits";
+				int LocalWindowBits = Compute::Math32::Clamp(Policy.LocalWindowBits, 9, 15);
+				if (LocalWindowBits < 15)
+					Offer.append("=").append(Core::ToString(LocalWindowBits));
+
+				int RemoteWindowBits = Compute::Math32::Clamp(Policy.RemoteWindowBits, 8, 15);
+				if (RemoteWindowBits < 15)
+					Offer.append("; server_max_window_bits=").append(Core::ToString(RemoteWindowBits));
+				if (!Policy.RemoteContextTakeover)
+					Offer.append("; server_no_context_takeover");
+				if (!Policy.LocalContextTakeover)
+					Offer.append("; client_no_context_takeover");
+
+				return Offer;
+			}
+
+			struct DeflateContext
+			{
+				WebSocketDeflate Options;
+#ifdef VI_ZLIB
+				z_stream Deflater;
+				z_stream Inflater;
+#endif
+				WebSocketOp Opcode = WebSocketOp::Text;
+			};
+
+			WebCodec::WebCodec() : PayloadBase(0), PayloadDone(0), InflatedBase(0), InflatedDone(0), State(Bytecode::Begin), Fragment(0), Compression(0), Deflate(nullptr)
+			{
+			}
+			WebCodec::~WebCodec() noexcept
+			{
+				if (!Deflate)
+					return;
+#ifdef VI_ZLIB
+				deflateEnd(&Deflate->Deflater);
+				inflateEnd(&Deflate->Inflater);
+#endif
+				Core::Memory::Delete(Deflate);
+			}
+			bool WebCodec::SetDeflate(const WebSocketDeflate& Options)
+			{
+#ifdef VI_ZLIB
+				if (Deflate != nullptr)
+					return false;
+
+				DeflateContext* Context = Core::Memory::New<DeflateContext>();
+				Context->Options = Options;
+				Context->Options.LocalWindowBits = Compute::Math32::Clamp(Options.LocalWindowBits, 9, 15);
+				Context->Options.RemoteWindowBits = Compute::Math32::Clamp(Options.RemoteWindowBits, 8, 15);
+				Context->Options.QualityLevel = Compute::Math32::Clamp(Options.QualityLevel, 0, 9);
+				Context->Options.MemoryLevel = Compute::Math32::Clamp(Options.MemoryLevel, 1, 9);
+				memset(&Context->Deflater, 0, sizeof(Context->Deflater));
+				memset(&Context->Inflater, 0, sizeof(Context->Inflater));
+				if (deflateInit2(&Context->Deflater, Context->Options.QualityLevel, Z_DEFLATED, -Context->Options.LocalWindowBits, Context->Options.MemoryLevel, Z_DEFAULT_STRATEGY) != Z_OK)
+				{
+					Core::Memory::Delete(Context);
+					return false;
+				}
+
+				if (inflateInit2(&Context->Inflater, -Context->Options.RemoteWindowBits) != Z_OK)
+				{
+					deflateEnd(&Context->Deflater);
+					Core::Memory::Delete(Context);
+					return false;
+				}
+
+				Deflate = Context;
+				return true;
+#else
+				return false;
+#endif
+			}
+			bool WebCodec::Compress(const std::string_view& Buffer, Core::String& Output)
+			{
+#ifdef VI_ZLIB
+				if (!Deflate || Buffer.empty())
+					return false;
+
+				z_stream& Stream = Deflate->Deflater;
+				Stream.next_in = (Bytef*)Buffer.data();
+				Stream.avail_in = (uInt)Buffer.size();
+				Output.resize((size_t)deflateBound(&Stream, (uLong)Buffer.size()) + 8);
+
+				size_t Offset = 0;
+				while (true)
+				{
+					Stream.next_out = (Bytef*)Output.data() + Offset;
+					Stream.avail_out = (uInt)(Output.size() - Offset);
+					int Status = deflate(&Stream, Z_SYNC_FLUSH);
+					Offset = Output.size() - Stream.avail_out;
+					if (Status != Z_OK && Status != Z_BUF_ERROR)
+					{
+						deflateReset(&Stream);
+						Output.clear();
+						return false;
+					}
+					else if (Stream.avail_out > 0)
+						break;
+
+					Output.resize(Output.size() * 2);
+				}
+
+				Output.resize(Offset);
+				if (Output.size() >= 4 && !memcmp(Output.data() + Output.size() - 4, "\x00\x00\xff\xff", 4))
+					Output.resize(Output.size() - 4);
+
+				if (!Deflate->Options.LocalContextTakeover)
+					deflateReset(&Stream);
+
+				return true;
+#else
+				return false;
+#endif
+			}
+			bool WebCodec::Decompress()
+			{
+#ifdef VI_ZLIB
+				static const char Trailer[] = { '\x00', '\x00', '\xff', '\xff' };
+				Compressed.insert(Compressed.end(), Trailer, Trailer + sizeof(Trailer));
+
+				z_stream& Stream = Deflate->Inflater;
+				Stream.next_in = (Bytef*)Compressed.data();
+				Stream.avail_in = (uInt)Compressed.size();
+
+				size_t Offset = Inflated.size(), Size = Offset;
+				size_t Limit = Offset + Deflate->Options.MaxMessageSize;
+				bool Success = true;
+				while (true)
+				{
+					if (Size >= Limit)
+					{
+						Success = false;
+						break;
+					}
+
+					Inflated.resize(std::min(Limit, Size + std::max<size_t>(Compressed.size() * 4, 1024)));
+					Stream.next_out = (Bytef*)Inflated.data() + Size;
+					Stream.avail_out = (uInt)(Inflated.size() - Size);
+					int Status = inflate(&Stream, Z_SYNC_FLUSH);
+					Size = Inflated.size() - Stream.avail_out;
+					if (Status == Z_STREAM_END)
+					{
+						inflateReset(&Stream);
+						break;
+					}
+					else if (Status != Z_OK && Status != Z_BUF_ERROR)
+					{
+						Success = false;
+						break;
+					}
+					else if (Stream.avail_out > 0)
+						break;
+				}
+
+				Compressed.clear();
+				if (!Success)
+				{
+					inflateReset(&Stream);
+					Inflated.resize(Offset);
+					return false;
+				}
+
+				if (!Deflate->Options.RemoteContextTakeover)
+					inflateReset(&Stream);
+
+				Inflated.resize(Size);
+				Queue.emplace(FrameView { Deflate->Opcode, InflatedBase + Offset, Size - Offset, true });
+				return true;
+#else
+				return false;
+#endif
+			}
+			bool WebCodec::ParseFrame(const uint8_t* Buffer, size_t Size)
+			{
+				if (!Buffer || !Size)
+					return !Queue.empty();
+
+				Compact();
+				size_t Offset = Payload.size();
+				Payload.insert(Payload.end(), (char*)Buffer, (char*)Buffer + Size);
+				char* Data = Payload.data() + Offset;
+			ParsePayload:
+				while (Size)
+				{
+					uint8_t Index = *Data;
+					switch (State)
+					{
+						case Bytecode::Begin:
+						{
+							uint8_t Op = Index & 0x0f;
+							if (Index & 0x30)
+								return !Queue.empty();
+
+							if ((Index & 0x40) && (!Deflate || Op == 0 || (Op & 0x8)))
+								return !Queue.empty();
+
+							Final = (Index & 0x80) ? 1 : 0;
+							if (Op == 0)
+							{
+								if (!Fragment)
+									return !Queue.empty();
+
+								Control = 0;
+							}
+							else if (Op & 0x8)
+							{
+								if (Op != (uint8_t)WebSocketOp::Ping && Op != (uint8_t)WebSocketOp::Pong && Op != (uint8_t)WebSocketOp::Close)
+									return !Queue.empty();
+
+								if (!Final)
+									return !Queue.empty();
+
+								Control = 1;
+								Opcode = (WebSocketOp)Op;
+							}
+							else
+							{
+								if (Op != (uint8_t)WebSocketOp::Text && Op != (uint8_t)WebSocketOp::Binary)
+									return !Queue.empty();
+
+								Control = 0;
+								Fragment = !Final;
+								Opcode = (WebSocketOp)Op;
+								Compression = (Index & 0x40) ? 1 : 0;
+								if (Compression)
+									Deflate->Opcode = Opcode;
+							}
+
+							State = Bytecode::Length;
+							Data++; Size--;
+							break;
+						}
+						case Bytecode::Length:
+						{
+							uint8_t Length = Index & 0x7f;
+							Masked = (Index & 0x80) ? 1 : 0;
+							Masks = 0;
+
+							if (Control)
+							{
+								if (Length > 125)
+									return !Queue.empty();
+
+								Remains = Length;
+								State = Masked ? Bytecode::Mask_0 : Bytecode::End;
+							}
+							else if (Length < 126)
+							{
+								Remains = Length;
+								State = Masked ? Bytecode::Mask_0 : Bytecode::End;
+							}
+							else if (Length == 126)
+								State = Bytecode::Length_16_0;
+							else
+								State = Bytecode::Length_64_0;
+
+							Data++; Size--;
+							if (State == Bytecode::End && Remains == 0)
+							{
+								if (Control || !Compression)
+									Queue.emplace(FrameView { Opcode, 0, 0, false });
+								else if (Final && !Decompress())
+									goto AbortPayload;
+								goto FetchPayload;
+							}
+							break;
+						}
+						case Bytecode::Length_16_0:
+						{
+							Remains = (uint64_t)Index << 8;
+							State = Bytecode::Length_16_1;
+							Data++; Size--;
+							break;
+						}
+						case Bytecode::Length_16_1:
+						{
+							Remains |= (uint64_t)Index << 0;
+							State = Masked ? Bytecode::Mask_0 : Bytecode::End;
+							if (Remains < 126)
+								return !Queue.empty();
+
+							Data++; Size--;
+							break;
+						}
+						case Bytecode::Length_64_0:
+						{
+							Remains = (uint64_t)Index << 56;
+							State = Bytecode::Length_64_1;
+							Data++; Size--;
+							break;
+						}
+						case Bytecode::Length_64_1:
+						{
+							Remains |= (uint64_t)Index << 48;
+							State = Bytecode::Length_64_2;
+							Data++; Size--;
+							break;
+						}
+						case Bytecode::Length_64_2:
+						{
+							Remains |= (uint64_t)Index << 40;
+							State = Bytecode::Length_64_3;
+							Data++; Size--;
+							break;
+						}
+						case Bytecode::Length_64_3:
+						{
+							Remains |= (uint64_t)Index << 32;
+							State = Bytecode::Length_64_4;
+							Data++; Size--;
+							break;
 						}
 						case Bytecode::Length_64_4:
 						{
@@ -3803,7 +4855,10 @@ namespace Vitex
 							Data++; Size--;
 							if (Remains == 0)
 							{
-								Queue.emplace(std::make_pair(Opcode, Core::Vector<char>()));
+								if (Control || !Compression)
+									Queue.emplace(FrameView { Opcode, 0, 0, false });
+								else if (Final && !Decompress())
+									goto AbortPayload;
 								goto FetchPayload;
 							}
 							break;
@@ -3815,21 +4870,27 @@ namespace Vitex
 								Length = (size_t)Remains;
 
 							if (Masked)
+								UnmaskPayload(Data, Length, Mask, &Masks);
+
+							if (Control || !Compression)
 							{
-								for (size_t i = 0; i < Length; i++)
-									Data[i] ^= Mask[Masks++ % 4];
+								Queue.emplace(FrameView { Opcode, PayloadBase + (size_t)(Data - Payload.data()), Length, false });
+								Opcode = WebSocketOp::Continue;
 							}
-
-							Core::Vector<char> Message;
-							TextAssign(Message, std::string_view(Data, Length));
-							Queue.emplace(std::make_pair(Opcode, std::move(Message)));
-							Opcode = WebSocketOp::Continue;
+							else if (Compressed.size() + Length <= Deflate->Options.MaxMessageSize)
+								Compressed.insert(Compressed.end(), Data, Data + Length);
+							else
+								goto AbortPayload;
 
 							Data += Length;
 							Size -= Length;
 							Remains -= Length;
 							if (Remains == 0)
+							{
+								if (!Control && Compression && Final && !Decompress())
+									goto AbortPayload;
 								goto FetchPayload;
+							}
 							break;
 						}
 					}
@@ -3837,13 +4898,16 @@ namespace Vitex
 
 				return !Queue.empty();
 			FetchPayload:
-				if (!Control && !Final)
-					return !Queue.empty();
-
 				State = Bytecode::Begin;
 				if (Size > 0)
 					goto ParsePayload;
 
+				return !Queue.empty();
+			AbortPayload:
+				Compressed.clear();
+				Compression = 0;
+				State = Bytecode::Begin;
+				Queue.emplace(FrameView { WebSocketOp::Close, 0, 0, false });
 				return true;
 			}
 			bool WebCodec::GetFrame(WebSocketOp* Op, Core::Vector<char>* Message)
@@ -3854,30 +4918,88 @@ namespace Vitex
 				if (Queue.empty())
 					return false;
 
-				auto& Base = Queue.front();
-				*Message = std::move(Base.second);
-				*Op = Base.first;
-				Queue.pop();
+				std::string_view Frame;
+				if (!GetFrame(Op, &Frame))
+					return false;
 
+				Message->assign(Frame.data(), Frame.data() + Frame.size());
 				return true;
 			}
-
-			HrmCache::HrmCache() noexcept : HrmCache(HTTP_HRM_SIZE)
-			{
-			}
-			HrmCache::HrmCache(size_t MaxBytesStorage) noexcept : Capacity(MaxBytesStorage), Size(0)
-			{
-			}
-			HrmCache::~HrmCache() noexcept
+			bool WebCodec::GetFrame(WebSocketOp* Op, std::string_view* Message)
 			{
-				Size = Capacity = 0;
-				while (!Queue.empty())
-				{
-					auto* Item = Queue.front();
-					Core::Memory::Delete(Item);
-					Queue.pop();
-				}
-			}
+				VI_ASSERT(Op != nullptr, "op should be set");
+				VI_ASSERT(Message != nullptr, "message should be set");
+
+				if (Queue.empty())
+					return false;
+
+				auto& Base = Queue.front();
+				if (Base.Size > 0)
+				{
+					if (Base.Deflated)
+					{
+						*Message = std::string_view(Inflated.data() + (Base.Offset - InflatedBase), Base.Size);
+						InflatedDone = Base.Offset + Base.Size;
+					}
+					else
+					{
+						*Message = std::string_view(Payload.data() + (Base.Offset - PayloadBase), Base.Size);
+						PayloadDone = Base.Offset + Base.Size;
+					}
+				}
+				else
+					*Message = std::string_view();
+
+				*Op = Base.Opcode;
+				Queue.pop();
+				return true;
+			}
+			void WebCodec::Compact()
+			{
+				if (Queue.empty())
+				{
+					Payload.clear();
+					Inflated.clear();
+					PayloadBase = PayloadDone = 0;
+					InflatedBase = InflatedDone = 0;
+					return;
+				}
+
+				size_t Count = PayloadDone - PayloadBase;
+				if (Count > 0 && Count >= Payload.size() - Count)
+				{
+					Payload.erase(Payload.begin(), Payload.begin() + Count);
+					PayloadBase = PayloadDone;
+				}
+
+				Count = InflatedDone - InflatedBase;
+				if (Count > 0 && Count >= Inflated.size() - Count)
+				{
+					Inflated.erase(Inflated.begin(), Inflated.begin() + Count);
+					InflatedBase = InflatedDone;
+				}
+			}
+			bool WebCodec::IsDeflated() const
+			{
+				return Deflate != nullptr;
+			}
+
+			HrmCache::HrmCache() noexcept : HrmCache(HTTP_HRM_SIZE)
+			{
+			}
+			HrmCache::HrmCache(size_t MaxBytesStorage) noexcept : Capacity(MaxBytesStorage), Size(0)
+			{
+			}
+			HrmCache::~HrmCache() noexcept
+			{
+				Size = Capacity = 0;
+				while (!Queue.empty())
+				{
+					auto* Item = Queue.front();
+					Core::Memory::Delete(Item);
+					Queue.pop();
+				}
+			}
 			void HrmCache::ShrinkToFit() noexcept
 			{
 				size_t Freed = 0;
@@ -3924,6 +5046,327 @@ namespace Vitex
 				return Item;
 			}
 
+			struct CachedFile
+			{
+				Core::LinkedList<CachedFile*>::iterator Order;
+				Core::String Path;
+				Core::String Headers;
+				Core::FileEntry Resource;
+				std::chrono::microseconds Validation = std::chrono::microseconds(0);
+				RouterEntry* Route = nullptr;
+				FILE* Stream = nullptr;
+				size_t References = 1;
+			};
+
+			FileCache::FileCache() noexcept : FileCache(HTTP_FILE_CACHE_SIZE, HTTP_FILE_CACHE_TIMEOUT)
+			{
+			}
+			FileCache::FileCache(size_t MaxFiles, uint64_t RevalidateTimeout) noexcept : Timeout(RevalidateTimeout), Capacity(MaxFiles)
+			{
+			}
+			FileCache::~FileCache() noexcept
+			{
+				Clear();
+			}
+			void FileCache::Rescale(size_t MaxFiles, uint64_t RevalidateTimeout) noexcept
+			{
+				Core::UMutex<std::mutex> Unique(Mutex);
+				Capacity = MaxFiles;
+				Timeout = RevalidateTimeout;
+				ShrinkToFit();
+			}
+			void FileCache::Clear() noexcept
+			{
+				Core::UMutex<std::mutex> Unique(Mutex);
+				while (!Usage.empty())
+					Detach(Usage.back());
+			}
+			CachedFile* FileCache::Acquire(RouterEntry* Route, const std::string_view& Path) noexcept
+			{
+				VI_ASSERT(Route != nullptr, "route should be set");
+				auto Time = Core::Schedule::GetClock();
+				std::unique_lock<std::mutex> Unique(Mutex);
+				if (!Capacity)
+					return nullptr;
+
+				auto It = Files.find(Core::KeyLookupCast(Path));
+				if (It != Files.end())
+				{
+					CachedFile* Target = It->second;
+					if (Target->Route == Route && Time - Target->Validation < std::chrono::milliseconds(Timeout))
+					{
+						Usage.splice(Usage.begin(), Usage, Target->Order);
+						++Target->References;
+						return Target;
+					}
+
+					Core::FileEntry Resource;
+					Unique.unlock();
+					bool Unchanged = Target->Route == Route && Core::OS::File::GetState(Path, &Resource) && !Resource.IsDirectory && Resource.Size == Target->Resource.Size && Resource.LastModified == Target->Resource.LastModified;
+					Unique.lock();
+
+					It = Files.find(Core::KeyLookupCast(Path));
+					if (It != Files.end() && It->second == Target && Unchanged)
+					{
+						Target->Validation = Time;
+						Usage.splice(Usage.begin(), Usage, Target->Order);
+						++Target->References;
+						return Target;
+					}
+					else if (It != Files.end() && It->second == Target)
+						Detach(Target);
+				}
+
+				Unique.unlock();
+				CachedFile* Target = Create(Route, Path);
+				if (!Target)
+					return nullptr;
+
+				Unique.lock();
+				It = Files.find(Core::KeyLookupCast(Path));
+				if (It != Files.end())
+					Detach(It->second);
+
+				Target->Validation = Time;
+				Target->Order = Usage.insert(Usage.begin(), Target);
+				Files[Target->Path] = Target;
+				++Target->References;
+				ShrinkToFit();
+				return Target;
+			}
+			void FileCache::Discard(CachedFile* Target) noexcept
+			{
+				VI_ASSERT(Target != nullptr, "file should be set");
+				Core::UMutex<std::mutex> Unique(Mutex);
+				if (--Target->References > 0)
+					return;
+
+				Core::OS::File::Close(Target->Stream);
+				Core::Memory::Delete(Target);
+			}
+			size_t FileCache::GetSize() noexcept
+			{
+				Core::UMutex<std::mutex> Unique(Mutex);
+				return Files.size();
+			}
+			CachedFile* FileCache::Create(RouterEntry* Route, const std::string_view& Path) noexcept
+			{
+				Core::FileEntry Resource;
+				if (!Core::OS::File::GetState(Path, &Resource) || Resource.IsDirectory || !Resource.Size)
+					return nullptr;
+
+				auto File = Core::OS::File::Open(Path, "rb");
+				if (!File)
+					return nullptr;
+
+				char Date[64];
+				CachedFile* Target = Core::Memory::New<CachedFile>();
+				Target->Path = Path;
+				Target->Resource = Resource;
+				Target->Route = Route;
+				Target->Stream = *File;
+				Target->Headers.append("Accept-Ranges: bytes\r\nLast-Modified: ");
+				Target->Headers.append(HeaderDate(Date, Resource.LastModified));
+				Target->Headers.append("\r\n");
+
+				Core::OS::Net::GetETag(Date, sizeof(Date), &Resource);
+				Target->Headers.append("Etag: ").append(Date, strnlen(Date, sizeof(Date))).append("\r\n");
+				Target->Headers.append("Content-Type: ").append(Utils::ContentType(Path, &Route->MimeTypes)).append("; charset=").append(Route->CharSet).append("\r\n");
+				VI_DEBUG("[http] cache file %.*s (%" PRIu64 " bytes)", (int)Path.size(), Path.data(), (uint64_t)Resource.Size);
+				return Target;
+			}
+			void FileCache::Detach(CachedFile* Target) noexcept
+			{
+				Files.erase(Target->Path);
+				Usage.erase(Target->Order);
+				if (--Target->References > 0)
+					return;
+
+				Core::OS::File::Close(Target->Stream);
+				Core::Memory::Delete(Target);
+			}
+			void FileCache::ShrinkToFit() noexcept
+			{
+				while (Files.size() > Capacity && !Usage.empty())
+					Detach(Usage.back());
+			}
+
+			struct CachedVariant
+			{
+				Core::LinkedList<CachedVariant*>::iterator Order;
+				Core::String Key;
+				Core::String Data;
+				size_t References = 1;
+			};
+
+			VariantCache::VariantCache() noexcept : VariantCache(HTTP_VARIANT_CACHE_SIZE)
+			{
+			}
+			VariantCache::VariantCache(size_t MaxBytesStorage) noexcept : Hits(0), Misses(0), Capacity(MaxBytesStorage), Size(0)
+			{
+			}
+			VariantCache::~VariantCache() noexcept
+			{
+				Clear();
+			}
+			void VariantCache::Rescale(size_t MaxBytesStorage) noexcept
+			{
+				Core::UMutex<std::mutex> Unique(Mutex);
+				Capacity = MaxBytesStorage;
+				ShrinkToFit();
+			}
+			void VariantCache::Clear() noexcept
+			{
+				Core::UMutex<std::mutex> Unique(Mutex);
+				while (!Usage.empty())
+					Detach(Usage.back());
+			}
+			CachedVariant* VariantCache::Acquire(Connection* Base, bool Gzip) noexcept
+			{
+				VI_ASSERT(ConnectionValid(Base), "connection should be valid");
+				Core::String Key = Base->Request.Path;
+				Key.append(1, ':').append(Core::ToString(Base->Resource.LastModified));
+				Key.append(1, ':').append(Core::ToString(Base->Resource.Size));
+				Key.append(Gzip ? ":gzip" : ":deflate");
+
+				Core::FileEntry Sibling;
+				bool Precompressed = Gzip && Core::OS::File::GetState(Base->Request.Path + ".gz", &Sibling) && !Sibling.IsDirectory && Sibling.Size > 0 && Sibling.LastModified >= Base->Resource.LastModified;
+				if (Precompressed)
+				{
+					Key.append(1, ':').append(Core::ToString(Sibling.LastModified));
+					Key.append(1, ':').append(Core::ToString(Sibling.Size));
+				}
+
+				std::unique_lock<std::mutex> Unique(Mutex);
+				auto It = Variants.find(Key);
+				while (It == Variants.end() && Pending.find(Key) != Pending.end())
+				{
+					Ready.wait(Unique);
+					It = Variants.find(Key);
+				}
+
+				if (It != Variants.end())
+				{
+					CachedVariant* Target = It->second;
+					Usage.splice(Usage.begin(), Usage, Target->Order);
+					++Target->References;
+					++Hits;
+					return Target;
+				}
+
+				size_t MaxBytes = Capacity / 8;
+				++Misses;
+				if (!MaxBytes || Base->Resource.Size > MaxBytes)
+					return nullptr;
+
+				Pending.insert(Key);
+				Unique.unlock();
+
+				CachedVariant* Target = Create(Base, Gzip, Precompressed ? &Sibling : nullptr, MaxBytes);
+				Unique.lock();
+				Pending.erase(Key);
+				Ready.notify_all();
+				if (!Target)
+					return nullptr;
+
+				Target->Key = std::move(Key);
+				It = Variants.find(Target->Key);
+				if (It != Variants.end())
+					Detach(It->second);
+
+				Target->Order = Usage.insert(Usage.begin(), Target);
+				Variants[Target->Key] = Target;
+				Size += Target->Data.size();
+				++Target->References;
+				ShrinkToFit();
+				return Target;
+			}
+			void VariantCache::Discard(CachedVariant* Target) noexcept
+			{
+				VI_ASSERT(Target != nullptr, "variant should be set");
+				Core::UMutex<std::mutex> Unique(Mutex);
+				if (--Target->References == 0)
+					Core::Memory::Delete(Target);
+			}
+			uint64_t VariantCache::GetHits() const noexcept
+			{
+				return Hits;
+			}
+			uint64_t VariantCache::GetMisses() const noexcept
+			{
+				return Misses;
+			}
+			size_t VariantCache::GetSize() noexcept
+			{
+				Core::UMutex<std::mutex> Unique(Mutex);
+				return Size;
+			}
+			CachedVariant* VariantCache::Create(Connection* Base, bool Gzip, Core::FileEntry* Sibling, size_t MaxBytes) noexcept
+			{
+				VI_MEASURE(Core::Timings::FileSystem);
+				if (Gzip && Sibling != nullptr)
+				{
+					Core::String Path = Base->Request.Path + ".gz";
+					if (Sibling->Size <= MaxBytes)
+					{
+						auto Data = Core::OS::File::ReadAsString(Path);
+						if (Data)
+						{
+							VI_DEBUG("[http] cache precompressed variant %s (%" PRIu64 " bytes)", Path.c_str(), (uint64_t)Data->size());
+							CachedVariant* Target = Core::Memory::New<CachedVariant>();
+							Target->Data = std::move(*Data);
+							return Target;
+						}
+					}
+				}
+#ifdef VI_ZLIB
+				auto Data = Core::OS::File::ReadAsString(Base->Request.Path);
+				if (!Data || Data->empty())
+					return nullptr;
+
+				z_stream ZStream;
+				ZStream.zalloc = Z_NULL;
+				ZStream.zfree = Z_NULL;
+				ZStream.opaque = Z_NULL;
+				if (deflateInit2(&ZStream, Base->Route->Compression.QualityLevel, Z_DEFLATED, (Gzip ? MAX_WBITS + 16 : MAX_WBITS), Base->Route->Compression.MemoryLevel, (int)Base->Route->Compression.Tune) != Z_OK)
+					return nullptr;
+
+				CachedVariant* Target = Core::Memory::New<CachedVariant>();
+				Target->Data.resize((size_t)deflateBound(&ZStream, (uLong)Data->size()));
+				ZStream.avail_in = (uInt)Data->size();
+				ZStream.next_in = (Bytef*)Data->data();
+				ZStream.avail_out = (uInt)Target->Data.size();
+				ZStream.next_out = (Bytef*)Target->Data.data();
+				bool Compress = (deflate(&ZStream, Z_FINISH) == Z_STREAM_END);
+				bool Flush = (deflateEnd(&ZStream) == Z_OK);
+				if (!Compress || !Flush)
+				{
+					Core::Memory::Delete(Target);
+					return nullptr;
+				}
+
+				Target->Data.resize((size_t)ZStream.total_out);
+				Target->Data.shrink_to_fit();
+				VI_DEBUG("[http] cache %s variant %s (%" PRIu64 " bytes)", Gzip ? "gzip" : "deflate", Base->Request.Path.c_str(), (uint64_t)Target->Data.size());
+				return Target;
+#else
+				return nullptr;
+#endif
+			}
+			void VariantCache::Detach(CachedVariant* Target) noexcept
+			{
+				Size -= std::min<size_t>(Size, Target->Data.size());
+				Variants.erase(Target->Key);
+				Usage.erase(Target->Order);
+				if (--Target->References == 0)
+					Core::Memory::Delete(Target);
+			}
+			void VariantCache::ShrinkToFit() noexcept
+			{
+				while (Size > Capacity && !Usage.empty())
+					Detach(Usage.back());
+			}
+
 			void Utils::UpdateKeepAliveHeaders(Connection* Base, Core::String& Content)
 			{
 				VI_ASSERT(ConnectionValid(Base), "connection should be valid");
@@ -3937,7 +5380,7 @@ namespace Vitex
 				auto Connection = Base->Request.GetHeader("Connection");
 				if ((!Connection.empty() && !Core::Stringify::CaseEquals(Connection, "keep-alive")) || (Connection.empty() && strcmp(Base->Request.Version, "1.1") != 0))
 				{
-					Base->Info.Reuses = 1;
+					Base->Info.Reuses = std::min<size_t>(Base->Info.Reuses, 1);
 					Content.append("Connection: Close\r\n");
 					return;
 				}
@@ -4399,28 +5842,22 @@ namespace Vitex
 						else if (Location.front() != '/')
 							Location.insert(Location.begin(), '/');
 
-						for (auto* Next : Group->Routes)
+						auto* Next = Group->Find(Location, Base->Request.Match);
+						if (Next != nullptr)
 						{
-							VI_ASSERT(Next != nullptr, "route should be set");
-							if (Compute::Regex::Match(&Next->Location, Base->Request.Match, Location))
-							{
-								Base->Route = Next;
-								return true;
-							}
+							Base->Route = Next;
+							return true;
 						}
 
 						Location.assign(Base->Request.Referrer);
 					}
 					else
 					{
-						for (auto* Next : Group->Routes)
+						auto* Next = Group->Find(Location, Base->Request.Match);
+						if (Next != nullptr)
 						{
-							VI_ASSERT(Next != nullptr, "route should be set");
-							if (Compute::Regex::Match(&Next->Location, Base->Request.Match, Location))
-							{
-								Base->Route = Next;
-								return true;
-							}
+							Base->Route = Next;
+							return true;
 						}
 					}
 				}
@@ -4971,7 +6408,15 @@ namespace Vitex
 			bool Routing::RouteGet(Connection* Base)
 			{
 				VI_ASSERT(ConnectionValid(Base), "connection should be valid");
-				if (Base->Route->FilesDirectory.empty() || !Core::OS::File::GetState(Base->Request.Path, &Base->Resource))
+				if (Base->Cache != nullptr)
+				{
+					FileCache::Get()->Discard(Base->Cache);
+					Base->Cache = nullptr;
+				}
+
+				if (!Base->Route->FilesDirectory.empty() && Base->Route->AllowFileCache && (Base->Cache = FileCache::Get()->Acquire(Base->Route, Base->Request.Path)) != nullptr)
+					Base->Resource = Base->Cache->Resource;
+				else if (Base->Route->FilesDirectory.empty() || !Core::OS::File::GetState(Base->Request.Path, &Base->Resource))
 				{
 					if (Permissions::WebSocketUpgradeAllowed(Base))
 						return RouteWebSocket(Base);
@@ -5326,22 +6771,15 @@ namespace Vitex
 				}
 #endif
 				Content->append("Content-Length: ").append(Core::ToString(Base->Response.Content.Data.size())).append("\r\n\r\n");
-				return !!Base->Stream->WriteQueued((uint8_t*)Content->c_str(), Content->size(), [Content, Base](SocketPoll Event)
+				std::string_view Buffers[2] = { *Content, std::string_view() };
+				if (memcmp(Base->Request.Method, "HEAD", 4) != 0)
+					Buffers[1] = std::string_view(Base->Response.Content.Data.data(), Base->Response.Content.Data.size());
+
+				return !!Base->Stream->WriteVectorQueued(Buffers, Buffers[1].empty() ? 1 : 2, [Content, Base](SocketPoll Event)
 				{
 					HrmCache::Get()->Push(Content);
 					if (Packet::IsDone(Event))
-					{
-						if (memcmp(Base->Request.Method, "HEAD", 4) == 0)
-							return (void)Base->Next(200);
-
-						Base->Stream->WriteQueued((uint8_t*)Base->Response.Content.Data.data(), Base->Response.Content.Data.size(), [Base](SocketPoll Event)
-						{
-							if (Packet::IsDone(Event))
-								Base->Next(200);
-							else if (Packet::IsError(Event))
-								Base->Abort();
-						}, false);
-					}
+						Base->Next(200);
 					else if (Packet::IsError(Event))
 						Base->Abort();
 				}, false);
@@ -5349,7 +6787,6 @@ namespace Vitex
 			bool Logical::ProcessResource(Connection* Base)
 			{
 				VI_ASSERT(ConnectionValid(Base), "connection should be valid");
-				auto ContentType = Utils::ContentType(Base->Request.Path, &Base->Route->MimeTypes);
 				auto Range = Base->Request.GetHeader("Range");
 				auto StatusMessage = Utils::StatusMessage(Base->Response.StatusCode = (Base->Response.Error && Base->Response.StatusCode > 0 ? Base->Response.StatusCode : 200));
 				int64_t Range1 = 0, Range2 = 0, Count = 0;
@@ -5401,18 +6838,37 @@ namespace Vitex
 				if (!Message.empty())
 					Content->append("X-Error: ").append(Message).append("\r\n");
 
-				Content->append("Accept-Ranges: bytes\r\nLast-Modified: ");
-				Content->append(HeaderDate(Date, Base->Resource.LastModified));
-				Content->append("\r\n");
+				if (Base->Cache != nullptr && Base->Cache->Path == Base->Request.Path)
+					Content->append(Base->Cache->Headers);
+				else
+				{
+					Content->append("Accept-Ranges: bytes\r\nLast-Modified: ");
+					Content->append(HeaderDate(Date, Base->Resource.LastModified));
+					Content->append("\r\n");
 
-				Core::OS::Net::GetETag(Date, sizeof(Date), &Base->Resource);
-				Content->append("Etag: ").append(Date, strnlen(Date, sizeof(Date))).append("\r\n");
-				Content->append("Content-Type: ").append(ContentType).append("; charset=").append(Base->Route->CharSet).append("\r\n");
+					Core::OS::Net::GetETag(Date, sizeof(Date), &Base->Resource);
+					Content->append("Etag: ").append(Date, strnlen(Date, sizeof(Date))).append("\r\n");
+					Content->append("Content-Type: ").append(Utils::ContentType(Base->Request.Path, &Base->Route->MimeTypes)).append("; charset=").append(Base->Route->CharSet).append("\r\n");
+				}
 				Content->append("Content-Length: ").append(Core::ToString(ContentLength)).append("\r\n");
 				Content->append(ContentRange).append("\r\n");
 
 				if (ContentLength > 0 && strcmp(Base->Request.Method, "HEAD") != 0)
 				{
+					size_t Offset = std::min<size_t>((size_t)Range1, Base->Resource.Size);
+					if (Base->Resource.IsReferenced && Base->Resource.Size > 0 && Base->Response.Content.Data.size() >= Offset + (size_t)ContentLength)
+					{
+						std::string_view Buffers[2] = { *Content, std::string_view(Base->Response.Content.Data.data() + Offset, (size_t)ContentLength) };
+						return !!Base->Stream->WriteVectorQueued(Buffers, 2, [Content, Base](SocketPoll Event)
+						{
+							HrmCache::Get()->Push(Content);
+							if (Packet::IsDone(Event))
+								Base->Next();
+							else if (Packet::IsError(Event))
+								Base->Abort();
+						}, false);
+					}
+
 					return !!Base->Stream->WriteQueued((uint8_t*)Content->c_str(), Content->size(), [Content, Base, ContentLength, Range1](SocketPoll Event)
 					{
 						HrmCache::Get()->Push(Content);
@@ -5438,10 +6894,13 @@ namespace Vitex
 			{
 				VI_ASSERT(ConnectionValid(Base), "connection should be valid");
 				VI_ASSERT(Deflate || Gzip, "uncompressable resource");
-				auto ContentType = Utils::ContentType(Base->Request.Path, &Base->Route->MimeTypes);
 				auto StatusMessage = Utils::StatusMessage(Base->Response.StatusCode = (Base->Response.Error && Base->Response.StatusCode > 0 ? Base->Response.StatusCode : 200));
 				int64_t ContentLength = (int64_t)Base->Resource.Size;
 
+				CachedVariant* Variant = nullptr;
+				if (ContentLength > 0 && ContentRange.empty() && !Range)
+					Variant = VariantCache::Get()->Acquire(Base, Gzip);
+
 				char Date[64];
 				auto* Content = HrmCache::Get()->Pop();
 				Content->append(Base->Request.Version).append(" ");
@@ -5464,14 +6923,37 @@ namespace Vitex
 				if (!Message.empty())
 					Content->append("X-Error: ").append(Message).append("\r\n");
 
-				Content->append("Accept-Ranges: bytes\r\nLast-Modified: ");
-				Content->append(HeaderDate(Date,Base->Resource.LastModified));
-				Content->append("\r\n");
+				if (Base->Cache != nullptr && Base->Cache->Path == Base->Request.Path)
+					Content->append(Base->Cache->Headers);
+				else
+				{
+					Content->append("Accept-Ranges: bytes\r\nLast-Modified: ");
+					Content->append(HeaderDate(Date, Base->Resource.LastModified));
+					Content->append("\r\n");
 
-				Core::OS::Net::GetETag(Date, sizeof(Date), &Base->Resource);
-				Content->append("Etag: ").append(Date, strnlen(Date, sizeof(Date))).append("\r\n");
-				Content->append("Content-Type: ").append(ContentType).append("; charset=").append(Base->Route->CharSet).append("\r\n");
+					Core::OS::Net::GetETag(Date, sizeof(Date), &Base->Resource);
+					Content->append("Etag: ").append(Date, strnlen(Date, sizeof(Date))).append("\r\n");
+					Content->append("Content-Type: ").append(Utils::ContentType(Base->Request.Path, &Base->Route->MimeTypes)).append("; charset=").append(Base->Route->CharSet).append("\r\n");
+				}
 				Content->append("Content-Encoding: ").append(Gzip ? "gzip" : "deflate").append("\r\n");
+				if (Variant != nullptr)
+				{
+					Content->append("Content-Length: ").append(Core::ToString(Variant->Data.size())).append("\r\n\r\n");
+					std::string_view Buffers[2] = { *Content, std::string_view() };
+					if (strcmp(Base->Request.Method, "HEAD") != 0)
+						Buffers[1] = Variant->Data;
+
+					return !!Base->Stream->WriteVectorQueued(Buffers, Buffers[1].empty() ? 1 : 2, [Content, Base, Variant](SocketPoll Event)
+					{
+						HrmCache::Get()->Push(Content);
+						VariantCache::Get()->Discard(Variant);
+						if (Packet::IsDone(Event))
+							Base->Next();
+						else if (Packet::IsError(Event))
+							Base->Abort();
+					}, false);
+				}
+
 				Content->append("Transfer-Encoding: chunked\r\n");
 				Content->append(ContentRange).append("\r\n");
 
@@ -5551,6 +7033,25 @@ namespace Vitex
 					}
 				}
 
+				if (ContentLength > 0 && Base->Route->AllowSendFile && Base->Cache != nullptr && Base->Cache->Path == Base->Request.Path)
+				{
+					auto Result = Base->Stream->WriteFileQueued(Base->Cache->Stream, Range, ContentLength, [Base, ContentLength, Range](SocketPoll Event)
+					{
+						if (Packet::IsDone(Event))
+							Base->Next();
+						else if (Packet::IsError(Event))
+						{
+							auto File = Core::OS::File::Open(Base->Request.Path.c_str(), "rb");
+							if (File)
+								ProcessFileStream(Base, *File, ContentLength, Range);
+							else
+								Base->Abort();
+						}
+					});
+					if (Result || Result.Error() != std::errc::not_supported)
+						return true;
+				}
+
 				auto File = Core::OS::File::Open(Base->Request.Path.c_str(), "rb");
 				if (!File)
 					return Base->Abort(500, "System denied to open resource stream.");
@@ -5821,50 +7322,1629 @@ namespace Vitex
 				auto Protocol = Base->Request.GetHeader("Sec-WebSocket-Protocol");
 				if (!Protocol.empty())
 				{
-					const char* Offset = strchr(Protocol.data(), ',');
-					if (Offset != nullptr)
-						Content->append("Sec-WebSocket-Protocol: ").append(Protocol, (size_t)(Offset - Protocol.data())).append("\r\n");
-					else
-						Content->append("Sec-WebSocket-Protocol: ").append(Protocol).append("\r\n");
+					const char* Offset = strchr(Protocol.data(), ',');
+					if (Offset != nullptr)
+						Content->append("Sec-WebSocket-Protocol: ").append(Protocol, (size_t)(Offset - Protocol.data())).append("\r\n");
+					else
+						Content->append("Sec-WebSocket-Protocol: ").append(Protocol).append("\r\n");
+				}
+
+				WebSocketDeflate Deflate; bool Deflated = false;
+#ifdef VI_ZLIB
+				auto Extensions = Base->Request.GetHeader("Sec-WebSocket-Extensions");
+				if (Base->Route->AllowWebSocketCompression && !Extensions.empty())
+				{
+					Core::String Response;
+					Deflated = NegotiateDeflate(Extensions, Base->Route->WebSocketCompression, true, &Deflate, &Response);
+					if (Deflated)
+						Content->append("Sec-WebSocket-Extensions: ").append(Response).append("\r\n");
+				}
+#endif
+				if (Base->Route->Callbacks.Headers)
+					Base->Route->Callbacks.Headers(Base, *Content);
+
+				Content->append("\r\n", 2);
+				return !!Base->Stream->WriteQueued((uint8_t*)Content->c_str(), Content->size(), [Content, Base, Deflate, Deflated](SocketPoll Event)
+				{
+					HrmCache::Get()->Push(Content);
+					if (Packet::IsDone(Event))
+					{
+						Base->WebSocket = new WebSocketFrame(Base->Stream, Base);
+						if (Deflated)
+							Base->WebSocket->SetDeflate(Deflate);
+						Base->WebSocket->Connect = Base->Route->Callbacks.WebSocket.Connect;
+						Base->WebSocket->Receive = Base->Route->Callbacks.WebSocket.Receive;
+						Base->WebSocket->Disconnect = Base->Route->Callbacks.WebSocket.Disconnect;
+						Base->WebSocket->Lifetime.Dead = [Base](WebSocketFrame*)
+						{
+							return Base->Info.Abort;
+						};
+						Base->WebSocket->Lifetime.Close = [Base](WebSocketFrame*, bool Successful)
+						{
+							if (Successful)
+								Base->Next();
+							else
+								Base->Abort();
+						};
+
+						Base->Stream->SetIoTimeout(Base->Route->WebSocketTimeout);
+						if (!Base->Route->Callbacks.WebSocket.Initiate || !Base->Route->Callbacks.WebSocket.Initiate(Base))
+							Base->WebSocket->Next();
+					}
+					else if (Packet::IsError(Event))
+						Base->Abort();
+				}, false);
+			}
+
+			struct HpackCodec
+			{
+				typedef std::pair<Core::String, Core::String> Field;
+
+				struct HuffmanTable
+				{
+					uint32_t Codes[257];
+					uint8_t Lengths[257];
+					uint16_t Symbols[257];
+					uint32_t First[31];
+					uint16_t Count[31];
+					uint16_t Offset[31];
+				};
+
+				Core::Vector<Field> Entries;
+				size_t Size = 0;
+				size_t Capacity = 4096;
+				size_t Limit = 4096;
+
+				bool Decode(const uint8_t* Data, size_t Length, size_t MaxSize, Core::Vector<Field>& Fields)
+				{
+					const uint8_t* End = Data + Length;
+					size_t Total = 0;
+					bool Leading = true;
+					while (Data < End)
+					{
+						uint8_t Type = *Data;
+						uint64_t Index = 0;
+						if (Type & 0x80)
+						{
+							Field Next;
+							if (!DecodeInteger(Data, End, 7, &Index) || !Lookup(Index, &Next, true))
+								return false;
+
+							Fields.push_back(std::move(Next));
+						}
+						else if ((Type & 0xE0) == 0x20)
+						{
+							if (!Leading || !DecodeInteger(Data, End, 5, &Index) || Index > Limit)
+								return false;
+
+							Capacity = (size_t)Index;
+							Evict(0);
+							continue;
+						}
+						else
+						{
+							Field Next;
+							bool Indexing = (Type & 0xC0) == 0x40;
+							if (!DecodeInteger(Data, End, Indexing ? 6 : 4, &Index))
+								return false;
+
+							if (Index > 0 && !Lookup(Index, &Next, false))
+								return false;
+							else if (!Index && !DecodeString(Data, End, &Next.first))
+								return false;
+
+							if (!DecodeString(Data, End, &Next.second))
+								return false;
+
+							if (Indexing)
+								Insert(Next);
+							Fields.push_back(std::move(Next));
+						}
+
+						auto& Last = Fields.back();
+						Total += Last.first.size() + Last.second.size() + 32;
+						if (Total > MaxSize)
+							return false;
+
+						Leading = false;
+					}
+
+					return true;
+				}
+				bool Lookup(uint64_t Index, Field* Output, bool WithValue)
+				{
+					static const char* Table[61][2] =
+					{
+						{ ":authority", "" }, { ":method", "GET" }, { ":method", "POST" }, { ":path", "/" }, { ":path", "/index.html" },
+						{ ":scheme", "http" }, { ":scheme", "https" }, { ":status", "200" }, { ":status", "204" }, { ":status", "206" },
+						{ ":status", "304" }, { ":status", "400" }, { ":status", "404" }, { ":status", "500" }, { "accept-charset", "" },
+						{ "accept-encoding", "gzip, deflate" }, { "accept-language", "" }, { "accept-ranges", "" }, { "accept", "" }, { "access-control-allow-origin", "" },
+						{ "age", "" }, { "allow", "" }, { "authorization", "" }, { "cache-control", "" }, { "content-disposition", "" },
+						{ "content-encoding", "" }, { "content-language", "" }, { "content-length", "" }, { "content-location", "" }, { "content-range", "" },
+						{ "content-type", "" }, { "cookie", "" }, { "date", "" }, { "etag", "" }, { "expect", "" },
+						{ "expires", "" }, { "from", "" }, { "host", "" }, { "if-match", "" }, { "if-modified-since", "" },
+						{ "if-none-match", "" }, { "if-range", "" }, { "if-unmodified-since", "" }, { "last-modified", "" }, { "link", "" },
+						{ "location", "" }, { "max-forwards", "" }, { "proxy-authenticate", "" }, { "proxy-authorization", "" }, { "range", "" },
+						{ "referer", "" }, { "refresh", "" }, { "retry-after", "" }, { "server", "" }, { "set-cookie", "" },
+						{ "strict-transport-security", "" }, { "transfer-encoding", "" }, { "user-agent", "" }, { "vary", "" }, { "via", "" },
+						{ "www-authenticate", "" }
+					};
+
+					if (!Index)
+						return false;
+
+					if (Index <= 61)
+					{
+						Output->first = Table[Index - 1][0];
+						if (WithValue)
+							Output->second = Table[Index - 1][1];
+						return true;
+					}
+
+					Index -= 62;
+					if (Index >= Entries.size())
+						return false;
+
+					auto& Entry = Entries[Entries.size() - 1 - (size_t)Index];
+					Output->first = Entry.first;
+					if (WithValue)
+						Output->second = Entry.second;
+					return true;
+				}
+				void Insert(const Field& Entry)
+				{
+					size_t Required = Entry.first.size() + Entry.second.size() + 32;
+					if (Required > Capacity)
+					{
+						Entries.clear();
+						Size = 0;
+						return;
+					}
+
+					Evict(Required);
+					Entries.push_back(Entry);
+					Size += Required;
+				}
+				void Evict(size_t Required)
+				{
+					size_t Count = 0;
+					while (Count < Entries.size() && Size + Required > Capacity)
+					{
+						auto& Entry = Entries[Count++];
+						Size -= Entry.first.size() + Entry.second.size() + 32;
+					}
+
+					if (Count > 0)
+						Entries.erase(Entries.begin(), Entries.begin() + Count);
+				}
+
+				static const HuffmanTable& GetHuffman()
+				{
+					static HuffmanTable Table = []()
+					{
+						static const uint8_t Lengths[257] =
+						{
+							13, 23, 28, 28, 28, 28, 28, 28, 28, 24, 30, 28, 28, 30, 28, 28, 28, 28, 28, 28, 28, 28, 30, 28, 28, 28, 28, 28, 28, 28, 28, 28,
+							6, 10, 10, 12, 13, 6, 8, 11, 10, 10, 8, 11, 8, 6, 6, 6, 5, 5, 5, 6, 6, 6, 6, 6, 6, 6, 7, 8, 15, 6, 12, 10,
+							13, 6, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 8, 7, 8, 13, 19, 13, 14, 6,
+							15, 5, 6, 5, 6, 5, 6, 6, 6, 5, 7, 7, 6, 6, 6, 5, 6, 7, 6, 5, 5, 6, 7, 7, 7, 7, 7, 15, 11, 14, 13, 28,
+							20, 22, 20, 20, 22, 22, 22, 23, 22, 23, 23, 23, 23, 23, 24, 23, 24, 24, 22, 23, 24, 23, 23, 23, 23, 21, 22, 23, 22, 23, 23, 24,
+							22, 21, 20, 22, 22, 23, 23, 21, 23, 22, 22, 24, 21, 22, 23, 23, 21, 21, 22, 21, 23, 22, 23, 23, 20, 22, 22, 22, 23, 22, 22, 23,
+							26, 26, 20, 19, 22, 23, 22, 25, 26, 26, 26, 27, 27, 26, 24, 25, 19, 21, 26, 27, 27, 26, 27, 24, 21, 21, 26, 26, 28, 27, 27, 27,
+							20, 24, 20, 21, 22, 21, 21, 23, 22, 22, 25, 25, 24, 24, 26, 23, 26, 27, 26, 26, 27, 27, 27, 27, 27, 28, 27, 27, 27, 27, 27, 26,
+							30
+						};
+
+						HuffmanTable Result;
+						memset(&Result, 0, sizeof(Result));
+						memcpy(Result.Lengths, Lengths, sizeof(Lengths));
+						for (size_t i = 0; i < 257; i++)
+							++Result.Count[Lengths[i]];
+
+						uint16_t Next[31] = { 0 };
+						uint32_t Code = 0;
+						for (size_t i = 1; i < 31; i++)
+						{
+							Result.Offset[i] = (uint16_t)(Result.Offset[i - 1] + Result.Count[i - 1]);
+							Result.First[i] = Code;
+							Code = (Code + Result.Count[i]) << 1;
+							Next[i] = Result.Offset[i];
+						}
+
+						for (size_t i = 0; i < 257; i++)
+						{
+							uint8_t Length = Lengths[i];
+							Result.Codes[i] = Result.First[Length] + (Next[Length] - Result.Offset[Length]);
+							Result.Symbols[Next[Length]++] = (uint16_t)i;
+						}
+
+						return Result;
+					}();
+					return Table;
+				}
+				static bool DecodeInteger(const uint8_t*& Data, const uint8_t* End, uint8_t Prefix, uint64_t* Value)
+				{
+					if (Data >= End)
+						return false;
+
+					uint64_t Mask = (1 << Prefix) - 1;
+					uint64_t Result = *(Data++) & Mask;
+					if (Result < Mask)
+					{
+						*Value = Result;
+						return true;
+					}
+
+					uint32_t Shift = 0;
+					while (Data < End && Shift <= 28)
+					{
+						uint8_t Byte = *(Data++);
+						Result += (uint64_t)(Byte & 0x7F) << Shift;
+						if (!(Byte & 0x80))
+						{
+							*Value = Result;
+							return true;
+						}
+						Shift += 7;
+					}
+
+					return false;
+				}
+				static bool DecodeString(const uint8_t*& Data, const uint8_t* End, Core::String* Value)
+				{
+					if (Data >= End)
+						return false;
+
+					bool Huffman = (*Data & 0x80) != 0;
+					uint64_t Length = 0;
+					if (!DecodeInteger(Data, End, 7, &Length) || Length > (uint64_t)(End - Data))
+						return false;
+
+					const uint8_t* Next = Data;
+					Data += (size_t)Length;
+					if (!Huffman)
+					{
+						Value->assign((char*)Next, (size_t)Length);
+						return true;
+					}
+
+					auto& Table = GetHuffman();
+					uint32_t Code = 0, Bits = 0;
+					Value->clear();
+					Value->reserve((size_t)Length * 8 / 5);
+					for (; Next < Data; Next++)
+					{
+						for (int i = 7; i >= 0; i--)
+						{
+							Code = (Code << 1) | ((*Next >> i) & 1);
+							if (++Bits > 30)
+								return false;
+
+							uint32_t Index = Code - Table.First[Bits];
+							if (Code < Table.First[Bits] || Index >= Table.Count[Bits])
+								continue;
+
+							uint16_t Symbol = Table.Symbols[Table.Offset[Bits] + Index];
+							if (Symbol == 256)
+								return false;
+
+							Value->push_back((char)Symbol);
+							Code = Bits = 0;
+						}
+					}
+
+					return Bits <= 7 && Code == (1u << Bits) - 1;
+				}
+				static void EncodeInteger(Core::String& Output, uint8_t Flags, uint8_t Prefix, uint64_t Value)
+				{
+					uint64_t Mask = (1 << Prefix) - 1;
+					if (Value < Mask)
+					{
+						Output.push_back((char)(Flags | (uint8_t)Value));
+						return;
+					}
+
+					Output.push_back((char)(Flags | (uint8_t)Mask));
+					Value -= Mask;
+					while (Value >= 128)
+					{
+						Output.push_back((char)(0x80 | (Value & 0x7F)));
+						Value >>= 7;
+					}
+					Output.push_back((char)Value);
+				}
+				static void EncodeString(Core::String& Output, const std::string_view& Value)
+				{
+					auto& Table = GetHuffman();
+					size_t Bits = 0;
+					for (char Next : Value)
+						Bits += Table.Lengths[(uint8_t)Next];
+
+					size_t Length = (Bits + 7) / 8;
+					if (Length >= Value.size())
+					{
+						EncodeInteger(Output, 0x00, 7, Value.size());
+						Output.append(Value);
+						return;
+					}
+
+					EncodeInteger(Output, 0x80, 7, Length);
+					uint64_t Buffer = 0;
+					uint32_t Pending = 0;
+					for (char Next : Value)
+					{
+						Buffer = (Buffer << Table.Lengths[(uint8_t)Next]) | Table.Codes[(uint8_t)Next];
+						Pending += Table.Lengths[(uint8_t)Next];
+						while (Pending >= 8)
+						{
+							Pending -= 8;
+							Output.push_back((char)(Buffer >> Pending));
+						}
+					}
+
+					if (Pending > 0)
+						Output.push_back((char)((Buffer << (8 - Pending)) | (0xFF >> Pending)));
+				}
+				static void Encode(Core::String& Output, const std::string_view& Name, const std::string_view& Value)
+				{
+					static const char* Names[] = { "accept-ranges", "access-control-allow-origin", "age", "allow", "cache-control", "content-disposition", "content-encoding", "content-language", "content-length", "content-location", "content-range", "content-type", "date", "etag", "expires", "last-modified", "link", "location", "proxy-authenticate", "refresh", "retry-after", "server", "set-cookie", "strict-transport-security", "vary", "via", "www-authenticate" };
+					static const uint8_t Indices[] = { 18, 20, 21, 22, 24, 25, 26, 27, 28, 29, 30, 31, 33, 34, 36, 44, 45, 46, 48, 52, 53, 54, 55, 56, 59, 60, 61 };
+
+					uint8_t Index = 0;
+					for (size_t i = 0; i < sizeof(Indices); i++)
+					{
+						if (Name == Names[i])
+						{
+							Index = Indices[i];
+							break;
+						}
+					}
+
+					uint8_t Flags = (Name == "set-cookie" || Name == "authorization" ? 0x10 : 0x00);
+					if (Index > 0)
+					{
+						EncodeInteger(Output, Flags, 4, Index);
+					}
+					else
+					{
+						Output.push_back((char)Flags);
+						EncodeString(Output, Name);
+					}
+					EncodeString(Output, Value);
+				}
+				static void EncodeStatus(Core::String& Output, int StatusCode)
+				{
+					switch (StatusCode)
+					{
+						case 200:
+							Output.push_back((char)(0x80 | 8));
+							break;
+						case 204:
+							Output.push_back((char)(0x80 | 9));
+							break;
+						case 206:
+							Output.push_back((char)(0x80 | 10));
+							break;
+						case 304:
+							Output.push_back((char)(0x80 | 11));
+							break;
+						case 400:
+							Output.push_back((char)(0x80 | 12));
+							break;
+						case 404:
+							Output.push_back((char)(0x80 | 13));
+							break;
+						case 500:
+							Output.push_back((char)(0x80 | 14));
+							break;
+						default:
+							EncodeInteger(Output, 0x00, 4, 8);
+							EncodeString(Output, Core::ToString(StatusCode));
+							break;
+					}
+				}
+			};
+
+			struct Http2Session;
+
+			struct Http2Channel final : public SocketChannel
+			{
+				Http2Session* Session;
+				uint32_t Id;
+
+				Http2Channel(Http2Session* NewSession, uint32_t NewId);
+				~Http2Channel() noexcept override;
+				Core::ExpectsIO<size_t> Read(uint8_t* Buffer, size_t Size) override;
+				Core::ExpectsIO<size_t> Write(const uint8_t* Buffer, size_t Size) override;
+				void Detach() override;
+				bool IsReadable() override;
+				bool IsWriteable() override;
+			};
+
+			struct Http2Stream
+			{
+				Core::String Forward;
+				Core::String Incoming;
+				Core::String Payload;
+				ResponseFrame Response;
+				Parser::ChunkedState Chunked;
+				Socket* Target = nullptr;
+				int64_t Window = 65535;
+				int64_t Receivable = 65535;
+				int64_t Expected = -1;
+				int64_t Remaining = -1;
+				uint64_t Pass = 0;
+				size_t Offset = 0;
+				size_t Credit = 0;
+				uint32_t Id = 0;
+				uint32_t Dependency = 0;
+				uint16_t Weight = 16;
+				bool Head = false;
+				bool Chunking = false;
+				bool Requested = false;
+				bool Responded = false;
+				bool Streaming = false;
+				bool Completed = false;
+				bool Finished = false;
+				bool Rejected = false;
+			};
+
+			struct Http2Session
+			{
+				enum class FrameType : uint8_t
+				{
+					Data = 0x0,
+					Headers = 0x1,
+					Priority = 0x2,
+					Reset = 0x3,
+					Settings = 0x4,
+					PushPromise = 0x5,
+					Ping = 0x6,
+					GoAway = 0x7,
+					WindowUpdate = 0x8,
+					Continuation = 0x9
+				};
+
+				enum class ErrorCode : uint32_t
+				{
+					None = 0x0,
+					Protocol = 0x1,
+					Internal = 0x2,
+					FlowControl = 0x3,
+					StreamClosed = 0x5,
+					FrameSize = 0x6,
+					RefusedStream = 0x7,
+					Compression = 0x9,
+					Http11Required = 0xD
+				};
+
+				enum
+				{
+					FlagEndStream = 0x1,
+					FlagAck = 0x1,
+					FlagEndHeaders = 0x4,
+					FlagPadded = 0x8,
+					FlagPriority = 0x20
+				};
+
+				std::atomic<size_t> References;
+				std::recursive_mutex Section;
+				Core::UnorderedMap<uint32_t, Http2Stream*> Streams;
+				Core::Vector<HpackCodec::Field> Fields;
+				HpackCodec Decoder;
+				Core::String Input;
+				Core::String Output;
+				Core::String Writing;
+				Core::String Block;
+				Parser* Resolver;
+				Connection* Base;
+				MapRouter* Router;
+				uint64_t Clock = 0;
+				int64_t Window = 65535;
+				int64_t Receivable = 65535;
+				int64_t LocalWindowSize = 65535;
+				int64_t RemoteWindowSize = 65535;
+				size_t RemoteFrameSize = 16384;
+				size_t Orphans = 0;
+				uint32_t LastStreamId = 0;
+				uint32_t BlockId = 0;
+				uint32_t BlockDependency = 0;
+				uint16_t BlockWeight = 0;
+				uint8_t BlockFlags = 0;
+				bool Prefaced = false;
+				bool Configured = false;
+				bool Sending = false;
+				bool Reading = false;
+				bool GoingAway = false;
+				bool Failed = false;
+				bool Closed = false;
+
+				Http2Session(Connection* NewBase) : References(1), Resolver(new Parser()), Base(NewBase), Router((MapRouter*)NewBase->Root->GetRouter())
+				{
+					LocalWindowSize = (int64_t)std::min<size_t>(Router->Http2.InitialWindowSize, 0x7FFFFFFF);
+					Decoder.Limit = std::max<size_t>(Router->Http2.HeaderTableSize, 4096);
+				}
+				~Http2Session() noexcept
+				{
+					for (auto& Item : Streams)
+						Core::Memory::Delete(Item.second);
+
+					Core::Memory::Release(Resolver);
+				}
+				void AddRef()
+				{
+					++References;
+				}
+				void Release()
+				{
+					if (!--References)
+						Core::Memory::Delete(this);
+				}
+				void Begin(const uint8_t* Buffer, size_t Size)
+				{
+					AddRef();
+					{
+						Core::UMutex<std::recursive_mutex> Unique(Section);
+						if (Buffer != nullptr && Size > 0)
+							Input.assign((char*)Buffer, Size);
+
+						uint8_t Settings[24];
+						EncodeSetting(Settings + 0, 0x1, (uint32_t)std::min<size_t>(Router->Http2.HeaderTableSize, 0xFFFFFFFF));
+						EncodeSetting(Settings + 6, 0x3, (uint32_t)std::min<size_t>(Router->Http2.MaxConcurrentStreams, 0xFFFFFFFF));
+						EncodeSetting(Settings + 12, 0x4, (uint32_t)LocalWindowSize);
+						EncodeSetting(Settings + 18, 0x5, (uint32_t)std::min<size_t>(std::max<size_t>(Router->Http2.MaxFrameSize, 16384), 16777215));
+						Emit(FrameType::Settings, 0, 0, Settings, sizeof(Settings));
+						if (LocalWindowSize > Receivable)
+						{
+							EmitWindowUpdate(0, (uint32_t)(LocalWindowSize - Receivable));
+							Receivable = LocalWindowSize;
+						}
+
+						Process();
+						Listen();
+						Flush();
+					}
+					Release();
+				}
+				void Listen()
+				{
+					if (Closed || Failed || Reading)
+						return;
+
+					AddRef();
+					Reading = true;
+					Multiplexer::Get()->WhenReadable(Base->Stream, [this](SocketPoll Event)
+					{
+						{
+							Core::UMutex<std::recursive_mutex> Unique(Section);
+							Reading = false;
+							if (!Closed)
+							{
+								if (Packet::IsDone(Event))
+									Receive();
+								else if (Packet::IsTimeout(Event) && !GoingAway && !Streams.empty())
+									Listen();
+								else if (Packet::IsTimeout(Event) && !GoingAway)
+									Shutdown();
+								else
+									Teardown();
+								Flush();
+							}
+						}
+						Release();
+					});
+				}
+				void Receive()
+				{
+					uint8_t Buffer[Core::BLOB_SIZE];
+					while (!Closed && !Failed)
+					{
+						auto Size = Base->Stream->Read(Buffer, sizeof(Buffer));
+						if (!Size)
+						{
+							if (Size.Error() != std::errc::operation_would_block)
+								return Teardown();
+							break;
+						}
+
+						Input.append((char*)Buffer, *Size);
+						Process();
+					}
+					Listen();
+				}
+				void Process()
+				{
+					size_t Offset = 0;
+					if (!Prefaced)
+					{
+						if (Input.size() < 6)
+							return;
+
+						if (memcmp(Input.data(), "SM\r\n\r\n", 6) != 0)
+						{
+							Fail(ErrorCode::Protocol);
+							return;
+						}
+
+						Prefaced = true;
+						Offset = 6;
+					}
+
+					size_t MaxFrameSize = std::min<size_t>(std::max<size_t>(Router->Http2.MaxFrameSize, 16384), 16777215);
+					while (!Failed && Input.size() - Offset >= 9)
+					{
+						const uint8_t* Header = (uint8_t*)Input.data() + Offset;
+						size_t Length = ((size_t)Header[0] << 16) | ((size_t)Header[1] << 8) | (size_t)Header[2];
+						if (Length > MaxFrameSize)
+						{
+							Fail(ErrorCode::FrameSize);
+							return;
+						}
+						else if (Input.size() - Offset < Length + 9)
+							break;
+
+						Offset += Length + 9;
+						if (!Dispatch((FrameType)Header[3], Header[4], DecodeUInt32(Header + 5) & 0x7FFFFFFF, Header + 9, Length))
+							return;
+					}
+
+					Input.erase(0, Offset);
+				}
+				bool Dispatch(FrameType Type, uint8_t Flags, uint32_t Id, const uint8_t* Data, size_t Length)
+				{
+					if (BlockId != 0 && (Type != FrameType::Continuation || Id != BlockId))
+						return Fail(ErrorCode::Protocol);
+					else if (!Configured && Type != FrameType::Settings)
+						return Fail(ErrorCode::Protocol);
+
+					switch (Type)
+					{
+						case FrameType::Data:
+							return OnData(Flags, Id, Data, Length);
+						case FrameType::Headers:
+							return OnHeaders(Flags, Id, Data, Length);
+						case FrameType::Priority:
+							return OnPriority(Id, Data, Length);
+						case FrameType::Reset:
+							return OnReset(Id, Length);
+						case FrameType::Settings:
+							return OnSettings(Flags, Id, Data, Length);
+						case FrameType::Ping:
+							return OnPing(Flags, Id, Data, Length);
+						case FrameType::GoAway:
+							return OnGoAway(Id, Length);
+						case FrameType::WindowUpdate:
+							return OnWindowUpdate(Id, Data, Length);
+						case FrameType::Continuation:
+							return OnContinuation(Flags, Id, Data, Length);
+						case FrameType::PushPromise:
+							return Fail(ErrorCode::Protocol);
+						default:
+							return true;
+					}
+				}
+				bool OnData(uint8_t Flags, uint32_t Id, const uint8_t* Data, size_t Length)
+				{
+					if (!Id)
+						return Fail(ErrorCode::Protocol);
+					else if ((int64_t)Length > Receivable)
+						return Fail(ErrorCode::FlowControl);
+
+					Receivable -= Length;
+					if (Receivable <= LocalWindowSize / 2)
+					{
+						EmitWindowUpdate(0, (uint32_t)(LocalWindowSize - Receivable));
+						Receivable = LocalWindowSize;
+					}
+
+					size_t Padding = 0;
+					if (Flags & FlagPadded)
+					{
+						if (!Length || (size_t)Data[0] + 1 > Length)
+							return Fail(ErrorCode::Protocol);
+						Padding = (size_t)Data[0] + 1;
+					}
+
+					auto It = Streams.find(Id);
+					if (It == Streams.end())
+						return Id <= LastStreamId ? true : Fail(ErrorCode::Protocol);
+
+					auto* Stream = It->second;
+					if (Stream->Requested)
+						return Abort(Stream, ErrorCode::StreamClosed);
+					else if ((int64_t)Length > Stream->Receivable)
+						return Abort(Stream, ErrorCode::FlowControl);
+
+					size_t Size = Length - Padding;
+					Stream->Receivable -= Length;
+					Stream->Credit += Padding;
+					if (Stream->Expected >= 0)
+					{
+						if ((int64_t)Size > Stream->Expected)
+							return Abort(Stream, ErrorCode::Protocol);
+						Stream->Expected -= Size;
+					}
+
+					if (Stream->Rejected)
+						Stream->Credit += Size;
+					else if (Size > 0)
+					{
+						const char* Payload = (char*)Data + (Flags & FlagPadded ? 1 : 0);
+						if (Stream->Chunking)
+						{
+							char Hex[20];
+							int HexSize = snprintf(Hex, sizeof(Hex), "%llx\r\n", (unsigned long long)Size);
+							Stream->Forward.append(Hex, (size_t)HexSize);
+							Stream->Forward.append(Payload, Size);
+							Stream->Forward.append("\r\n", 2);
+						}
+						else
+							Stream->Forward.append(Payload, Size);
+						Stream->Credit += Size;
+					}
+
+					if (Flags & FlagEndStream)
+					{
+						if (Stream->Expected > 0)
+							return Abort(Stream, ErrorCode::Protocol);
+						Conclude(Stream);
+					}
+
+					if (Stream->Rejected || Stream->Forward.empty())
+						Restore(Stream);
+					Notify(Stream, true, false);
+					return true;
+				}
+				bool OnHeaders(uint8_t Flags, uint32_t Id, const uint8_t* Data, size_t Length)
+				{
+					if (!Id || !(Id & 1))
+						return Fail(ErrorCode::Protocol);
+
+					size_t Padding = 0;
+					if (Flags & FlagPadded)
+					{
+						if (!Length)
+							return Fail(ErrorCode::FrameSize);
+						Padding = Data[0];
+						++Data; --Length;
+					}
+
+					BlockDependency = 0;
+					BlockWeight = 0;
+					if (Flags & FlagPriority)
+					{
+						if (Length < 5)
+							return Fail(ErrorCode::FrameSize);
+						BlockDependency = DecodeUInt32(Data) & 0x7FFFFFFF;
+						BlockWeight = (uint16_t)Data[4] + 1;
+						Data += 5; Length -= 5;
+					}
+
+					if (Padding > Length)
+						return Fail(ErrorCode::Protocol);
+
+					Block.assign((char*)Data, Length - Padding);
+					BlockFlags = Flags;
+					BlockId = Id;
+					if (Flags & FlagEndHeaders)
+						return Complete();
+
+					return true;
+				}
+				bool OnContinuation(uint8_t Flags, uint32_t Id, const uint8_t* Data, size_t Length)
+				{
+					if (!BlockId || Id != BlockId)
+						return Fail(ErrorCode::Protocol);
+
+					Block.append((char*)Data, Length);
+					if (Block.size() > Router->MaxHeapBuffer)
+						return Fail(ErrorCode::Protocol);
+
+					if (Flags & FlagEndHeaders)
+						return Complete();
+
+					return true;
+				}
+				bool OnPriority(uint32_t Id, const uint8_t* Data, size_t Length)
+				{
+					if (!Id)
+						return Fail(ErrorCode::Protocol);
+					else if (Length != 5)
+						return Fail(ErrorCode::FrameSize);
+
+					auto It = Streams.find(Id);
+					if (It == Streams.end())
+						return true;
+
+					uint32_t Dependency = DecodeUInt32(Data) & 0x7FFFFFFF;
+					if (Dependency == Id)
+						return Abort(It->second, ErrorCode::Protocol);
+
+					It->second->Dependency = Dependency;
+					It->second->Weight = (uint16_t)Data[4] + 1;
+					return true;
+				}
+				bool OnReset(uint32_t Id, size_t Length)
+				{
+					if (!Id || Id > LastStreamId)
+						return Fail(ErrorCode::Protocol);
+					else if (Length != 4)
+						return Fail(ErrorCode::FrameSize);
+
+					auto It = Streams.find(Id);
+					if (It != Streams.end())
+						Close(It->second, false);
+
+					return true;
+				}
+				bool OnSettings(uint8_t Flags, uint32_t Id, const uint8_t* Data, size_t Length)
+				{
+					if (Id != 0)
+						return Fail(ErrorCode::Protocol);
+
+					if (Flags & FlagAck)
+						return Length != 0 ? Fail(ErrorCode::FrameSize) : true;
+					else if (Length % 6 != 0)
+						return Fail(ErrorCode::FrameSize);
+
+					for (size_t i = 0; i < Length; i += 6)
+					{
+						uint16_t Key = (uint16_t)(((uint16_t)Data[i] << 8) | (uint16_t)Data[i + 1]);
+						uint32_t Value = DecodeUInt32(Data + i + 2);
+						switch (Key)
+						{
+							case 0x2:
+								if (Value > 1)
+									return Fail(ErrorCode::Protocol);
+								break;
+							case 0x4:
+							{
+								if (Value > 0x7FFFFFFF)
+									return Fail(ErrorCode::FlowControl);
+
+								int64_t Delta = (int64_t)Value - RemoteWindowSize;
+								RemoteWindowSize = (int64_t)Value;
+								for (auto& Item : Streams)
+								{
+									Item.second->Window += Delta;
+									if (Item.second->Window > 0x7FFFFFFF)
+										return Fail(ErrorCode::FlowControl);
+								}
+								break;
+							}
+							case 0x5:
+								if (Value < 16384 || Value > 16777215)
+									return Fail(ErrorCode::Protocol);
+								RemoteFrameSize = (size_t)Value;
+								break;
+							default:
+								break;
+						}
+					}
+
+					Configured = true;
+					Emit(FrameType::Settings, FlagAck, 0, nullptr, 0);
+					return true;
+				}
+				bool OnPing(uint8_t Flags, uint32_t Id, const uint8_t* Data, size_t Length)
+				{
+					if (Id != 0)
+						return Fail(ErrorCode::Protocol);
+					else if (Length != 8)
+						return Fail(ErrorCode::FrameSize);
+
+					if (!(Flags & FlagAck))
+						Emit(FrameType::Ping, FlagAck, 0, Data, Length);
+					return true;
+				}
+				bool OnGoAway(uint32_t Id, size_t Length)
+				{
+					if (Id != 0)
+						return Fail(ErrorCode::Protocol);
+					else if (Length < 8)
+						return Fail(ErrorCode::FrameSize);
+
+					GoingAway = true;
+					return true;
+				}
+				bool OnWindowUpdate(uint32_t Id, const uint8_t* Data, size_t Length)
+				{
+					if (Length != 4)
+						return Fail(ErrorCode::FrameSize);
+
+					uint32_t Increment = DecodeUInt32(Data) & 0x7FFFFFFF;
+					if (!Id)
+					{
+						if (!Increment)
+							return Fail(ErrorCode::Protocol);
+
+						Window += Increment;
+						return Window > 0x7FFFFFFF ? Fail(ErrorCode::FlowControl) : true;
+					}
+
+					auto It = Streams.find(Id);
+					if (It == Streams.end())
+						return true;
+					else if (!Increment)
+						return Abort(It->second, ErrorCode::Protocol);
+
+					It->second->Window += Increment;
+					if (It->second->Window > 0x7FFFFFFF)
+						return Abort(It->second, ErrorCode::FlowControl);
+
+					return true;
+				}
+				bool Complete()
+				{
+					uint32_t Id = BlockId;
+					uint8_t Flags = BlockFlags;
+					BlockId = 0;
+
+					Fields.clear();
+					if (!Decoder.Decode((uint8_t*)Block.data(), Block.size(), Router->MaxHeapBuffer, Fields))
+						return Fail(ErrorCode::Compression);
+
+					Block.clear();
+					auto It = Streams.find(Id);
+					if (It != Streams.end())
+					{
+						auto* Stream = It->second;
+						if (!(Flags & FlagEndStream) || Stream->Requested)
+							return Abort(Stream, ErrorCode::Protocol);
+						else if (Stream->Expected > 0)
+							return Abort(Stream, ErrorCode::Protocol);
+
+						Conclude(Stream);
+						Notify(Stream, true, false);
+						return true;
+					}
+					else if (Id <= LastStreamId)
+						return true;
+
+					LastStreamId = Id;
+					if (GoingAway)
+						return true;
+					else if (Streams.size() + Orphans >= Router->Http2.MaxConcurrentStreams)
+						return EmitReset(Id, ErrorCode::RefusedStream);
+
+					return Open(Id, Flags);
+				}
+				bool Open(uint32_t Id, uint8_t Flags)
+				{
+					std::string_view Method, Scheme, Authority, Path;
+					Core::String Cookies;
+					int64_t ContentLength = -1;
+					uint16_t Weight = BlockWeight;
+					bool Pseudo = true, Hostname = false;
+					for (auto& Item : Fields)
+					{
+						auto& Name = Item.first;
+						auto& Value = Item.second;
+						if (!IsValidValue(Value))
+							return EmitReset(Id, ErrorCode::Protocol);
+
+						if (!Name.empty() && Name.front() == ':')
+						{
+							if (!Pseudo)
+								return EmitReset(Id, ErrorCode::Protocol);
+							else if (Name == ":method")
+								Method = Value;
+							else if (Name == ":path")
+								Path = Value;
+							else if (Name == ":scheme")
+								Scheme = Value;
+							else if (Name == ":authority")
+								Authority = Value;
+							else
+								return EmitReset(Id, ErrorCode::Protocol);
+							continue;
+						}
+
+						Pseudo = false;
+						if (!IsValidName(Name))
+							return EmitReset(Id, ErrorCode::Protocol);
+						else if (Name == "connection" || Name == "keep-alive" || Name == "proxy-connection" || Name == "transfer-encoding" || Name == "upgrade")
+							return EmitReset(Id, ErrorCode::Protocol);
+						else if (Name == "te")
+							continue;
+
+						if (Name == "cookie")
+						{
+							if (!Cookies.empty())
+								Cookies.append("; ");
+							Cookies.append(Value);
+							continue;
+						}
+						else if (Name == "content-length")
+						{
+							auto Size = Core::FromString<uint64_t>(Value);
+							if (!Size || (ContentLength >= 0 && ContentLength != (int64_t)*Size))
+								return EmitReset(Id, ErrorCode::Protocol);
+							ContentLength = (int64_t)*Size;
+						}
+						else if (Name == "host")
+							Hostname = true;
+						else if (Name == "priority" && !Weight)
+						{
+							size_t Offset = Value.find("u=");
+							if (Offset != std::string::npos && Offset + 2 < Value.size() && Value[Offset + 2] >= '0' && Value[Offset + 2] <= '7')
+								Weight = (uint16_t)(256 >> (Value[Offset + 2] - '0'));
+						}
+					}
+
+					if (Method == "CONNECT")
+						return EmitReset(Id, ErrorCode::Http11Required);
+					else if (Method.empty() || Path.empty() || Scheme.empty() || !IsValidToken(Method) || !IsValidToken(Path))
+						return EmitReset(Id, ErrorCode::Protocol);
+					else if ((Flags & FlagEndStream) && ContentLength > 0)
+						return EmitReset(Id, ErrorCode::Protocol);
+
+					auto* Next = (Connection*)Base->Root->Pop(Base->Host);
+					if (!Next)
+						return EmitReset(Id, ErrorCode::RefusedStream);
+
+					auto* Stream = Core::Memory::New<Http2Stream>();
+					Stream->Id = Id;
+					Stream->Target = Next->Stream;
+					Stream->Window = RemoteWindowSize;
+					Stream->Receivable = LocalWindowSize;
+					Stream->Expected = ContentLength;
+					Stream->Dependency = BlockDependency != Id ? BlockDependency : 0;
+					Stream->Weight = Weight > 0 ? Weight : 16;
+					Stream->Pass = Clock;
+					Stream->Head = (Method == "HEAD");
+					Stream->Chunking = !(Flags & FlagEndStream) && ContentLength < 0;
+					Streams[Id] = Stream;
+
+					if (Flags & FlagEndStream)
+						Conclude(Stream);
+
+					auto* Resolver = Next->Resolver;
+					size_t Query = Path.find('?');
+					Next->Address = Base->Address;
+					Next->Info.Reuses = 0;
+					Next->Stream->SetIoTimeout(Router->SocketTimeout);
+					Next->Stream->MigrateToChannel(new Http2Channel(this, Id), false);
+					Resolver->PrepareForRequestParsing(&Next->Request);
+					Parsing::ParseMethodValue(Resolver, (uint8_t*)Method.data(), Method.size());
+					Parsing::ParseVersion(Resolver, (uint8_t*)"HTTP/1.1", 8);
+					if (Query != std::string::npos && Query + 1 < Path.size())
+						Parsing::ParseQueryValue(Resolver, (uint8_t*)Path.data() + Query + 1, Path.size() - Query - 1);
+					Parsing::ParsePathValue(Resolver, (uint8_t*)Path.data(), std::min(Query, Path.size()));
+					if (!Hostname && !Authority.empty())
+						Next->Request.SetHeader("Host", Authority);
+
+					for (auto& Item : Fields)
+					{
+						auto& Name = Item.first;
+						if (Name.front() == ':' || Name == "te" || Name == "cookie")
+							continue;
+
+						Parsing::ParseHeaderField(Resolver, (uint8_t*)Name.data(), Name.size());
+						Parsing::ParseHeaderValue(Resolver, (uint8_t*)Item.second.data(), Item.second.size());
+					}
+
+					if (!Cookies.empty())
+					{
+						Parsing::ParseHeaderField(Resolver, (uint8_t*)"cookie", 6);
+						Parsing::ParseHeaderValue(Resolver, (uint8_t*)Cookies.data(), Cookies.size());
+					}
+
+					if (Stream->Chunking)
+						Next->Request.SetHeader("Transfer-Encoding", "chunked");
+
+					Next->Info.Start = Network::Utils::Clock();
+					Next->Request.Content.Prepare(Next->Request.Headers, nullptr, 0);
+					AddRef();
+					Core::Codefer([this, Next, Id]()
+					{
+						if (IsActive(Id))
+							Next->Root->Dispatch(Next);
+						else
+							Next->Abort();
+						Release();
+					});
+					return true;
+				}
+				void Conclude(Http2Stream* Stream)
+				{
+					Stream->Requested = true;
+					if (Stream->Chunking && !Stream->Rejected)
+						Stream->Forward.append("0\r\n\r\n", 5);
+				}
+				void Restore(Http2Stream* Stream)
+				{
+					if (Stream->Credit > 0 && !Stream->Requested)
+					{
+						EmitWindowUpdate(Stream->Id, (uint32_t)Stream->Credit);
+						Stream->Receivable += Stream->Credit;
+					}
+					Stream->Credit = 0;
+				}
+				void Notify(Http2Stream* Stream, bool Readable, bool Writeable)
+				{
+					if (Stream->Target != nullptr)
+						Multiplexer::Get()->NotifyEvents(Stream->Target, Readable, Writeable);
+				}
+				Core::ExpectsIO<size_t> Read(uint32_t Id, uint8_t* Buffer, size_t Size)
+				{
+					Core::UMutex<std::recursive_mutex> Unique(Section);
+					auto It = Streams.find(Id);
+					if (Closed || It == Streams.end())
+						return std::make_error_condition(std::errc::connection_reset);
+
+					auto* Stream = It->second;
+					if (Stream->Forward.empty())
+						return std::make_error_condition(Stream->Requested ? std::errc::connection_reset : std::errc::operation_would_block);
+
+					size_t Count = std::min<size_t>(Size, Stream->Forward.size());
+					memcpy(Buffer, Stream->Forward.data(), Count);
+					Stream->Forward.erase(0, Count);
+					if (Stream->Forward.empty())
+					{
+						Restore(Stream);
+						Flush();
+					}
+
+					return Count;
+				}
+				Core::ExpectsIO<size_t> Write(uint32_t Id, const uint8_t* Buffer, size_t Size)
+				{
+					Core::UMutex<std::recursive_mutex> Unique(Section);
+					auto It = Streams.find(Id);
+					if (Closed || It == Streams.end() || It->second->Completed)
+						return std::make_error_condition(std::errc::connection_reset);
+
+					auto* Stream = It->second;
+					size_t Pending = Stream->Incoming.size() + Stream->Payload.size() - Stream->Offset;
+					if (Pending >= HTTP2_PAYLOAD_LIMIT)
+						return std::make_error_condition(std::errc::operation_would_block);
+
+					size_t Count = std::min<size_t>(Size, HTTP2_PAYLOAD_LIMIT - Pending);
+					Stream->Incoming.append((char*)Buffer, Count);
+					bool Aborted = (!Stream->Responded && Stream->Incoming.size() >= HTTP2_PAYLOAD_LIMIT ? Abort(Stream, ErrorCode::Internal) : !Respond(Stream, false));
+					Flush();
+					if (Aborted)
+						return std::make_error_condition(std::errc::connection_reset);
+
+					return Count;
+				}
+				void Detach(uint32_t Id)
+				{
+					Core::UMutex<std::recursive_mutex> Unique(Section);
+					auto It = Streams.find(Id);
+					if (Closed)
+						return;
+
+					if (It == Streams.end())
+					{
+						if (Orphans > 0)
+							--Orphans;
+						return;
+					}
+
+					auto* Stream = It->second;
+					Stream->Target = nullptr;
+					Stream->Rejected = true;
+					Stream->Forward.clear();
+					Restore(Stream);
+					Respond(Stream, true);
+					Flush();
+				}
+				bool IsReadable(uint32_t Id)
+				{
+					Core::UMutex<std::recursive_mutex> Unique(Section);
+					auto It = Streams.find(Id);
+					if (Closed || It == Streams.end())
+						return true;
+
+					return !It->second->Forward.empty() || It->second->Requested;
+				}
+				bool IsActive(uint32_t Id)
+				{
+					Core::UMutex<std::recursive_mutex> Unique(Section);
+					return !Closed && Streams.find(Id) != Streams.end();
+				}
+				bool IsWriteable(uint32_t Id)
+				{
+					Core::UMutex<std::recursive_mutex> Unique(Section);
+					auto It = Streams.find(Id);
+					if (Closed || It == Streams.end())
+						return true;
+
+					auto* Stream = It->second;
+					return Stream->Incoming.size() + Stream->Payload.size() - Stream->Offset < HTTP2_PAYLOAD_LIMIT;
+				}
+				bool Respond(Http2Stream* Stream, bool Ended)
+				{
+					while (!Stream->Responded)
+					{
+						int64_t Offset = -2;
+						if (!Stream->Incoming.empty())
+						{
+							Resolver->PrepareForResponseParsing(&Stream->Response);
+							Offset = Resolver->ParseResponse((uint8_t*)Stream->Incoming.data(), Stream->Incoming.size(), 0);
+						}
+
+						if (Offset == -2 && !Ended)
+							return true;
+						else if (Offset < 0)
+							return !Abort(Stream, ErrorCode::Internal);
+
+						Stream->Incoming.erase(0, (size_t)Offset);
+						if (Stream->Response.StatusCode >= 200)
+							Headers(Stream);
+						else
+							Stream->Response.Headers.clear();
+					}
+
+					if (Stream->Completed)
+						return true;
+
+					if (Stream->Streaming)
+					{
+						size_t Size = Stream->Incoming.size();
+						int64_t Result = -2;
+						if (Size > 0)
+						{
+							Resolver->Chunked = Stream->Chunked;
+							Result = Resolver->ParseDecodeChunked((uint8_t*)Stream->Incoming.data(), &Size);
+							Stream->Chunked = Resolver->Chunked;
+							if (Result == -1)
+								return !Abort(Stream, ErrorCode::Internal);
+						}
+
+						Stream->Payload.append(Stream->Incoming.data(), Size);
+						Stream->Incoming.clear();
+						if (Result >= 0)
+							Stream->Completed = true;
+						else if (Ended)
+							return !Abort(Stream, ErrorCode::Internal);
+					}
+					else if (Stream->Remaining >= 0)
+					{
+						size_t Size = std::min<size_t>(Stream->Incoming.size(), (size_t)Stream->Remaining);
+						Stream->Payload.append(Stream->Incoming.data(), Size);
+						Stream->Remaining -= Size;
+						Stream->Incoming.clear();
+						if (!Stream->Remaining)
+							Stream->Completed = true;
+						else if (Ended)
+							return !Abort(Stream, ErrorCode::Internal);
+					}
+					else
+					{
+						Stream->Payload.append(Stream->Incoming);
+						Stream->Incoming.clear();
+						if (Ended)
+							Stream->Completed = true;
+					}
+
+					return true;
+				}
+				void Headers(Http2Stream* Stream)
+				{
+					auto& Response = Stream->Response;
+					auto TransferEncoding = Response.GetHeader("Transfer-Encoding");
+					auto ContentLength = Response.GetHeader("Content-Length");
+					Stream->Responded = true;
+					if (Stream->Head || Response.StatusCode == 204 || Response.StatusCode == 304)
+						Stream->Remaining = 0;
+					else if (Core::Stringify::CaseEquals(TransferEncoding, "chunked"))
+						Stream->Streaming = true;
+					else if (!ContentLength.empty())
+						Stream->Remaining = (int64_t)Core::FromString<uint64_t>(ContentLength).Or(0);
+
+					Core::String Block;
+					HpackCodec::EncodeStatus(Block, Response.StatusCode);
+					for (auto& Item : Response.Headers)
+					{
+						Core::String Name = Item.first;
+						Core::Stringify::ToLower(Name);
+						if (Name == "connection" || Name == "keep-alive" || Name == "proxy-connection" || Name == "transfer-encoding" || Name == "upgrade")
+							continue;
+
+						for (auto& Value : Item.second)
+							HpackCodec::Encode(Block, Name, Value);
+					}
+
+					bool Finished = !Stream->Streaming && !Stream->Remaining;
+					size_t Offset = 0;
+					do
+					{
+						size_t Size = std::min<size_t>(Block.size() - Offset, RemoteFrameSize);
+						uint8_t Flags = (Offset + Size == Block.size() ? FlagEndHeaders : 0);
+						if (!Offset && Finished)
+							Flags |= FlagEndStream;
+
+						Emit(Offset > 0 ? FrameType::Continuation : FrameType::Headers, Flags, Stream->Id, Block.data() + Offset, Size);
+						Offset += Size;
+					} while (Offset < Block.size());
+
+					if (Finished)
+						Stream->Completed = Stream->Finished = true;
+				}
+				void Schedule()
+				{
+					while (Output.size() < HTTP2_WRITE_LIMIT)
+					{
+						Http2Stream* Next = nullptr;
+						bool Deferred = true;
+						for (auto& Item : Streams)
+						{
+							auto* Stream = Item.second;
+							if (!Stream->Responded)
+								continue;
+
+							size_t Pending = Stream->Payload.size() - Stream->Offset;
+							if (!Pending)
+							{
+								if (!Stream->Completed)
+									continue;
+
+								Next = Stream;
+								Deferred = false;
+								break;
+							}
+							else if (Window <= 0 || Stream->Window <= 0)
+								continue;
+
+							bool Waiting = IsWaiting(Stream);
+							if (!Next || (Deferred && !Waiting) || (Deferred == Waiting && Stream->Pass < Next->Pass))
+							{
+								Next = Stream;
+								Deferred = Waiting;
+							}
+						}
+
+						if (!Next)
+							break;
+						else if (Next->Finished)
+						{
+							Close(Next, true);
+							continue;
+						}
+
+						size_t Pending = Next->Payload.size() - Next->Offset;
+						size_t Size = std::min<size_t>({ Pending, RemoteFrameSize, (size_t)std::max<int64_t>(Window, 0), (size_t)std::max<int64_t>(Next->Window, 0) });
+						bool Finished = Next->Completed && Size == Pending;
+						Emit(FrameType::Data, Finished ? FlagEndStream : 0, Next->Id, Next->Payload.data() + Next->Offset, Size);
+						Window -= Size;
+						Next->Window -= Size;
+						Next->Offset += Size;
+						if (Next->Offset == Next->Payload.size())
+						{
+							Next->Payload.clear();
+							Next->Offset = 0;
+						}
+
+						Clock = std::max(Clock, Next->Pass);
+						Next->Pass += (uint64_t)(Size + 1) * 256 / Next->Weight;
+						if (Finished)
+							Close(Next, true);
+						else if (Pending - Size < HTTP2_PAYLOAD_LIMIT)
+							Notify(Next, false, true);
+					}
+				}
+				void Flush()
+				{
+					while (!Sending && !Closed)
+					{
+						Schedule();
+						if (Output.empty())
+						{
+							if (GoingAway && Streams.empty())
+								Teardown();
+							return;
+						}
+
+						Writing.swap(Output);
+						Output.clear();
+						Sending = true;
+
+						AddRef();
+						Base->Stream->WriteQueued((uint8_t*)Writing.data(), Writing.size(), [this](SocketPoll Event)
+						{
+							{
+								Core::UMutex<std::recursive_mutex> Unique(Section);
+								Sending = false;
+								Writing.clear();
+								if (Closed)
+									;
+								else if (!Packet::IsDone(Event))
+									Teardown();
+								else if (Packet::IsDoneAsync(Event))
+									Flush();
+							}
+							Release();
+						}, false);
+					}
+				}
+				void Close(Http2Stream* Stream, bool Gracefully)
+				{
+					if (Gracefully && !Stream->Requested)
+						EmitReset(Stream->Id, ErrorCode::None);
+
+					if (Stream->Target != nullptr)
+					{
+						Multiplexer::Get()->CancelEvents(Stream->Target, SocketPoll::Reset);
+						++Orphans;
+					}
+
+					Streams.erase(Stream->Id);
+					Core::Memory::Delete(Stream);
+				}
+				bool Abort(Http2Stream* Stream, ErrorCode Code)
+				{
+					EmitReset(Stream->Id, Code);
+					Close(Stream, false);
+					return true;
+				}
+				bool Fail(ErrorCode Code)
+				{
+					if (!Failed)
+					{
+						uint8_t Data[8];
+						EncodeUInt32(Data + 0, LastStreamId);
+						EncodeUInt32(Data + 4, (uint32_t)Code);
+						Emit(FrameType::GoAway, 0, 0, Data, sizeof(Data));
+					}
+
+					while (!Streams.empty())
+						Close(Streams.begin()->second, false);
+
+					Input.clear();
+					GoingAway = true;
+					Failed = true;
+					return false;
+				}
+				void Shutdown()
+				{
+					uint8_t Data[8];
+					EncodeUInt32(Data + 0, LastStreamId);
+					EncodeUInt32(Data + 4, (uint32_t)ErrorCode::None);
+					Emit(FrameType::GoAway, 0, 0, Data, sizeof(Data));
+					GoingAway = true;
+				}
+				void Teardown()
+				{
+					if (Closed)
+						return;
+
+					Closed = true;
+					while (!Streams.empty())
+						Close(Streams.begin()->second, false);
+
+					auto* Target = Base;
+					Base = nullptr;
+					Target->Stream->ClearEvents(true);
+					Target->Abort();
+					Release();
+				}
+				bool IsWaiting(Http2Stream* Stream)
+				{
+					if (!Stream->Dependency)
+						return false;
+
+					auto It = Streams.find(Stream->Dependency);
+					if (It == Streams.end())
+						return false;
+
+					auto* Parent = It->second;
+					return Parent->Responded && Parent->Window > 0 && Parent->Payload.size() > Parent->Offset;
+				}
+				void Emit(FrameType Type, uint8_t Flags, uint32_t Id, const void* Data, size_t Size)
+				{
+					uint8_t Header[9];
+					Header[0] = (uint8_t)(Size >> 16);
+					Header[1] = (uint8_t)(Size >> 8);
+					Header[2] = (uint8_t)Size;
+					Header[3] = (uint8_t)Type;
+					Header[4] = Flags;
+					EncodeUInt32(Header + 5, Id & 0x7FFFFFFF);
+					Output.append((char*)Header, sizeof(Header));
+					if (Size > 0)
+						Output.append((char*)Data, Size);
+				}
+				bool EmitReset(uint32_t Id, ErrorCode Code)
+				{
+					uint8_t Data[4];
+					EncodeUInt32(Data, (uint32_t)Code);
+					Emit(FrameType::Reset, 0, Id, Data, sizeof(Data));
+					return true;
+				}
+				void EmitWindowUpdate(uint32_t Id, uint32_t Increment)
+				{
+					uint8_t Data[4];
+					EncodeUInt32(Data, Increment & 0x7FFFFFFF);
+					Emit(FrameType::WindowUpdate, 0, Id, Data, sizeof(Data));
 				}
+				static bool IsValidName(const std::string_view& Name)
+				{
+					if (Name.empty())
+						return false;
 
-				if (Base->Route->Callbacks.Headers)
-					Base->Route->Callbacks.Headers(Base, *Content);
+					for (char Next : Name)
+					{
+						if (Next <= ' ' || Next == ':' || Next == 0x7F || (Next >= 'A' && Next <= 'Z'))
+							return false;
+					}
 
-				Content->append("\r\n", 2);
-				return !!Base->Stream->WriteQueued((uint8_t*)Content->c_str(), Content->size(), [Content, Base](SocketPoll Event)
+					return true;
+				}
+				static bool IsValidValue(const std::string_view& Value)
 				{
-					HrmCache::Get()->Push(Content);
-					if (Packet::IsDone(Event))
+					for (char Next : Value)
 					{
-						Base->WebSocket = new WebSocketFrame(Base->Stream, Base);
-						Base->WebSocket->Connect = Base->Route->Callbacks.WebSocket.Connect;
-						Base->WebSocket->Receive = Base->Route->Callbacks.WebSocket.Receive;
-						Base->WebSocket->Disconnect = Base->Route->Callbacks.WebSocket.Disconnect;
-						Base->WebSocket->Lifetime.Dead = [Base](WebSocketFrame*)
-						{
-							return Base->Info.Abort;
-						};
-						Base->WebSocket->Lifetime.Close = [Base](WebSocketFrame*, bool Successful)
-						{
-							if (Successful)
-								Base->Next();
-							else
-								Base->Abort();
-						};
+						if (Next == '\r' || Next == '\n' || Next == '\0')
+							return false;
+					}
 
-						Base->Stream->SetIoTimeout(Base->Route->WebSocketTimeout);
-						if (!Base->Route->Callbacks.WebSocket.Initiate || !Base->Route->Callbacks.WebSocket.Initiate(Base))
-							Base->WebSocket->Next();
+					return true;
+				}
+				static bool IsValidToken(const std::string_view& Value)
+				{
+					for (char Next : Value)
+					{
+						if ((uint8_t)Next <= ' ' || Next == 0x7F)
+							return false;
 					}
-					else if (Packet::IsError(Event))
-						Base->Abort();
-				}, false);
+
+					return true;
+				}
+				static void EncodeSetting(uint8_t* Data, uint16_t Key, uint32_t Value)
+				{
+					Data[0] = (uint8_t)(Key >> 8);
+					Data[1] = (uint8_t)Key;
+					EncodeUInt32(Data + 2, Value);
+				}
+				static void EncodeUInt32(uint8_t* Data, uint32_t Value)
+				{
+					Data[0] = (uint8_t)(Value >> 24);
+					Data[1] = (uint8_t)(Value >> 16);
+					Data[2] = (uint8_t)(Value >> 8);
+					Data[3] = (uint8_t)Value;
+				}
+				static uint32_t DecodeUInt32(const uint8_t* Data)
+				{
+					return ((uint32_t)Data[0] << 24) | ((uint32_t)Data[1] << 16) | ((uint32_t)Data[2] << 8) | (uint32_t)Data[3];
+				}
+			};
+
+			Http2Channel::Http2Channel(Http2Session* NewSession, uint32_t NewId) : Session(NewSession), Id(NewId)
+			{
+				Session->AddRef();
+			}
+			Http2Channel::~Http2Channel() noexcept
+			{
+				Session->Release();
+			}
+			Core::ExpectsIO<size_t> Http2Channel::Read(uint8_t* Buffer, size_t Size)
+			{
+				return Session->Read(Id, Buffer, Size);
+			}
+			Core::ExpectsIO<size_t> Http2Channel::Write(const uint8_t* Buffer, size_t Size)
+			{
+				return Session->Write(Id, Buffer, Size);
+			}
+			void Http2Channel::Detach()
+			{
+				Session->Detach(Id);
+			}
+			bool Http2Channel::IsReadable()
+			{
+				return Session->IsReadable(Id);
+			}
+			bool Http2Channel::IsWriteable()
+			{
+				return Session->IsWriteable(Id);
 			}
 
 			Server::Server() : SocketServer()
 			{
 				HrmCache::LinkInstance();
+				FileCache::LinkInstance();
+				VariantCache::LinkInstance();
 			}
 			Server::~Server()
 			{
@@ -5884,6 +8964,11 @@ namespace Vitex
 						return Core::SystemException("session directory: invalid path", std::move(Status.Error()));
 				}
 
+				if (!Target->Session.Store && !Target->Session.Directory.empty() && !Target->Session.WriteBehind)
+					Target->Session.Store = new FileSessionStore(Target->Session.Directory);
+				else if (!Target->Session.Store)
+					Target->Session.Store = new MemorySessionStore(Target->Session.MaxEntries, 16, Target->Session.Directory.empty() ? nullptr : new FileSessionStore(Target->Session.Directory));
+
 				if (!Target->TemporaryDirectory.empty())
 				{
 					auto Directory = Core::OS::Path::Resolve(Target->TemporaryDirectory);
@@ -5912,6 +8997,132 @@ namespace Vitex
 				Target->Sort();
 				return Core::Expectation::Met;
 			}
+			bool Server::Subscribe(const std::string_view& Topic, WebSocketFrame* Frame, BroadcastPolicy Policy, size_t MaxBacklog)
+			{
+				VI_ASSERT(!Topic.empty(), "topic should not be empty");
+				VI_ASSERT(Frame != nullptr, "websocket frame should be set");
+				if (Frame->IsIgnore())
+					return false;
+
+				Subscription Target;
+				Target.Policy = Policy;
+				Target.MaxBacklog = MaxBacklog;
+
+				Core::UMutex<std::mutex> Unique(Exclusive);
+				auto& Topical = Topics[Core::String(Topic)];
+				if (Topical.find(Frame) != Topical.end())
+					return false;
+
+				Topical[Frame] = Target;
+				Subscribers[Frame].insert(Core::String(Topic));
+				return true;
+			}
+			bool Server::Unsubscribe(const std::string_view& Topic, WebSocketFrame* Frame)
+			{
+				VI_ASSERT(Frame != nullptr, "websocket frame should be set");
+				Core::UMutex<std::mutex> Unique(Exclusive);
+				auto It = Topics.find(Core::KeyLookupCast(Topic));
+				if (It == Topics.end() || !It->second.erase(Frame))
+					return false;
+
+				if (It->second.empty())
+					Topics.erase(It);
+
+				auto Next = Subscribers.find(Frame);
+				if (Next != Subscribers.end())
+				{
+					auto Name = Next->second.find(Core::KeyLookupCast(Topic));
+					if (Name != Next->second.end())
+						Next->second.erase(Name);
+					if (Next->second.empty())
+						Subscribers.erase(Next);
+				}
+
+				return true;
+			}
+			void Server::Unsubscribe(WebSocketFrame* Frame)
+			{
+				VI_ASSERT(Frame != nullptr, "websocket frame should be set");
+				Core::UMutex<std::mutex> Unique(Exclusive);
+				auto Next = Subscribers.find(Frame);
+				if (Next == Subscribers.end())
+					return;
+
+				for (auto& Topic : Next->second)
+				{
+					auto It = Topics.find(Topic);
+					if (It == Topics.end())
+						continue;
+
+					It->second.erase(Frame);
+					if (It->second.empty())
+						Topics.erase(It);
+				}
+				Subscribers.erase(Next);
+			}
+			size_t Server::Publish(const std::string_view& Topic, const std::string_view& Buffer, WebSocketOp Opcode)
+			{
+				Core::Vector<std::pair<WebSocketFrame*, Subscription>> Targets;
+				{
+					Core::UMutex<std::mutex> Unique(Exclusive);
+					auto It = Topics.find(Core::KeyLookupCast(Topic));
+					if (It == Topics.end() || It->second.empty())
+						return 0;
+
+					Targets.reserve(It->second.size());
+					for (auto& Item : It->second)
+					{
+						Item.first->AddRef();
+						Targets.emplace_back(Item.first, Item.second);
+					}
+				}
+
+				uint8_t Header[10];
+				size_t HeaderLength = 2;
+				Header[0] = 0x80 + ((size_t)Opcode & 0xF);
+				if (Buffer.size() < 126)
+				{
+					Header[1] = (uint8_t)Buffer.size();
+				}
+				else if (Buffer.size() <= 65535)
+				{
+					uint16_t Length = htons((uint16_t)Buffer.size());
+					Header[1] = 126;
+					HeaderLength = 4;
+					memcpy(Header + 2, &Length, 2);
+				}
+				else
+				{
+					uint32_t Length1 = htonl((uint64_t)Buffer.size() >> 32);
+					uint32_t Length2 = htonl((uint64_t)Buffer.size() & 0xFFFFFFFF);
+					Header[1] = 127;
+					HeaderLength = 10;
+					memcpy(Header + 2, &Length1, 4);
+					memcpy(Header + 6, &Length2, 4);
+				}
+
+				SharedFrame* Frame = Core::Memory::New<SharedFrame>();
+				Frame->Data.reserve(HeaderLength + Buffer.size());
+				Frame->Data.append((char*)Header, HeaderLength);
+				Frame->Data.append(Buffer.data(), Buffer.size());
+
+				size_t Delivered = 0;
+				for (auto& Target : Targets)
+				{
+					if (Target.first->Broadcast(Frame, Target.second.Policy, Target.second.MaxBacklog))
+						++Delivered;
+					Target.first->Release();
+				}
+
+				Frame->Release();
+				return Delivered;
+			}
+			size_t Server::GetSubscribers(const std::string_view& Topic)
+			{
+				Core::UMutex<std::mutex> Unique(Exclusive);
+				auto It = Topics.find(Core::KeyLookupCast(Topic));
+				return It != Topics.end() ? It->second.size() : 0;
+			}
 			Core::ExpectsSystem<void> Server::UpdateRoute(RouterEntry* Route)
 			{
 				Route->Router = (MapRouter*)Router;
@@ -5931,11 +9142,122 @@ namespace Vitex
 
 				return Core::Expectation::Met;
 			}
+			bool Server::Dispatch(Connection* Base)
+			{
+				VI_ASSERT(Base != nullptr, "connection should be set");
+				Core::MemoryScope Scope(Core::MemoryTag::Network);
+				auto* Conf = (MapRouter*)Router;
+				uint32_t Redirects = 0;
+			Redirect:
+				if (!Paths::ConstructRoute(Conf, Base))
+					return Base->Abort(400, "Request cannot be resolved");
+
+				auto* Route = Base->Route;
+				if (!Route->Redirect.empty())
+				{
+					if (Redirects++ > HTTP_MAX_REDIRECTS)
+						return Base->Abort(500, "Infinite redirects loop detected");
+
+					Base->Request.Location = Route->Redirect;
+					goto Redirect;
+				}
+
+				Paths::ConstructPath(Base);
+				if (!Permissions::MethodAllowed(Base))
+					return Base->Abort(405, "Requested method \"%s\" is not allowed on this server", Base->Request.Method);
+
+				if (!memcmp(Base->Request.Method, "GET", 3) || !memcmp(Base->Request.Method, "HEAD", 4))
+				{
+					if (!Permissions::Authorize(Base))
+						return false;
+
+					if (Route->Callbacks.Get && Route->Callbacks.Get(Base))
+						return true;
+
+					return Routing::RouteGet(Base);
+				}
+				else if (!memcmp(Base->Request.Method, "POST", 4))
+				{
+					if (!Permissions::Authorize(Base))
+						return false;
+
+					if (Route->Callbacks.Post && Route->Callbacks.Post(Base))
+						return true;
+
+					return Routing::RoutePost(Base);
+				}
+				else if (!memcmp(Base->Request.Method, "PUT", 3))
+				{
+					if (!Permissions::Authorize(Base))
+						return false;
+
+					if (Route->Callbacks.Put && Route->Callbacks.Put(Base))
+						return true;
+
+					return Routing::RoutePut(Base);
+				}
+				else if (!memcmp(Base->Request.Method, "PATCH", 5))
+				{
+					if (!Permissions::Authorize(Base))
+						return false;
+
+					if (Route->Callbacks.Patch && Route->Callbacks.Patch(Base))
+						return true;
+
+					return Routing::RoutePatch(Base);
+				}
+				else if (!memcmp(Base->Request.Method, "DELETE", 6))
+				{
+					if (!Permissions::Authorize(Base))
+						return false;
+
+					if (Route->Callbacks.Delete && Route->Callbacks.Delete(Base))
+						return true;
+
+					return Routing::RouteDelete(Base);
+				}
+				else if (!memcmp(Base->Request.Method, "OPTIONS", 7))
+				{
+					if (Route->Callbacks.Options && Route->Callbacks.Options(Base))
+						return true;
+
+					return Routing::RouteOptions(Base);
+				}
+
+				if (!Permissions::Authorize(Base))
+					return false;
+
+				return Base->Abort(405, "Request method \"%s\" is not allowed", Base->Request.Method);
+			}
 			Core::ExpectsSystem<void> Server::OnConfigure(SocketRouter* NewRouter)
 			{
 				VI_ASSERT(NewRouter != nullptr, "router should be set");
 				return Update();
 			}
+			Core::ExpectsSystem<void> Server::OnListen()
+			{
+				VI_ASSERT(Router != nullptr, "router should be set");
+#ifdef VI_OPENSSL
+				MapRouter* Target = (MapRouter*)Router;
+				for (auto& Item : Target->Certificates)
+				{
+					if (!Item.second.Context)
+						continue;
+
+					SSL_CTX_set_alpn_select_cb(Item.second.Context, [](SSL*, const unsigned char** Output, unsigned char* OutputSize, const unsigned char* Input, unsigned int InputSize, void* Enabled) -> int
+					{
+						static const unsigned char Protocols[] = "\x02h2\x08http/1.1";
+						const unsigned char* Offer = Enabled ? Protocols : Protocols + 3;
+						unsigned int OfferSize = (unsigned int)(Enabled ? sizeof(Protocols) - 1 : sizeof(Protocols) - 4);
+						if (SSL_select_next_proto((unsigned char**)Output, OutputSize, Offer, OfferSize, Input, InputSize) != OPENSSL_NPN_NEGOTIATED)
+							return SSL_TLSEXT_ERR_NOACK;
+
+						return SSL_TLSEXT_ERR_OK;
+					}, Target->Http2.Enabled ? (void*)Target : nullptr);
+				}
+#endif
+				return Core::Expectation::Met;
+			}
 			Core::ExpectsSystem<void> Server::OnUnlisten()
 			{
 				VI_ASSERT(Router != nullptr, "router should be set");
@@ -5954,16 +9276,19 @@ namespace Vitex
 						return Status;
 				}
 
+				FileCache::Get()->Clear();
+				VariantCache::Get()->Clear();
 				return Core::Expectation::Met;
 			}
 			void Server::OnRequestOpen(SocketConnection* Source)
 			{
 				VI_ASSERT(Source != nullptr, "connection should be set");
+				Core::MemoryScope Scope(Core::MemoryTag::Network);
 				auto* Conf = (MapRouter*)Router;
 				auto* Base = (Connection*)Source;
 
 				Base->Resolver->PrepareForRequestParsing(&Base->Request);
-				Base->Stream->ReadUntilChunkedQueued("\r\n\r\n", [Base, Conf](SocketPoll Event, const uint8_t* Buffer, size_t Size)
+				SocketReadCallback Callback = [Base, Conf](SocketPoll Event, const uint8_t* Buffer, size_t Size)
 				{
 					if (Packet::IsData(Event))
 					{
@@ -5984,95 +9309,64 @@ namespace Vitex
 					}
 					else if (Packet::IsDone(Event))
 					{
-						uint32_t Redirects = 0;
-						Base->Info.Start = Network::Utils::Clock();
-						Base->Request.Content.Prepare(Base->Request.Headers, Buffer, Size);
-					Redirect:
-						if (!Paths::ConstructRoute(Conf, Base))
-							return Base->Abort(400, "Request cannot be resolved");
-
-						auto* Route = Base->Route;
-						if (!Route->Redirect.empty())
-						{
-							if (Redirects++ > HTTP_MAX_REDIRECTS)
-								return Base->Abort(500, "Infinite redirects loop detected");
-
-							Base->Request.Location = Route->Redirect;
-							goto Redirect;
-						}
-
-						Paths::ConstructPath(Base);
-						if (!Permissions::MethodAllowed(Base))
-							return Base->Abort(405, "Requested method \"%s\" is not allowed on this server", Base->Request.Method);
-
-						if (!memcmp(Base->Request.Method, "GET", 3) || !memcmp(Base->Request.Method, "HEAD", 4))
-						{
-							if (!Permissions::Authorize(Base))
-								return false;
-
-							if (Route->Callbacks.Get && Route->Callbacks.Get(Base))
-								return true;
-
-							return Routing::RouteGet(Base);
-						}
-						else if (!memcmp(Base->Request.Method, "POST", 4))
+						if (!memcmp(Base->Request.Version, "HTTP/2", 6))
 						{
-							if (!Permissions::Authorize(Base))
-								return false;
-
-							if (Route->Callbacks.Post && Route->Callbacks.Post(Base))
-								return true;
+							if (!Conf->Http2.Enabled || memcmp(Base->Request.Method, "PRI", 4) != 0 || Base->Request.Location != "*")
+								return Base->Abort(400, "HTTP/2 upgrade is not supported");
 
-							return Routing::RoutePost(Base);
+							auto* Session = Core::Memory::New<Http2Session>(Base);
+							Session->Begin(Buffer, Size);
+							return true;
 						}
-						else if (!memcmp(Base->Request.Method, "PUT", 3))
-						{
-							if (!Permissions::Authorize(Base))
-								return false;
-
-							if (Route->Callbacks.Put && Route->Callbacks.Put(Base))
-								return true;
 
-							return Routing::RoutePut(Base);
-						}
-						else if (!memcmp(Base->Request.Method, "PATCH", 5))
+						size_t Length = Size;
+						if (Buffer != nullptr && Base->Request.GetHeader("Upgrade").empty())
 						{
-							if (!Permissions::Authorize(Base))
-								return false;
-
-							if (Route->Callbacks.Patch && Route->Callbacks.Patch(Base))
-								return true;
-
-							return Routing::RoutePatch(Base);
+							auto ContentLength = Base->Request.GetHeader("Content-Length");
+							if (!ContentLength.empty())
+								Length = std::min<size_t>(Size, strtoull(ContentLength.data(), nullptr, 10));
+							else if (!Core::Stringify::CaseEquals(Base->Request.GetHeader("Transfer-Encoding"), "chunked"))
+								Length = 0;
+
+							if (Length < Size)
+								Base->Pipeline.assign((char*)Buffer + Length, Size - Length);
 						}
-						else if (!memcmp(Base->Request.Method, "DELETE", 6))
-						{
-							if (!Permissions::Authorize(Base))
-								return false;
 
-							if (Route->Callbacks.Delete && Route->Callbacks.Delete(Base))
-								return true;
+						Base->Info.Start = Network::Utils::Clock();
+						Base->Request.Content.Prepare(Base->Request.Headers, Buffer, Length);
+						return Base->Root->Dispatch(Base);
+					}
+					else if (Packet::IsError(Event))
+						Base->Abort();
 
-							return Routing::RouteDelete(Base);
-						}
-						else if (!memcmp(Base->Request.Method, "OPTIONS", 7))
-						{
-							if (Route->Callbacks.Options && Route->Callbacks.Options(Base))
-								return true;
+					return true;
+				};
 
-							return Routing::RouteOptions(Base);
-						}
+				size_t Matched = 0;
+				if (!Base->Pipeline.empty())
+				{
+					Core::String Pipeline = std::move(Base->Pipeline);
+					Base->Pipeline.clear();
 
-						if (!Permissions::Authorize(Base))
-							return false;
+					size_t Offset = Pipeline.find("\r\n\r\n");
+					if (Offset != Core::String::npos)
+					{
+						Offset += 4;
+						if (Callback(SocketPoll::Next, (uint8_t*)Pipeline.data(), Offset))
+							Callback(SocketPoll::FinishSync, Offset < Pipeline.size() ? (uint8_t*)Pipeline.data() + Offset : nullptr, Pipeline.size() - Offset);
+						return;
+					}
+					else if (!Callback(SocketPoll::Next, (uint8_t*)Pipeline.data(), Pipeline.size()))
+						return;
 
-						return Base->Abort(405, "Request method \"%s\" is not allowed", Base->Request.Method);
+					for (Matched = std::min<size_t>(Pipeline.size(), 3); Matched > 0; Matched--)
+					{
+						if (!memcmp(Pipeline.data() + Pipeline.size() - Matched, "\r\n\r\n", Matched))
+							break;
 					}
-					else if (Packet::IsError(Event))
-						Base->Abort();
+				}
 
-					return true;
-				});
+				Base->Stream->ReadUntilChunkedQueued("\r\n\r\n", std::move(Callback), Matched);
 			}
 			bool Server::OnRequestCleanup(SocketConnection* Target)
 			{
@@ -6170,6 +9464,9 @@ namespace Vitex
 						int64_t Subresult = Resolver->ParseDecodeChunked((uint8_t*)Response.Content.Data.data(), &DecodedSize);
 						if (Subresult >= 0 || Subresult == -2)
 						{
+							if (Subresult > 0)
+								Pipeline.assign(Response.Content.Data.data() + DecodedSize, (size_t)Subresult);
+
 							LeftoverSize -= DecodedSize;
 							if (LeftoverSize > 0)
 								Response.Content.Data.erase(Response.Content.Data.begin() + DecodedSize, Response.Content.Data.begin() + DecodedSize + LeftoverSize);
@@ -6202,6 +9499,8 @@ namespace Vitex
 							Subresult = Resolver->ParseDecodeChunked((uint8_t*)Buffer, &Recv);
 							if (Subresult == -1)
 								return false;
+							else if (Subresult > 0)
+								Pipeline.assign((char*)Buffer + Recv, (size_t)Subresult);
 
 							Response.Content.Offset += Recv;
 							if (!Eat)
@@ -6298,6 +9597,14 @@ namespace Vitex
 				return Result;
 			}
 			Core::ExpectsPromiseSystem<void> Client::Upgrade(HTTP::RequestFrame&& Target)
+			{
+				return Handshake(std::move(Target), nullptr);
+			}
+			Core::ExpectsPromiseSystem<void> Client::Upgrade(HTTP::RequestFrame&& Target, const WebSocketDeflate& Deflate)
+			{
+				return Handshake(std::move(Target), &Deflate);
+			}
+			Core::ExpectsPromiseSystem<void> Client::Handshake(HTTP::RequestFrame&& Target, const WebSocketDeflate* Deflate)
 			{
 				VI_ASSERT(WebSocket != nullptr, "websocket should be opened");
 				if (!HasStream())
@@ -6313,8 +9620,12 @@ namespace Vitex
 					Target.SetHeader("Sec-WebSocket-Key", Compute::Codec::Base64Encode(*Random));
 				else
 					Target.SetHeader("Sec-WebSocket-Key", HTTP_WEBSOCKET_KEY);
-	
-				return Send(std::move(Target)).Then<Core::ExpectsPromiseSystem<void>>([this](Core::ExpectsSystem<void>&& Status) -> Core::ExpectsPromiseSystem<void>
+#ifdef VI_ZLIB
+				if (Deflate != nullptr)
+					Target.SetHeader("Sec-WebSocket-Extensions", OfferDeflate(*Deflate));
+#endif
+				WebSocketDeflate Policy = (Deflate ? *Deflate : WebSocketDeflate());
+				return Send(std::move(Target)).Then<Core::ExpectsPromiseSystem<void>>([this, Policy](Core::ExpectsSystem<void>&& Status) -> Core::ExpectsPromiseSystem<void>
 				{
 					VI_DEBUG("[ws] handshake %s", Request.Location.c_str());
 					if (!Status)
@@ -6326,6 +9637,14 @@ namespace Vitex
 					if (Response.GetHeader("Sec-WebSocket-Accept").empty())
 						return Core::ExpectsPromiseSystem<void>(Core::SystemException("upgrade handshake accept error", std::make_error_condition(std::errc::bad_message)));
 
+					auto Extensions = Response.GetHeader("Sec-WebSocket-Extensions");
+					if (!Extensions.empty() && Core::Stringify::Find(Extensions, "permessage-deflate").Found)
+					{
+						WebSocketDeflate Deflate;
+						if (Request.GetHeader("Sec-WebSocket-Extensions").empty() || !NegotiateDeflate(Extensions, Policy, false, &Deflate, nullptr) || !WebSocket->SetDeflate(Deflate))
+							return Core::ExpectsPromiseSystem<void>(Core::SystemException("upgrade handshake extension error", std::make_error_condition(std::errc::protocol_error)));
+					}
+
 					Future = Core::ExpectsPromiseSystem<void>();
 					WebSocket->Next();
 					return Future;
@@ -6340,6 +9659,8 @@ namespace Vitex
 				VI_DEBUG("[http] %s %s", Target.Method, Target.Location.c_str());
 				if (!Response.Content.IsFinalized() || Response.Content.Exceeds)
 					return Core::ExpectsPromiseSystem<void>(Core::SystemException("content error: response body was not read", std::make_error_condition(std::errc::broken_pipe)));
+				else if (!Pending.empty())
+					return Core::ExpectsPromiseSystem<void>(Core::SystemException("content error: pipelined responses were not read", std::make_error_condition(std::errc::broken_pipe)));
 
 				Core::ExpectsPromiseSystem<void> Result;
 				Request = std::move(Target);
@@ -6351,48 +9672,8 @@ namespace Vitex
 					Result.Set(std::move(Status));
 				};
 
-				if (Request.GetHeader("Host").empty())
-				{
-					auto Hostname = State.Address.GetHostname();
-					if (Hostname)
-					{
-						auto Port = State.Address.GetIpPort();
-						if (Port && *Port != (Net.Stream->IsSecure() ? 443 : 80))
-							Request.SetHeader("Host", (*Hostname + ':' + Core::ToString(*Port)));
-						else
-							Request.SetHeader("Host", *Hostname);
-					}
-				}
-
-				if (Request.GetHeader("Accept").empty())
-					Request.SetHeader("Accept", "*/*");
-
-				if (Request.GetHeader("Content-Length").empty())
-				{
-					Request.Content.Length = Request.Content.Data.size();
-					Request.SetHeader("Content-Length", Core::ToString(Request.Content.Data.size()));
-				}
-
-				if (Request.GetHeader("Connection").empty())
-					Request.SetHeader("Connection", "Keep-Alive");
-
 				auto* Content = HrmCache::Get()->Pop();
-				if (Request.Location.empty())
-					Request.Location.assign("/");
-
-				if (!Request.Query.empty())
-				{
-					Content->append(Request.Method).append(" ");
-					Content->append(Request.Location).append("?");
-					Content->append(Request.Query).append(" ");
-					Content->append(Request.Version).append("\r\n");
-				}
-				else
-				{
-					Content->append(Request.Method).append(" ");
-					Content->append(Request.Location).append(" ");
-					Content->append(Request.Version).append("\r\n");
-				}
+				Compose(Request, *Content);
 
 				if (Request.Content.Resources.empty())
 				{
@@ -6421,17 +9702,7 @@ namespace Vitex
 								{
 									if (Packet::IsDone(Event))
 									{
-										Net.Stream->ReadUntilChunkedQueued("\r\n\r\n", [this](SocketPoll Event, const uint8_t* Buffer, size_t Recv)
-										{
-											if (Packet::IsData(Event))
-												Response.Content.Append(std::string_view((char*)Buffer, Recv));
-											else if (Packet::IsDone(Event))
-												Receive(Buffer, Recv);
-											else if (Packet::IsErrorOrSkip(Event))
-												Report(Core::SystemException(Event == SocketPoll::Timeout ? "read timeout error" : "read abort error", std::make_error_condition(Event == SocketPoll::Timeout ? std::errc::timed_out : std::errc::connection_aborted)));
-
-											return true;
-										});
+										ReceiveHead();
 									}
 									else if (Packet::IsErrorOrSkip(Event))
 										Report(Core::SystemException(Event == SocketPoll::Timeout ? "write timeout error" : "write abort error", std::make_error_condition(Event == SocketPoll::Timeout ? std::errc::timed_out : std::errc::connection_aborted)));
@@ -6439,17 +9710,7 @@ namespace Vitex
 							}
 							else
 							{
-								Net.Stream->ReadUntilChunkedQueued("\r\n\r\n", [this](SocketPoll Event, const uint8_t* Buffer, size_t Recv)
-								{
-									if (Packet::IsData(Event))
-										Response.Content.Append(std::string_view((char*)Buffer, Recv));
-									else if (Packet::IsDone(Event))
-										Receive(Buffer, Recv);
-									else if (Packet::IsErrorOrSkip(Event))
-										Report(Core::SystemException(Event == SocketPoll::Timeout ? "read timeout error" : "read abort error", std::make_error_condition(Event == SocketPoll::Timeout ? std::errc::timed_out : std::errc::connection_aborted)));
-
-									return true;
-								});
+								ReceiveHead();
 							}
 						}
 						else if (Packet::IsErrorOrSkip(Event))
@@ -6555,6 +9816,83 @@ namespace Vitex
 					return Fetch(MaxSize);
 				});
 			}
+			Core::ExpectsPromiseSystem<void> Client::SendPipelined(Core::Vector<RequestFrame>&& Targets)
+			{
+				VI_ASSERT(!WebSocket, "cannot send http request over websocket");
+				if (Targets.empty())
+					return Core::ExpectsPromiseSystem<void>(Core::SystemException("send error: no requests", std::make_error_condition(std::errc::invalid_argument)));
+				else if (!HasStream())
+					return Core::ExpectsPromiseSystem<void>(Core::SystemException("send error: bad fd", std::make_error_condition(std::errc::bad_file_descriptor)));
+				else if (!Response.Content.IsFinalized() || Response.Content.Exceeds)
+					return Core::ExpectsPromiseSystem<void>(Core::SystemException("content error: response body was not read", std::make_error_condition(std::errc::broken_pipe)));
+				else if (!Pending.empty())
+					return Core::ExpectsPromiseSystem<void>(Core::SystemException("content error: pipelined responses were not read", std::make_error_condition(std::errc::broken_pipe)));
+
+				for (auto& Target : Targets)
+				{
+					if (!Target.Content.Resources.empty())
+						return Core::ExpectsPromiseSystem<void>(Core::SystemException("send error: pipelined request cannot upload resources", std::make_error_condition(std::errc::not_supported)));
+				}
+
+				auto* Content = HrmCache::Get()->Pop();
+				for (auto& Target : Targets)
+				{
+					VI_DEBUG("[http] %s %s (pipelined)", Target.Method, Target.Location.c_str());
+					Compose(Target, *Content);
+					if (!Target.Content.Data.empty() && Target.GetHeader("Content-Type").empty())
+						Target.SetHeader("Content-Type", "application/octet-stream");
+
+					Paths::ConstructHeadFull(&Target, &Response, true, *Content);
+					Content->append("\r\n");
+					Content->append(Target.Content.Data.data(), Target.Content.Data.size());
+					Pending.emplace(std::move(Target));
+				}
+
+				Core::ExpectsPromiseSystem<void> Result;
+				Request = std::move(Pending.front());
+				Pending.pop();
+				Response.Cleanup();
+				State.Resolver = [this, Result](Core::ExpectsSystem<void>&& Status) mutable
+				{
+					if (!Status)
+						Response.StatusCode = -1;
+					Result.Set(std::move(Status));
+				};
+
+				Net.Stream->WriteQueued((uint8_t*)Content->c_str(), Content->size(), [this, Content](SocketPoll Event)
+				{
+					HrmCache::Get()->Push(Content);
+					if (Packet::IsDone(Event))
+						ReceiveHead();
+					else if (Packet::IsErrorOrSkip(Event))
+						Report(Core::SystemException(Event == SocketPoll::Timeout ? "write timeout error" : "write abort error", std::make_error_condition(Event == SocketPoll::Timeout ? std::errc::timed_out : std::errc::connection_aborted)));
+				}, false);
+				return Result;
+			}
+			Core::ExpectsPromiseSystem<void> Client::ReceivePipelined()
+			{
+				VI_ASSERT(!WebSocket, "cannot read http over websocket");
+				if (Pending.empty())
+					return Core::ExpectsPromiseSystem<void>(Core::SystemException("receive error: no pipelined requests", std::make_error_condition(std::errc::operation_not_permitted)));
+				else if (!HasStream())
+					return Core::ExpectsPromiseSystem<void>(Core::SystemException("receive error: bad fd", std::make_error_condition(std::errc::bad_file_descriptor)));
+				else if (!Response.Content.IsFinalized() || Response.Content.Exceeds)
+					return Core::ExpectsPromiseSystem<void>(Core::SystemException("content error: response body was not read", std::make_error_condition(std::errc::broken_pipe)));
+
+				Core::ExpectsPromiseSystem<void> Result;
+				Request = std::move(Pending.front());
+				Pending.pop();
+				Response.Cleanup();
+				State.Resolver = [this, Result](Core::ExpectsSystem<void>&& Status) mutable
+				{
+					if (!Status)
+						Response.StatusCode = -1;
+					Result.Set(std::move(Status));
+				};
+
+				ReceiveHead();
+				return Result;
+			}
 			Core::ExpectsPromiseSystem<Core::Schema*> Client::JSON(HTTP::RequestFrame&& Target, size_t MaxSize)
 			{
 				return SendFetch(std::move(Target), MaxSize).Then<Core::ExpectsSystem<Core::Schema*>>([this](Core::ExpectsSystem<void>&& Status) -> Core::ExpectsSystem<Core::Schema*>
@@ -6583,8 +9921,17 @@ namespace Vitex
 					return *Data;
 				});
 			}
+			Core::ExpectsSystem<void> Client::OnConnect()
+			{
+				Pending = Core::SingleQueue<RequestFrame>();
+				Pipeline.clear();
+				Report(Core::Expectation::Met);
+				return Core::Expectation::Met;
+			}
 			Core::ExpectsSystem<void> Client::OnReuse()
 			{
+				Pending = Core::SingleQueue<RequestFrame>();
+				Pipeline.clear();
 				Response.Content.Cleanup();
 				Response.Content.Finalize();
 				Report(Core::Expectation::Met);
@@ -6592,6 +9939,8 @@ namespace Vitex
 			}
 			Core::ExpectsSystem<void> Client::OnDisconnect()
 			{
+				Pending = Core::SingleQueue<RequestFrame>();
+				Pipeline.clear();
 				Response.Content.Cleanup();
 				Response.Content.Finalize();
 				Report(Core::Expectation::Met);
@@ -6765,19 +10114,7 @@ namespace Vitex
 					}, false);
 				}
 				else
-				{
-					Net.Stream->ReadUntilChunkedQueued("\r\n\r\n", [this](SocketPoll Event, const uint8_t* Buffer, size_t Recv)
-					{
-						if (Packet::IsData(Event))
-							Response.Content.Append(std::string_view((char*)Buffer, Recv));
-						else if (Packet::IsDone(Event))
-							Receive(Buffer, Recv);
-						else if (Packet::IsErrorOrSkip(Event))
-							Report(Core::SystemException(Event == SocketPoll::Timeout ? "read timeout error" : "read abort error", std::make_error_condition(Event == SocketPoll::Timeout ? std::errc::timed_out : std::errc::connection_aborted)));
-
-						return true;
-					});
-				}
+					ReceiveHead();
 			}
 			void Client::ManageKeepAlive()
 			{
@@ -6820,70 +10157,444 @@ namespace Vitex
 				Resolver->PrepareForResponseParsing(&Response);
 				if (Resolver->ParseResponse((uint8_t*)Response.Content.Data.data(), Response.Content.Data.size(), 0) >= 0)
 				{
-					Response.Content.Prepare(Response.Headers, LeftoverBuffer, LeftoverSize);
+					bool Bodyless = !memcmp(Request.Method, "HEAD", 5) || Response.StatusCode == 204 || Response.StatusCode == 304 || (Response.StatusCode >= 100 && Response.StatusCode < 200);
+					size_t Length = LeftoverSize;
+					if (Bodyless)
+						Length = 0;
+					else if (LeftoverBuffer != nullptr)
+					{
+						auto ContentLength = Response.GetHeader("Content-Length");
+						if (!ContentLength.empty())
+							Length = std::min<size_t>(LeftoverSize, strtoull(ContentLength.data(), nullptr, 10));
+					}
+
+					if (LeftoverBuffer != nullptr && Length < LeftoverSize)
+						Pipeline.assign((char*)LeftoverBuffer + Length, LeftoverSize - Length);
+
+					Response.Content.Prepare(Response.Headers, LeftoverBuffer, Length);
+					if (Bodyless)
+						Response.Content.Finalize();
 					ManageKeepAlive();
 					Report(Core::Expectation::Met);
 				}
 				else
 					Report(Core::SystemException(Core::Stringify::Text("http chunk parse error: %.*s ...", (int)std::min<size_t>(64, Response.Content.Data.size()), Response.Content.Data.data()), std::make_error_condition(std::errc::bad_message)));
 			}
+			void Client::ReceiveHead()
+			{
+				size_t Matched = 0;
+				if (!Pipeline.empty())
+				{
+					Core::String Buffer = std::move(Pipeline);
+					Pipeline.clear();
 
-			Core::ExpectsPromiseSystem<ResponseFrame> Fetch(const std::string_view& Location, const std::string_view& Method, const FetchFrame& Options)
+					size_t Offset = Buffer.find("\r\n\r\n");
+					if (Offset != Core::String::npos)
+					{
+						Offset += 4;
+						Response.Content.Append(std::string_view(Buffer.data(), Offset));
+						return Receive(Offset < Buffer.size() ? (uint8_t*)Buffer.data() + Offset : nullptr, Buffer.size() - Offset);
+					}
+
+					Response.Content.Append(Buffer);
+					for (Matched = std::min<size_t>(Buffer.size(), 3); Matched > 0; Matched--)
+					{
+						if (!memcmp(Buffer.data() + Buffer.size() - Matched, "\r\n\r\n", Matched))
+							break;
+					}
+				}
+
+				Net.Stream->ReadUntilChunkedQueued("\r\n\r\n", [this](SocketPoll Event, const uint8_t* Buffer, size_t Recv)
+				{
+					if (Packet::IsData(Event))
+						Response.Content.Append(std::string_view((char*)Buffer, Recv));
+					else if (Packet::IsDone(Event))
+						Receive(Buffer, Recv);
+					else if (Packet::IsErrorOrSkip(Event))
+						Report(Core::SystemException(Event == SocketPoll::Timeout ? "read timeout error" : "read abort error", std::make_error_condition(Event == SocketPoll::Timeout ? std::errc::timed_out : std::errc::connection_aborted)));
+
+					return true;
+				}, Matched);
+			}
+			void Client::Compose(RequestFrame& Target, Core::String& Content)
+			{
+				if (Target.GetHeader("Host").empty())
+				{
+					auto Hostname = State.Address.GetHostname();
+					if (Hostname)
+					{
+						auto Port = State.Address.GetIpPort();
+						if (Port && *Port != (Net.Stream->IsSecure() ? 443 : 80))
+							Target.SetHeader("Host", (*Hostname + ':' + Core::ToString(*Port)));
+						else
+							Target.SetHeader("Host", *Hostname);
+					}
+				}
+
+				if (Target.GetHeader("Accept").empty())
+					Target.SetHeader("Accept", "*/*");
+
+				if (Target.GetHeader("Content-Length").empty())
+				{
+					Target.Content.Length = Target.Content.Data.size();
+					Target.SetHeader("Content-Length", Core::ToString(Target.Content.Data.size()));
+				}
+
+				if (Target.GetHeader("Connection").empty())
+					Target.SetHeader("Connection", "Keep-Alive");
+
+				if (Target.Location.empty())
+					Target.Location.assign("/");
+
+				if (!Target.Query.empty())
+				{
+					Content.append(Target.Method).append(" ");
+					Content.append(Target.Location).append("?");
+					Content.append(Target.Query).append(" ");
+					Content.append(Target.Version).append("\r\n");
+				}
+				else
+				{
+					Content.append(Target.Method).append(" ");
+					Content.append(Target.Location).append(" ");
+					Content.append(Target.Version).append("\r\n");
+				}
+			}
+
+			static bool IsIdempotentRequest(const RequestFrame& Target)
+			{
+				if (!Target.Content.Data.empty() || !Target.Content.Resources.empty())
+					return false;
+
+				return !memcmp(Target.Method, "GET", 4) || !memcmp(Target.Method, "HEAD", 5) || !memcmp(Target.Method, "OPTIONS", 8);
+			}
+			static bool IsAliveConnection(Client* Base)
+			{
+				auto* Stream = Base->GetStream();
+				if (!Stream || !Stream->IsValid())
+					return false;
+
+				uint8_t Buffer;
+				auto Status = Stream->Read(&Buffer, sizeof(Buffer));
+				return !Status && Status.Error() == std::errc::operation_would_block;
+			}
+
+			ClientPool::ClientPool() noexcept
+			{
+			}
+			ClientPool::~ClientPool() noexcept
+			{
+				for (auto& Item : Hosts)
+				{
+					for (auto& Target : Item.second.Idle)
+						Core::Memory::Release(Target.Base);
+				}
+				Hosts.clear();
+			}
+			Core::ExpectsPromiseSystem<ResponseFrame> ClientPool::Fetch(const std::string_view& Location, const std::string_view& Method, const FetchFrame& Options)
 			{
 				Network::Location Origin(Location);
 				if (Origin.Protocol != "http" && Origin.Protocol != "https")
 					return Core::ExpectsPromiseSystem<ResponseFrame>(Core::SystemException("http fetch: invalid protocol", std::make_error_condition(std::errc::address_family_not_supported)));
 
-				HTTP::RequestFrame Request;
-				Request.Cookies = Options.Cookies;
-				Request.Headers = Options.Headers;
-				Request.Content = Options.Content;
-				Request.Location.assign(Origin.Path);
-				Request.SetMethod(Method);
+				auto* Item = Core::Memory::New<Pending>();
+				Item->Request.Cookies = Options.Cookies;
+				Item->Request.Headers = Options.Headers;
+				Item->Request.Content = Options.Content;
+				Item->Request.Location.assign(Origin.Path);
+				Item->Request.SetMethod(Method);
+				Item->Timeout = Options.Timeout;
+				Item->MaxSize = Options.MaxSize;
 				if (!Origin.Username.empty() || !Origin.Password.empty())
-					Request.SetHeader("Authorization", Permissions::Authorize(Origin.Username, Origin.Password));
+					Item->Request.SetHeader("Authorization", Permissions::Authorize(Origin.Username, Origin.Password));
 
-				for (auto& Item : Origin.Query)
-					Request.Query += Item.first + "=" + Item.second + "&";
-				if (!Request.Query.empty())
-					Request.Query.pop_back();
+				for (auto& Query : Origin.Query)
+					Item->Request.Query += Query.first + "=" + Query.second + "&";
+				if (!Item->Request.Query.empty())
+					Item->Request.Query.pop_back();
 
-				size_t MaxSize = Options.MaxSize;
-				uint64_t Timeout = Options.Timeout;
 				bool Secure = Origin.Protocol == "https";
 				Core::String Hostname = Origin.Hostname;
 				Core::String Port = Origin.Port > 0 ? Core::ToString(Origin.Port) : Core::String(Secure ? "443" : "80");
 				int32_t VerifyPeers = (Secure ? (Options.VerifyPeers >= 0 ? Options.VerifyPeers : PEER_NOT_VERIFIED) : PEER_NOT_SECURE);
-				return DNS::Get()->LookupDeferred(Hostname, Port, DNSType::Connect, SocketProtocol::TCP, SocketType::Stream).Then<Core::ExpectsPromiseSystem<ResponseFrame>>([MaxSize, Timeout, VerifyPeers, Request = std::move(Request), Origin = std::move(Origin)](Core::ExpectsSystem<SocketAddress>&& Address) mutable -> Core::ExpectsPromiseSystem<ResponseFrame>
+				Core::String Name = Origin.Protocol + "://" + Hostname + ':' + Port + '#' + Core::ToString(VerifyPeers);
+				auto Future = Item->Future;
+
+				AddRef();
+				DNS::Get()->LookupDeferred(Hostname, Port, DNSType::Connect, SocketProtocol::TCP, SocketType::Stream).When([this, Item, VerifyPeers, Name = std::move(Name)](Core::ExpectsSystem<SocketAddress>&& Address) mutable
+				{
+					if (Address)
+						Enqueue(std::move(Name), std::move(*Address), VerifyPeers, Item);
+					else
+						Resolve(Item, Address.Error());
+				});
+				return Future;
+			}
+			void ClientPool::Cleanup()
+			{
+				Core::Vector<Client*> Expired;
+				Core::UMutex<std::mutex> Unique(Exclusive);
+				for (auto It = Hosts.begin(); It != Hosts.end();)
+				{
+					for (auto& Target : It->second.Idle)
+						Expired.push_back(Target.Base);
+
+					It->second.Idle.clear();
+					if (!It->second.Active && It->second.Requests.empty())
+						It = Hosts.erase(It);
+					else
+						++It;
+				}
+
+				Unique.Negate();
+				for (auto* Base : Expired)
+					Core::Memory::Release(Base);
+			}
+			size_t ClientPool::GetConnections()
+			{
+				size_t Count = 0;
+				Core::UMutex<std::mutex> Unique(Exclusive);
+				for (auto& Item : Hosts)
+					Count += Item.second.Active + Item.second.Idle.size();
+				return Count;
+			}
+			size_t ClientPool::GetRequests()
+			{
+				size_t Count = 0;
+				Core::UMutex<std::mutex> Unique(Exclusive);
+				for (auto& Item : Hosts)
+					Count += Item.second.Requests.size();
+				return Count;
+			}
+			void ClientPool::Enqueue(Core::String&& Name, SocketAddress&& Address, int32_t VerifyPeers, Pending* Item)
+			{
+				Core::UMutex<std::mutex> Unique(Exclusive);
+				auto& Target = Hosts[Name];
+				if (Target.Requests.size() >= Limits.MaxQueue)
+				{
+					Unique.Negate();
+					return Resolve(Item, Core::SystemException("http fetch: too many pending requests", std::make_error_condition(std::errc::resource_unavailable_try_again)));
+				}
+
+				auto IpAddress = Address.GetIpAddress();
+				Target.IpAddress = IpAddress ? std::move(*IpAddress) : Core::String();
+				Target.Address = std::move(Address);
+				Target.VerifyPeers = VerifyPeers;
+				Target.Requests.push_back(Item);
+				Unique.Negate();
+				Dispatch(Name);
+			}
+			void ClientPool::Dispatch(const Core::String& Name)
+			{
+				while (true)
 				{
-					if (!Address)
-						return Core::ExpectsPromiseSystem<ResponseFrame>(Address.Error());
+					Core::Vector<Client*> Expired;
+					Core::Vector<Pending*> Batch;
+					SocketAddress Address;
+					Peer Target;
+					int32_t VerifyPeers = PEER_NOT_SECURE;
+					bool Reused = false;
+
+					Core::UMutex<std::mutex> Unique(Exclusive);
+					auto It = Hosts.find(Name);
+					if (It == Hosts.end())
+						return;
 
-					HTTP::Client* Client = new HTTP::Client(Timeout);
-					return Client->ConnectAsync(*Address, VerifyPeers).Then<Core::ExpectsPromiseSystem<void>>([Client, MaxSize, Request = std::move(Request)](Core::ExpectsSystem<void>&& Status) mutable -> Core::ExpectsPromiseSystem<void>
+					auto& Base = It->second;
+					int64_t Time = Network::Utils::Clock();
+					if (Base.Requests.empty())
 					{
-						if (!Status)
-							return Core::ExpectsPromiseSystem<void>(Status);
+						for (auto Next = Base.Idle.begin(); Next != Base.Idle.end();)
+						{
+							if (Next->Expires > Time && Next->IpAddress == Base.IpAddress)
+							{
+								++Next;
+								continue;
+							}
+
+							Expired.push_back(Next->Base);
+							Next = Base.Idle.erase(Next);
+						}
+
+						if (!Base.Active && Base.Idle.empty())
+							Hosts.erase(It);
+
+						Unique.Negate();
+						for (auto* Next : Expired)
+							Core::Memory::Release(Next);
+						return;
+					}
 
-						return Client->SendFetch(std::move(Request), MaxSize);
-					}).Then<Core::ExpectsPromiseSystem<ResponseFrame>>([Client](Core::ExpectsSystem<void>&& Status) -> Core::ExpectsPromiseSystem<ResponseFrame>
+					while (!Base.Idle.empty())
 					{
-						if (!Status)
+						Peer Next = std::move(Base.Idle.back());
+						Base.Idle.pop_back();
+						if (Next.Expires > Time && Next.IpAddress == Base.IpAddress && IsAliveConnection(Next.Base))
 						{
-							Client->Release();
-							return Core::ExpectsPromiseSystem<ResponseFrame>(Status.Error());
+							Target = std::move(Next);
+							Reused = true;
+							break;
 						}
+						Expired.push_back(Next.Base);
+					}
+
+					if (!Reused && Base.Active + Base.Idle.size() >= Limits.MaxConnections)
+					{
+						Unique.Negate();
+						for (auto* Next : Expired)
+							Core::Memory::Release(Next);
+						return;
+					}
 
-						auto Response = std::move(*Client->GetResponse());
-						return Client->Disconnect().Then<Core::ExpectsSystem<ResponseFrame>>([Client, Response = std::move(Response)](Core::ExpectsSystem<void>&&) mutable -> Core::ExpectsSystem<ResponseFrame>
+					++Base.Active;
+					Batch.push_back(Base.Requests.front());
+					Base.Requests.pop_front();
+					if (Limits.MaxPipeline > 1 && Base.Active + Base.Idle.size() >= Limits.MaxConnections && IsIdempotentRequest(Batch.front()->Request))
+					{
+						while (Batch.size() < Limits.MaxPipeline && !Base.Requests.empty() && IsIdempotentRequest(Base.Requests.front()->Request))
 						{
-							Client->Release();
-							return std::move(Response);
-						});
+							Batch.push_back(Base.Requests.front());
+							Base.Requests.pop_front();
+						}
+					}
+
+					Address = Base.Address;
+					VerifyPeers = Base.VerifyPeers;
+					Unique.Negate();
+
+					for (auto* Next : Expired)
+						Core::Memory::Release(Next);
+
+					AddRef();
+					if (Reused)
+						Execute(Name, std::move(Target), std::move(Batch), true);
+					else
+						Connect(Name, Address, VerifyPeers, std::move(Batch));
+				}
+			}
+			void ClientPool::Connect(const Core::String& Name, const SocketAddress& Address, int32_t VerifyPeers, Core::Vector<Pending*>&& Batch)
+			{
+				auto IpAddress = Address.GetIpAddress();
+				Peer Target;
+				Target.Base = new Client(Batch.front()->Timeout);
+				Target.IpAddress = IpAddress ? std::move(*IpAddress) : Core::String();
+				Target.Base->ConnectAsync(Address, VerifyPeers).When([this, Name, Target, Batch = std::move(Batch)](Core::ExpectsSystem<void>&& Status) mutable
+				{
+					if (Status)
+						Execute(Name, std::move(Target), std::move(Batch), false);
+					else
+						Abort(Name, std::move(Target), std::move(Batch), 0, false, std::move(Status.Error()));
+				});
+			}
+			void ClientPool::Execute(const Core::String& Name, Peer&& Target, Core::Vector<Pending*>&& Batch, bool Reused)
+			{
+				Target.Base->GetStream()->SetIoTimeout(Batch.front()->Timeout);
+				Core::ExpectsPromiseSystem<void> Status = Core::ExpectsPromiseSystem<void>::Null();
+				if (Batch.size() > 1)
+				{
+					Core::Vector<RequestFrame> Requests;
+					Requests.reserve(Batch.size());
+					for (auto* Item : Batch)
+						Requests.push_back(Item->Request);
+					Status = Target.Base->SendPipelined(std::move(Requests));
+				}
+				else if (IsIdempotentRequest(Batch.front()->Request))
+					Status = Target.Base->Send(RequestFrame(Batch.front()->Request));
+				else
+					Status = Target.Base->Send(std::move(Batch.front()->Request));
+
+				Status.When([this, Name, Target = std::move(Target), Batch = std::move(Batch), Reused](Core::ExpectsSystem<void>&& Status) mutable
+				{
+					if (Status)
+						Process(Name, std::move(Target), std::move(Batch), 0, Reused);
+					else
+						Abort(Name, std::move(Target), std::move(Batch), 0, Reused, std::move(Status.Error()));
+				});
+			}
+			void ClientPool::Process(const Core::String& Name, Peer&& Target, Core::Vector<Pending*>&& Batch, size_t Index, bool Reused)
+			{
+				Target.Base->Fetch(Batch[Index]->MaxSize).When([this, Name, Target = std::move(Target), Batch = std::move(Batch), Index, Reused](Core::ExpectsSystem<void>&& Status) mutable
+				{
+					if (!Status)
+						return Abort(Name, std::move(Target), std::move(Batch), Index, Reused, std::move(Status.Error()));
+
+					auto* Response = Target.Base->GetResponse();
+					auto Connection = Response->GetHeader("Connection");
+					bool Reusable = Response->Content.IsFinalized() && (Connection.empty() || Core::Stringify::CaseEquals(Connection, "keep-alive"));
+					Resolve(Batch[Index++], std::move(*Response));
+					if (Index >= Batch.size())
+						return Complete(Name, std::move(Target), Reusable);
+					else if (!Reusable)
+						return Abort(Name, std::move(Target), std::move(Batch), Index, Reused, Core::SystemException("http fetch: pipelined connection closed", std::make_error_condition(std::errc::connection_aborted)));
+
+					Target.Base->ReceivePipelined().When([this, Name, Target, Batch = std::move(Batch), Index, Reused](Core::ExpectsSystem<void>&& Status) mutable
+					{
+						if (Status)
+							Process(Name, std::move(Target), std::move(Batch), Index, Reused);
+						else
+							Abort(Name, std::move(Target), std::move(Batch), Index, Reused, std::move(Status.Error()));
 					});
 				});
 			}
+			void ClientPool::Abort(const Core::String& Name, Peer&& Target, Core::Vector<Pending*>&& Batch, size_t Index, bool Reused, Core::SystemException&& Error)
+			{
+				Core::Vector<Pending*> Retries;
+				for (size_t i = Index; i < Batch.size(); i++)
+				{
+					auto* Item = Batch[i];
+					if (!Item->Retried && (Reused || Batch.size() > 1) && IsIdempotentRequest(Item->Request))
+					{
+						Item->Retried = true;
+						Retries.push_back(Item);
+					}
+					else
+						Resolve(Item, Core::SystemException(Error));
+				}
+
+				if (!Retries.empty())
+				{
+					Core::UMutex<std::mutex> Unique(Exclusive);
+					auto& Base = Hosts[Name];
+					for (auto It = Retries.rbegin(); It != Retries.rend(); ++It)
+						Base.Requests.push_front(*It);
+				}
+
+				Complete(Name, std::move(Target), false);
+			}
+			void ClientPool::Complete(const Core::String& Name, Peer&& Target, bool Reusable)
+			{
+				Client* Expired = Target.Base;
+				Core::UMutex<std::mutex> Unique(Exclusive);
+				auto It = Hosts.find(Name);
+				if (It != Hosts.end())
+				{
+					auto& Base = It->second;
+					--Base.Active;
+					if (Reusable && Base.Idle.size() < Limits.MaxIdle && Target.IpAddress == Base.IpAddress && Target.Base->HasStream())
+					{
+						Target.Expires = Network::Utils::Clock() + (int64_t)Limits.IdleTimeout;
+						Base.Idle.emplace_back(std::move(Target));
+						Expired = nullptr;
+					}
+				}
+
+				Unique.Negate();
+				Core::Memory::Release(Expired);
+				Dispatch(Name);
+				Release();
+			}
+			void ClientPool::Resolve(Pending* Item, Core::ExpectsSystem<ResponseFrame>&& Result)
+			{
+				Item->Future.Set(std::move(Result));
+				Core::Memory::Delete(Item);
+				Release();
+			}
+
+			Core::ExpectsPromiseSystem<ResponseFrame> Fetch(const std::string_view& Location, const std::string_view& Method, const FetchFrame& Options)
+			{
+				return ClientPool::Get()->Fetch(Location, Method, Options);
+			}
 		}
 	}
 }
-#pragma warning(pop)
\ No newline at end of file
+#pragma warning(pop)
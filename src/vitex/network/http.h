@@ -11,7 +11,6 @@ namespace Vitex
 			enum
 			{
 				LABEL_SIZE = 16,
-				INLINING_SIZE = 768,
 				PAYLOAD_SIZE = (size_t)(1024 * 64)
 			};
 
@@ -40,6 +39,13 @@ namespace Vitex
 				Close
 			};
 
+			enum class BroadcastPolicy
+			{
+				Buffer,
+				Drop,
+				Disconnect
+			};
+
 			enum class CompressionTune
 			{
 				Filtered = 1,
@@ -161,8 +167,24 @@ namespace Vitex
 
 			class Query;
 
+			class Session;
+
+			class SessionStore;
+
 			class WebCodec;
 
+			struct CachedFile;
+
+			struct RouterAutomaton;
+
+			struct CachedVariant;
+
+			struct DeflateContext;
+
+			struct SharedFrame;
+
+			struct Http2Session;
+
 			struct VI_OUT ErrorFile
 			{
 				Core::String Pattern;
@@ -339,9 +361,21 @@ namespace Vitex
 				std::pair<size_t, size_t> GetRange(Core::Vector<std::pair<size_t, size_t>>::iterator Range, size_t ContentLength) const;
 			};
 
+			struct VI_OUT WebSocketDeflate
+			{
+				size_t MaxMessageSize = 1024 * 1024 * 16;
+				int LocalWindowBits = 15;
+				int RemoteWindowBits = 15;
+				int QualityLevel = 6;
+				int MemoryLevel = 8;
+				bool LocalContextTakeover = true;
+				bool RemoteContextTakeover = true;
+			};
+
 			class VI_OUT WebSocketFrame final : public Core::Reference<WebSocketFrame>
 			{
 				friend class Connection;
+				friend class Server;
 
 			private:
 				enum class Tunnel
@@ -359,6 +393,7 @@ namespace Vitex
 					size_t Size;
 					WebSocketOp Opcode;
 					WebSocketCallback Callback;
+					SharedFrame* Shared;
 				};
 
 			public:
@@ -374,6 +409,7 @@ namespace Vitex
 				Core::SingleQueue<Message> Messages;
 				Socket* Stream;
 				WebCodec* Codec;
+				size_t Backlog;
 				std::atomic<uint32_t> State;
 				std::atomic<uint32_t> Tunneling;
 				std::atomic<bool> Active;
@@ -393,6 +429,7 @@ namespace Vitex
 				Core::ExpectsSystem<size_t> Send(const std::string_view& Buffer, WebSocketOp OpCode, WebSocketCallback&& Callback);
 				Core::ExpectsSystem<size_t> Send(uint32_t Mask, const std::string_view& Buffer, WebSocketOp OpCode, WebSocketCallback&& Callback);
 				Core::ExpectsSystem<void> SendClose(WebSocketCallback&& Callback);
+				bool SetDeflate(const WebSocketDeflate& Options);
 				void Next();
 				bool IsFinished();
 				Socket* GetStream();
@@ -403,7 +440,9 @@ namespace Vitex
 				void Update();
 				void Finalize();
 				void Dequeue();
+				void Transmit(SharedFrame* Frame);
 				bool Enqueue(uint32_t Mask, const std::string_view& Buffer, WebSocketOp OpCode, WebSocketCallback&& Callback);
+				bool Broadcast(SharedFrame* Frame, BroadcastPolicy Policy, size_t MaxBacklog);
 				bool IsWriteable();
 				bool IsIgnore();
 			};
@@ -415,9 +454,15 @@ namespace Vitex
 				Core::Vector<RouterEntry*> Routes;
 				RouteMode Mode;
 
+			private:
+				RouterAutomaton* Automaton;
+
 			public:
 				RouterGroup(const std::string_view& NewMatch, RouteMode NewMode) noexcept;
 				~RouterGroup() noexcept;
+				void Compile();
+				void Invalidate();
+				RouterEntry* Find(const std::string_view& Location, Compute::RegexResult& Result);
 			};
 
 			class VI_OUT RouterEntry final : public Core::Reference<RouterEntry>
@@ -474,6 +519,7 @@ namespace Vitex
 				Core::Vector<Compute::RegexSource> HiddenFiles;
 				Core::Vector<ErrorFile> ErrorFiles;
 				Core::Vector<MimeType> MimeTypes;
+				WebSocketDeflate WebSocketCompression;
 				Core::Vector<Core::String> IndexFiles;
 				Core::Vector<Core::String> TryFiles;
 				Core::Vector<Core::String> DisallowedMethods;
@@ -483,7 +529,9 @@ namespace Vitex
 				size_t Level = 0;
 				bool AllowDirectoryListing = false;
 				bool AllowWebSocket = false;
+				bool AllowWebSocketCompression = false;
 				bool AllowSendFile = true;
+				bool AllowFileCache = false;
 
 			private:
 				static RouterEntry* From(const RouterEntry& Other, const Compute::RegexSource& Source);
@@ -505,10 +553,22 @@ namespace Vitex
 						bool HttpOnly = true;
 					} Cookie;
 
+					SessionStore* Store = nullptr;
 					Core::String Directory;
 					uint64_t Expires = 604800;
+					size_t MaxEntries = 65536;
+					bool WriteBehind = false;
 				} Session;
 
+				struct RouterHttp2
+				{
+					size_t MaxConcurrentStreams = 128;
+					size_t InitialWindowSize = 1024 * 1024;
+					size_t MaxFrameSize = 16384;
+					size_t HeaderTableSize = 4096;
+					bool Enabled = false;
+				} Http2;
+
 				struct RouterCallbacks
 				{
 					std::function<void(MapRouter*)> OnDestroy;
@@ -559,10 +619,17 @@ namespace Vitex
 
 			class VI_OUT Connection final : public SocketConnection
 			{
+				friend Server;
+
+			private:
+				Core::String Pipeline;
+				Session* Current = nullptr;
+
 			public:
 				RequestFrame Request;
 				ResponseFrame Response;
 				Core::FileEntry Resource;
+				CachedFile* Cache = nullptr;
 				Parser* Resolver = nullptr;
 				WebSocketFrame* WebSocket = nullptr;
 				RouterEntry* Route = nullptr;
@@ -580,6 +647,7 @@ namespace Vitex
 				bool Store(ResourceCallback&& Callback = nullptr, bool Eat = false);
 				bool Skip(SuccessCallback&& Callback);
 				Core::ExpectsIO<Core::String> GetPeerIpAddress() const;
+				Session* GetSession();
 				bool IsSkipRequired() const;
 
 			private:
@@ -626,6 +694,67 @@ namespace Vitex
 				static Core::Schema* FindParameter(Core::Schema* Base, QueryToken* Name);
 			};
 
+			class VI_OUT SessionStore : public Core::Reference<SessionStore>
+			{
+			public:
+				SessionStore() noexcept = default;
+				virtual ~SessionStore() noexcept = default;
+				virtual Core::ExpectsSystem<void> Load(Session* Target) = 0;
+				virtual Core::ExpectsSystem<void> Store(Session* Target) = 0;
+				virtual Core::ExpectsSystem<void> Remove(const std::string_view& SessionId) = 0;
+				virtual Core::ExpectsSystem<void> Flush();
+			};
+
+			class VI_OUT FileSessionStore final : public SessionStore
+			{
+			private:
+				Core::String Directory;
+
+			public:
+				FileSessionStore(const std::string_view& NewDirectory) noexcept;
+				~FileSessionStore() noexcept override = default;
+				Core::ExpectsSystem<void> Load(Session* Target) override;
+				Core::ExpectsSystem<void> Store(Session* Target) override;
+				Core::ExpectsSystem<void> Remove(const std::string_view& SessionId) override;
+				const Core::String& GetDirectory() const;
+			};
+
+			class VI_OUT_TS MemorySessionStore final : public SessionStore
+			{
+			private:
+				struct Entry
+				{
+					Session* Data = nullptr;
+					bool Dirty = false;
+				};
+
+				struct Shard
+				{
+					Core::UnorderedMap<Core::String, Core::LinkedList<Entry>::iterator> Index;
+					Core::LinkedList<Entry> Entries;
+					std::mutex Exclusive;
+				};
+
+			private:
+				Core::Vector<Shard*> Shards;
+				SessionStore* Backing;
+				size_t Capacity;
+
+			public:
+				MemorySessionStore(size_t MaxEntries = 65536, size_t MaxShards = 16, SessionStore* NewBacking = nullptr) noexcept;
+				~MemorySessionStore() noexcept override;
+				Core::ExpectsSystem<void> Load(Session* Target) override;
+				Core::ExpectsSystem<void> Store(Session* Target) override;
+				Core::ExpectsSystem<void> Remove(const std::string_view& SessionId) override;
+				Core::ExpectsSystem<void> Flush() override;
+				SessionStore* GetBacking();
+				size_t GetSize();
+
+			private:
+				Shard* GetShard(const std::string_view& SessionId);
+				void Evict(Shard* Target, int64_t Time, Core::Vector<Entry>& Expired);
+			};
+
 			class VI_OUT Session final : public Core::Reference<Session>
 			{
 			public:
@@ -641,8 +770,8 @@ namespace Vitex
 				void Clear();
 
 			private:
-				Core::String& FindSessionId(Connection* Base);
-				Core::String& GenerateSessionId(Connection* Base);
+				Core::ExpectsSystem<void> FindSessionId(Connection* Base);
+				Core::ExpectsSystem<void> GenerateSessionId(Connection* Base);
 
 			public:
 				static Core::ExpectsSystem<void> InvalidateCache(const std::string_view& Path);
@@ -744,7 +873,15 @@ namespace Vitex
 			class VI_OUT WebCodec final : public Core::Reference<WebCodec>
 			{
 			public:
-				typedef Core::SingleQueue<std::pair<WebSocketOp, Core::Vector<char>>> MessageQueue;
+				struct FrameView
+				{
+					WebSocketOp Opcode;
+					size_t Offset;
+					size_t Size;
+					bool Deflated;
+				};
+
+				typedef Core::SingleQueue<FrameView> MessageQueue;
 
 			private:
 				enum class Bytecode
@@ -771,6 +908,12 @@ namespace Vitex
 			private:
 				MessageQueue Queue;
 				Core::Vector<char> Payload;
+				Core::Vector<char> Compressed;
+				Core::Vector<char> Inflated;
+				size_t PayloadBase;
+				size_t PayloadDone;
+				size_t InflatedBase;
+				size_t InflatedDone;
 				uint64_t Remains;
 				WebSocketOp Opcode;
 				Bytecode State;
@@ -780,14 +923,25 @@ namespace Vitex
 				uint8_t Control;
 				uint8_t Masked;
 				uint8_t Masks;
+				uint8_t Compression;
+				DeflateContext* Deflate;
 
 			public:
 				Core::Vector<char> Data;
 
 			public:
 				WebCodec();
+				~WebCodec() noexcept;
+				bool SetDeflate(const WebSocketDeflate& Options);
+				bool Compress(const std::string_view& Buffer, Core::String& Output);
 				bool ParseFrame(const uint8_t* Buffer, size_t Size);
 				bool GetFrame(WebSocketOp* Op, Core::Vector<char>* Message);
+				bool GetFrame(WebSocketOp* Op, std::string_view* Message);
+				bool IsDeflated() const;
+
+			private:
+				bool Decompress();
+				void Compact();
 			};
 
 			class VI_OUT_TS HrmCache final : public Core::Singleton<HrmCache>
@@ -811,6 +965,62 @@ namespace Vitex
 				void ShrinkToFit() noexcept;
 			};
 
+			class VI_OUT_TS FileCache final : public Core::Singleton<FileCache>
+			{
+			private:
+				std::mutex Mutex;
+				Core::UnorderedMap<Core::String, CachedFile*> Files;
+				Core::LinkedList<CachedFile*> Usage;
+				uint64_t Timeout;
+				size_t Capacity;
+
+			public:
+				FileCache() noexcept;
+				FileCache(size_t MaxFiles, uint64_t RevalidateTimeout) noexcept;
+				virtual ~FileCache() noexcept override;
+				void Rescale(size_t MaxFiles, uint64_t RevalidateTimeout) noexcept;
+				void Clear() noexcept;
+				CachedFile* Acquire(RouterEntry* Route, const std::string_view& Path) noexcept;
+				void Discard(CachedFile* Target) noexcept;
+				size_t GetSize() noexcept;
+
+			private:
+				CachedFile* Create(RouterEntry* Route, const std::string_view& Path) noexcept;
+				void Detach(CachedFile* Target) noexcept;
+				void ShrinkToFit() noexcept;
+			};
+
+			class VI_OUT_TS VariantCache final : public Core::Singleton<VariantCache>
+			{
+			private:
+				std::mutex Mutex;
+				std::condition_variable Ready;
+				Core::UnorderedMap<Core::String, CachedVariant*> Variants;
+				Core::UnorderedSet<Core::String> Pending;
+				Core::LinkedList<CachedVariant*> Usage;
+				std::atomic<uint64_t> Hits;
+				std::atomic<uint64_t> Misses;
+				size_t Capacity;
+				size_t Size;
+
+			public:
+				VariantCache() noexcept;
+				VariantCache(size_t MaxBytesStorage) noexcept;
+				virtual ~VariantCache() noexcept override;
+				void Rescale(size_t MaxBytesStorage) noexcept;
+				void Clear() noexcept;
+				CachedVariant* Acquire(Connection* Base, bool Gzip) noexcept;
+				void Discard(CachedVariant* Target) noexcept;
+				uint64_t GetHits() const noexcept;
+				uint64_t GetMisses() const noexcept;
+				size_t GetSize() noexcept;
+
+			private:
+				CachedVariant* Create(Connection* Base, bool Gzip, Core::FileEntry* Sibling, size_t MaxBytes) noexcept;
+				void Detach(CachedVariant* Target) noexcept;
+				void ShrinkToFit() noexcept;
+			};
+
 			class VI_OUT_TS Utils
 			{
 			public:
@@ -903,15 +1113,35 @@ namespace Vitex
 				friend Connection;
 				friend Logical;
 				friend Utils;
+				friend Http2Session;
+
+			private:
+				struct Subscription
+				{
+					BroadcastPolicy Policy;
+					size_t MaxBacklog;
+				};
+
+			private:
+				Core::UnorderedMap<Core::String, Core::UnorderedMap<WebSocketFrame*, Subscription>> Topics;
+				Core::UnorderedMap<WebSocketFrame*, Core::UnorderedSet<Core::String>> Subscribers;
+				std::mutex Exclusive;
 
 			public:
 				Server();
 				~Server() override;
 				Core::ExpectsSystem<void> Update();
+				bool Subscribe(const std::string_view& Topic, WebSocketFrame* Frame, BroadcastPolicy Policy = BroadcastPolicy::Buffer, size_t MaxBacklog = PAYLOAD_SIZE * 16);
+				bool Unsubscribe(const std::string_view& Topic, WebSocketFrame* Frame);
+				void Unsubscribe(WebSocketFrame* Frame);
+				size_t Publish(const std::string_view& Topic, const std::string_view& Buffer, WebSocketOp Opcode = WebSocketOp::Text);
+				size_t GetSubscribers(const std::string_view& Topic);
 
 			private:
 				Core::ExpectsSystem<void> UpdateRoute(RouterEntry* Route);
+				bool Dispatch(Connection* Base);
 				Core::ExpectsSystem<void> OnConfigure(SocketRouter* New) override;
+				Core::ExpectsSystem<void> OnListen() override;
 				Core::ExpectsSystem<void> OnUnlisten() override;
 				void OnRequestOpen(SocketConnection* Base) override;
 				bool OnRequestCleanup(SocketConnection* Base) override;
@@ -938,7 +1168,9 @@ namespace Vitex
 				RequestFrame Request;
 				ResponseFrame Response;
 				Core::Vector<BoundaryBlock> Boundaries;
+				Core::SingleQueue<RequestFrame> Pending;
 				Core::ExpectsPromiseSystem<void> Future;
+				Core::String Pipeline;
 
 			public:
 				Client(int64_t ReadTimeout);
@@ -946,8 +1178,11 @@ namespace Vitex
 				Core::ExpectsPromiseSystem<void> Skip();
 				Core::ExpectsPromiseSystem<void> Fetch(size_t MaxSize = PAYLOAD_SIZE, bool Eat = false);
 				Core::ExpectsPromiseSystem<void> Upgrade(RequestFrame&& Root);
+				Core::ExpectsPromiseSystem<void> Upgrade(RequestFrame&& Root, const WebSocketDeflate& Deflate);
 				Core::ExpectsPromiseSystem<void> Send(RequestFrame&& Root);
 				Core::ExpectsPromiseSystem<void> SendFetch(RequestFrame&& Root, size_t MaxSize = PAYLOAD_SIZE);
+				Core::ExpectsPromiseSystem<void> SendPipelined(Core::Vector<RequestFrame>&& Roots);
+				Core::ExpectsPromiseSystem<void> ReceivePipelined();
 				Core::ExpectsPromiseSystem<Core::Unique<Core::Schema>> JSON(RequestFrame&& Root, size_t MaxSize = PAYLOAD_SIZE);
 				Core::ExpectsPromiseSystem<Core::Unique<Core::Schema>> XML(RequestFrame&& Root, size_t MaxSize = PAYLOAD_SIZE);
 				void Downgrade();
@@ -956,14 +1191,80 @@ namespace Vitex
 				ResponseFrame* GetResponse();
 
 			private:
+				Core::ExpectsSystem<void> OnConnect() override;
 				Core::ExpectsSystem<void> OnReuse() override;
 				Core::ExpectsSystem<void> OnDisconnect() override;
+				Core::ExpectsPromiseSystem<void> Handshake(RequestFrame&& Root, const WebSocketDeflate* Deflate);
 				void UploadFile(BoundaryBlock* Boundary, std::function<void(Core::ExpectsSystem<void>&&)>&& Callback);
 				void UploadFileChunk(FILE* Stream, size_t ContentLength, std::function<void(Core::ExpectsSystem<void>&&)>&& Callback);
 				void UploadFileChunkQueued(FILE* Stream, size_t ContentLength, std::function<void(Core::ExpectsSystem<void>&&)>&& Callback);
 				void Upload(size_t FileId);
 				void ManageKeepAlive();
+				void ReceiveHead();
 				void Receive(const uint8_t* LeftoverBuffer, size_t LeftoverSize);
+				void Compose(RequestFrame& Root, Core::String& Content);
+			};
+
+			class VI_OUT_TS ClientPool final : public Core::Singleton<ClientPool>
+			{
+			public:
+				struct PoolLimits
+				{
+					uint64_t IdleTimeout = 30000;
+					size_t MaxConnections = 6;
+					size_t MaxIdle = 4;
+					size_t MaxPipeline = 1;
+					size_t MaxQueue = 1024;
+				} Limits;
+
+			private:
+				struct Pending
+				{
+					Core::ExpectsPromiseSystem<ResponseFrame> Future;
+					RequestFrame Request;
+					uint64_t Timeout = 0;
+					size_t MaxSize = 0;
+					bool Retried = false;
+				};
+
+				struct Peer
+				{
+					Client* Base = nullptr;
+					Core::String IpAddress;
+					int64_t Expires = 0;
+				};
+
+				struct Host
+				{
+					Core::DoubleQueue<Pending*> Requests;
+					Core::Vector<Peer> Idle;
+					Core::String IpAddress;
+					SocketAddress Address;
+					int32_t VerifyPeers = PEER_NOT_SECURE;
+					size_t Active = 0;
+				};
+
+			private:
+				Core::UnorderedMap<Core::String, Host> Hosts;
+				std::mutex Exclusive;
+
+			public:
+				ClientPool() noexcept;
+				virtual ~ClientPool() noexcept override;
+				Core::ExpectsPromiseSystem<ResponseFrame> Fetch(const std::string_view& Location, const std::string_view& Method = "GET", const FetchFrame& Options = FetchFrame());
+				void Cleanup();
+				size_t GetConnections();
+				size_t GetRequests();
+
+			private:
+				void Enqueue(Core::String&& Name, SocketAddress&& Address, int32_t VerifyPeers, Pending* Item);
+				void Dispatch(const Core::String& Name);
+				void Connect(const Core::String& Name, const SocketAddress& Address, int32_t VerifyPeers, Core::Vector<Pending*>&& Batch);
+				void Execute(const Core::String& Name, Peer&& Target, Core::Vector<Pending*>&& Batch, bool Reused);
+				void Process(const Core::String& Name, Peer&& Target, Core::Vector<Pending*>&& Batch, size_t Index, bool Reused);
+				void Abort(const Core::String& Name, Peer&& Target, Core::Vector<Pending*>&& Batch, size_t Index, bool Reused, Core::SystemException&& Error);
+				void Complete(const Core::String& Name, Peer&& Target, bool Reusable);
+				void Resolve(Pending* Item, Core::ExpectsSystem<ResponseFrame>&& Result);
 			};
 
 			VI_OUT Core::ExpectsPromiseSystem<ResponseFrame> Fetch(const std::string_view& Location, const std::string_view& Method = "GET", const FetchFrame& Options = FetchFrame());
@@ -135,7 +135,7 @@ namespace Vitex
 				}
 #endif
 			}
-			static Core::Schema* ToSchema(const char* Data, int Size, uint32_t Id);
+			static Core::Schema* ToSchema(const char* Data, int Size, uint32_t Id, bool Binary = false);
 			static void ToArrayField(void* Context, ArrayFilter* Subdata, char* Data, size_t Size)
 			{
 				VI_ASSERT(Context != nullptr, "context should be set");
@@ -168,10 +168,276 @@ namespace Vitex
 						Base->first->Push(new Core::Schema(Core::Var::Null()));
 				}
 			}
-			static Core::Variant ToVariant(const char* Data, int Size, uint32_t Id)
+			static int64_t ToBinaryInteger(const char* Data, int Size)
+			{
+				if (Size <= 0 || Size > 8)
+					return 0;
+
+				uint64_t Value = 0;
+				for (int i = 0; i < Size; i++)
+					Value = (Value << 8) | (uint8_t)Data[i];
+
+				if (Size < 8 && (Value >> (Size * 8 - 1)) & 1)
+					Value |= ~0ULL << (Size * 8);
+
+				return (int64_t)Value;
+			}
+			static Core::String ToBinaryNumeric(const char* Data, int Size)
+			{
+				if (Size < 8)
+					return "NaN";
+
+				int64_t Digits = ToBinaryInteger(Data, 2);
+				int64_t Weight = ToBinaryInteger(Data + 2, 2);
+				uint16_t Sign = (uint16_t)ToBinaryInteger(Data + 4, 2);
+				int64_t Scale = ToBinaryInteger(Data + 6, 2);
+				if (Sign == 0xC000 || Digits < 0 || Size < 8 + Digits * 2)
+					return "NaN";
+				else if (Sign == 0xD000)
+					return "Infinity";
+				else if (Sign == 0xF000)
+					return "-Infinity";
+
+				auto Digit = [Data, Digits](int64_t Index) -> int64_t
+				{
+					return Index >= 0 && Index < Digits ? ToBinaryInteger(Data + 8 + Index * 2, 2) : 0;
+				};
+
+				Core::String Result;
+				if (Sign == 0x4000)
+					Result.append(1, '-');
+
+				if (Weight < 0)
+					Result.append(1, '0');
+				else
+				{
+					Result.append(Core::ToString(Digit(0)));
+					for (int64_t i = 1; i <= Weight; i++)
+					{
+						Core::String Group = Core::ToString(Digit(i));
+						Result.append(4 - Group.size(), '0').append(Group);
+					}
+				}
+
+				if (Scale <= 0)
+					return Result;
+
+				Core::String Fraction;
+				for (int64_t i = Weight + 1; (int64_t)Fraction.size() < Scale; i++)
+				{
+					Core::String Group = Core::ToString(Digit(i));
+					Fraction.append(4 - Group.size(), '0').append(Group);
+				}
+
+				Fraction.resize((size_t)Scale);
+				return Result + '.' + Fraction;
+			}
+			static Core::String ToBinaryDate(int64_t Days)
+			{
+				int64_t Z = Days + 10957 + 719468;
+				int64_t Era = (Z >= 0 ? Z : Z - 146096) / 146097;
+				int64_t DayOfEra = Z - Era * 146097;
+				int64_t YearOfEra = (DayOfEra - DayOfEra / 1460 + DayOfEra / 36524 - DayOfEra / 146096) / 365;
+				int64_t DayOfYear = DayOfEra - (365 * YearOfEra + YearOfEra / 4 - YearOfEra / 100);
+				int64_t MonthPart = (5 * DayOfYear + 2) / 153;
+				int64_t Day = DayOfYear - (153 * MonthPart + 2) / 5 + 1;
+				int64_t Month = MonthPart < 10 ? MonthPart + 3 : MonthPart - 9;
+				int64_t Year = YearOfEra + Era * 400 + (Month <= 2 ? 1 : 0);
+				return Core::Stringify::Text("%04" PRId64 "-%02" PRId64 "-%02" PRId64, Year, Month, Day);
+			}
+			static Core::String ToBinaryTime(int64_t Microseconds)
+			{
+				int64_t Fraction = Microseconds % 1000000;
+				int64_t Seconds = Microseconds / 1000000;
+				Core::String Result = Core::Stringify::Text("%02" PRId64 ":%02" PRId64 ":%02" PRId64, Seconds / 3600, (Seconds / 60) % 60, Seconds % 60);
+				if (!Fraction)
+					return Result;
+
+				Core::String Digits = Core::Stringify::Text(".%06" PRId64, Fraction);
+				while (Digits.back() == '0')
+					Digits.pop_back();
+
+				return Result + Digits;
+			}
+			static Core::String ToBinaryTimestamp(int64_t Microseconds)
+			{
+				int64_t Day = 86400000000LL;
+				int64_t Days = Microseconds / Day;
+				int64_t Remainder = Microseconds % Day;
+				if (Remainder < 0)
+				{
+					Remainder += Day;
+					--Days;
+				}
+
+				return ToBinaryDate(Days) + ' ' + ToBinaryTime(Remainder);
+			}
+			static Core::Variant ToBinaryVariant(const char* Data, int Size, uint32_t Id)
+			{
+				OidType Type = (OidType)Id;
+				switch (Type)
+				{
+					case OidType::Bool:
+						return Core::Var::Boolean(Size > 0 && Data[0] != 0);
+					case OidType::Int2:
+					case OidType::Int4:
+					case OidType::Int8:
+						return Core::Var::Integer(ToBinaryInteger(Data, Size));
+					case OidType::Float4:
+					{
+						uint32_t Bits = (uint32_t)ToBinaryInteger(Data, Size == 4 ? 4 : 0);
+						float Value = 0.0f;
+						memcpy(&Value, &Bits, sizeof(Value));
+						return Core::Var::Number((double)Value);
+					}
+					case OidType::Float8:
+					{
+						uint64_t Bits = (uint64_t)ToBinaryInteger(Data, Size == 8 ? 8 : 0);
+						double Value = 0.0;
+						memcpy(&Value, &Bits, sizeof(Value));
+						return Core::Var::Number(Value);
+					}
+					case OidType::Numeric:
+						return Core::Var::DecimalString(ToBinaryNumeric(Data, Size));
+					case OidType::Money:
+					{
+						int64_t Value = ToBinaryInteger(Data, Size);
+						Core::String Cents = Core::ToString(Value < 0 ? -(Value % 100) : Value % 100);
+						return Core::Var::DecimalString(Core::Stringify::Text("%s%" PRId64 ".%s%s", Value < 0 && Value > -100 ? "-" : "", Value / 100, Cents.size() < 2 ? "0" : "", Cents.c_str()));
+					}
+					case OidType::Date:
+						return Core::Var::String(ToBinaryDate(ToBinaryInteger(Data, Size)));
+					case OidType::Time:
+						return Core::Var::String(ToBinaryTime(ToBinaryInteger(Data, Size)));
+					case OidType::Timestamp:
+						return Core::Var::String(ToBinaryTimestamp(ToBinaryInteger(Data, Size)));
+					case OidType::TimestampTZ:
+						return Core::Var::String(ToBinaryTimestamp(ToBinaryInteger(Data, Size)) + "+00");
+					case OidType::UUID:
+					{
+						if (Size != 16)
+							return Core::Var::Binary((uint8_t*)Data, (size_t)Size);
+
+						Core::String Hex = Compute::Codec::HexEncode(std::string_view(Data, (size_t)Size));
+						Hex.insert(20, 1, '-');
+						Hex.insert(16, 1, '-');
+						Hex.insert(12, 1, '-');
+						Hex.insert(8, 1, '-');
+						return Core::Var::String(Hex);
+					}
+					case OidType::JSONB:
+						return Core::Var::String(Size > 0 ? std::string_view(Data + 1, (size_t)Size - 1) : std::string_view());
+					case OidType::Char:
+					case OidType::JSON:
+					case OidType::Name:
+					case OidType::Text:
+					case OidType::CString:
+					case OidType::BpChar:
+					case OidType::VarChar:
+						return Core::Var::String(std::string_view(Data, (size_t)Size));
+					case OidType::Bytea:
+					default:
+						return Core::Var::Binary((uint8_t*)Data, (size_t)Size);
+				}
+			}
+			static Core::Schema* ToBinarySchema(const char* Data, int Size, uint32_t Id);
+			static Core::Schema* ToBinaryArray(const char* Data, int Size)
+			{
+				if (Size < 12)
+					return new Core::Schema(Core::Var::Binary((uint8_t*)Data, (size_t)std::max(Size, 0)));
+
+				int64_t Dimensions = ToBinaryInteger(Data, 4);
+				uint32_t Type = (uint32_t)ToBinaryInteger(Data + 8, 4);
+				if (Dimensions < 0 || Size < 12 + Dimensions * 8)
+					return new Core::Schema(Core::Var::Binary((uint8_t*)Data, (size_t)Size));
+
+				Core::Vector<int64_t> Sizes;
+				Sizes.reserve((size_t)Dimensions);
+				for (int64_t i = 0; i < Dimensions; i++)
+					Sizes.push_back(ToBinaryInteger(Data + 12 + i * 8, 4));
+
+				int Offset = 12 + (int)Dimensions * 8;
+				std::function<Core::Schema*(size_t)> Parse = [&](size_t Level) -> Core::Schema*
+				{
+					Core::Schema* Result = Core::Var::Set::Array();
+					if (Level >= Sizes.size())
+						return Result;
+
+					for (int64_t i = 0; i < Sizes[Level]; i++)
+					{
+						if (Level + 1 < Sizes.size())
+						{
+							Result->Push(Parse(Level + 1));
+							continue;
+						}
+						else if (Offset + 4 > Size)
+							break;
+
+						int64_t Length = ToBinaryInteger(Data + Offset, 4);
+						Offset += 4;
+						if (Length < 0)
+						{
+							Result->Push(Core::Var::Set::Null());
+							continue;
+						}
+						else if (Offset + Length > Size)
+							break;
+
+						Result->Push(ToBinarySchema(Data + Offset, (int)Length, Type));
+						Offset += (int)Length;
+					}
+
+					return Result;
+				};
+				return Parse(0);
+			}
+			Core::Schema* ToBinarySchema(const char* Data, int Size, uint32_t Id)
+			{
+				OidType Type = (OidType)Id;
+				switch (Type)
+				{
+					case OidType::JSON:
+					case OidType::JSONB:
+					{
+						std::string_view Text = (Type == OidType::JSONB && Size > 0 ? std::string_view(Data + 1, (size_t)Size - 1) : std::string_view(Data, (size_t)Size));
+						auto Result = Core::Schema::ConvertFromJSON(Text);
+						if (Result)
+							return *Result;
+
+						return new Core::Schema(Core::Var::String(Text));
+					}
+					case OidType::Any_Array:
+					case OidType::Name_Array:
+					case OidType::Text_Array:
+					case OidType::Date_Array:
+					case OidType::Time_Array:
+					case OidType::UUID_Array:
+					case OidType::CString_Array:
+					case OidType::BpChar_Array:
+					case OidType::VarChar_Array:
+					case OidType::Bit_Array:
+					case OidType::VarBit_Array:
+					case OidType::Char_Array:
+					case OidType::Int2_Array:
+					case OidType::Int4_Array:
+					case OidType::Int8_Array:
+					case OidType::Bool_Array:
+					case OidType::Float4_Array:
+					case OidType::Float8_Array:
+					case OidType::Money_Array:
+					case OidType::Numeric_Array:
+					case OidType::Bytea_Array:
+						return ToBinaryArray(Data, Size);
+					default:
+						return new Core::Schema(ToBinaryVariant(Data, Size, Id));
+				}
+			}
+			static Core::Variant ToVariant(const char* Data, int Size, uint32_t Id, bool Binary = false)
 			{
 				if (!Data)
 					return Core::Var::Null();
+				else if (Binary)
+					return ToBinaryVariant(Data, Size, Id);
 
 				OidType Type = (OidType)Id;
 				switch (Type)
@@ -274,10 +540,12 @@ namespace Vitex
 
 				return Context.first;
 			}
-			Core::Schema* ToSchema(const char* Data, int Size, uint32_t Id)
+			Core::Schema* ToSchema(const char* Data, int Size, uint32_t Id, bool Binary)
 			{
 				if (!Data)
 					return nullptr;
+				else if (Binary)
+					return ToBinarySchema(Data, Size, Id);
 
 				OidType Type = (OidType)Id;
 				switch (Type)
@@ -358,75 +626,351 @@ namespace Vitex
 				}
 			}
 #endif
-			DatabaseException::DatabaseException(TConnection* Connection)
+			static void ToArrayParameter(Core::Schema* Source, bool Negate, Core::String& Result)
 			{
-#ifdef VI_POSTGRESQL
-				VI_ASSERT(Connection != nullptr, "base should be set");
-				char* NewMessage = PQerrorMessage(Connection);
-				if (!NewMessage || NewMessage[0] == '\0')
-					return;
-
-				Core::String Buffer(NewMessage);
-				Buffer.erase(Buffer.size() - 1);
-				for (auto& Item : Core::Stringify::Split(Buffer, '\n'))
+				switch (Source->Value.GetType())
 				{
-					if (Item.empty())
-						continue;
-					if (Message.empty())
-						Message += Item;
-					else
-						Message += ", " + Item;
+					case Core::VarType::Array:
+					{
+						Result.append(1, '{');
+						for (auto* Node : Source->GetChilds())
+						{
+							ToArrayParameter(Node, Negate, Result);
+							Result.append(1, ',');
+						}
+
+						if (!Source->Empty())
+							Result.back() = '}';
+						else
+							Result.append(1, '}');
+						break;
+					}
+					case Core::VarType::Integer:
+						Result.append(Core::ToString(Negate ? -Source->Value.GetInteger() : Source->Value.GetInteger()));
+						break;
+					case Core::VarType::Number:
+						Result.append(Core::ToString(Negate ? -Source->Value.GetNumber() : Source->Value.GetNumber()));
+						break;
+					case Core::VarType::Boolean:
+						Result.append((Negate ? !Source->Value.GetBoolean() : Source->Value.GetBoolean()) ? "true" : "false");
+						break;
+					case Core::VarType::Decimal:
+					{
+						Core::Decimal Value = Source->Value.GetDecimal();
+						if (!Value.IsNaN())
+							Result.append(Negate ? '-' + Value.ToString() : Value.ToString());
+						else
+							Result.append("NULL");
+						break;
+					}
+					case Core::VarType::Null:
+					case Core::VarType::Undefined:
+						Result.append("NULL");
+						break;
+					default:
+					{
+						Core::String Value;
+						if (Source->Value.GetType() == Core::VarType::Object)
+							Core::Schema::ConvertToJSON(Source, [&Value](Core::VarForm, const std::string_view& Buffer) { Value.append(Buffer); });
+						else if (Source->Value.GetType() == Core::VarType::Binary)
+							Value = "\\x" + Compute::Codec::HexEncode(Source->Value.GetString());
+						else
+							Value = Source->Value.GetBlob();
+
+						Core::Stringify::Replace(Value, "\\", "\\\\");
+						Core::Stringify::Replace(Value, "\"", "\\\"");
+						Result.append(1, '"').append(Value).append(1, '"');
+						break;
+					}
 				}
-#else
-				Message = "not supported";
-#endif
-			}
-			DatabaseException::DatabaseException(Core::String&& NewMessage)
-			{
-				Message = std::move(NewMessage);
 			}
-			const char* DatabaseException::type() const noexcept
+			static std::pair<Core::String, int> ToParameter(Core::Schema* Source, bool Negate)
 			{
-				return "postgresql_error";
-			}
+				if (!Source)
+					return { Core::String(), -1 };
 
-			Address::Address()
-			{
+				switch (Source->Value.GetType())
+				{
+					case Core::VarType::Object:
+					{
+						Core::String Result;
+						Core::Schema::ConvertToJSON(Source, [&Result](Core::VarForm, const std::string_view& Buffer) { Result.append(Buffer); });
+						return { std::move(Result), 0 };
+					}
+					case Core::VarType::Array:
+					{
+						Core::String Result;
+						ToArrayParameter(Source, Negate, Result);
+						return { std::move(Result), 0 };
+					}
+					case Core::VarType::String:
+						return { Source->Value.GetBlob(), 0 };
+					case Core::VarType::Integer:
+						return { Core::ToString(Negate ? -Source->Value.GetInteger() : Source->Value.GetInteger()), 0 };
+					case Core::VarType::Number:
+						return { Core::ToString(Negate ? -Source->Value.GetNumber() : Source->Value.GetNumber()), 0 };
+					case Core::VarType::Boolean:
+						return { (Negate ? !Source->Value.GetBoolean() : Source->Value.GetBoolean()) ? "true" : "false", 0 };
+					case Core::VarType::Decimal:
+					{
+						Core::Decimal Value = Source->Value.GetDecimal();
+						if (Value.IsNaN())
+							return { Core::String(), -1 };
+
+						return { Negate ? '-' + Value.ToString() : Value.ToString(), 0 };
+					}
+					case Core::VarType::Binary:
+						return { Source->Value.GetBlob(), 1 };
+					default:
+						return { Core::String(), -1 };
+				}
 			}
-			void Address::Override(const std::string_view& Key, const std::string_view& Value)
+			static void ToCopyInteger(Core::String& Buffer, uint64_t Value, size_t Size)
 			{
-				Params[Core::String(Key)] = Value;
+				for (size_t i = Size; i-- > 0;)
+					Buffer.append(1, (char)((Value >> (i * 8)) & 0xFF));
 			}
-			bool Address::Set(AddressOp Key, const std::string_view& Value)
+			static bool ToCopyNumeric(Core::String& Buffer, const std::string_view& Text)
 			{
-				Core::String Name = Core::String(GetKeyName(Key));
-				if (Name.empty())
+				std::string_view Value = Text;
+				while (!Value.empty() && Core::Stringify::IsWhitespace(Value.front()))
+					Value.remove_prefix(1);
+				while (!Value.empty() && Core::Stringify::IsWhitespace(Value.back()))
+					Value.remove_suffix(1);
+
+				if (Value == "NaN")
+				{
+					ToCopyInteger(Buffer, 0, 4);
+					ToCopyInteger(Buffer, 0xC000, 2);
+					ToCopyInteger(Buffer, 0, 2);
+					return true;
+				}
+
+				bool Negative = !Value.empty() && Value.front() == '-';
+				if (!Value.empty() && (Value.front() == '-' || Value.front() == '+'))
+					Value.remove_prefix(1);
+
+				size_t Point = Value.find('.');
+				Core::String Integer = Core::String(Value.substr(0, Point));
+				Core::String Fraction = Core::String(Point == std::string::npos ? std::string_view() : Value.substr(Point + 1));
+				if (Integer.empty() && Fraction.empty())
 					return false;
 
-				Params[Name] = Value;
+				for (char Digit : Integer)
+				{
+					if (!isdigit((uint8_t)Digit))
+						return false;
+				}
+				for (char Digit : Fraction)
+				{
+					if (!isdigit((uint8_t)Digit))
+						return false;
+				}
+
+				size_t Scale = Fraction.size();
+				Integer.insert(0, (4 - Integer.size() % 4) % 4, '0');
+				Fraction.append((4 - Fraction.size() % 4) % 4, '0');
+
+				Core::Vector<uint16_t> Digits;
+				Digits.reserve((Integer.size() + Fraction.size()) / 4);
+				Core::String Number = Integer + Fraction;
+				for (size_t i = 0; i < Number.size(); i += 4)
+					Digits.push_back((uint16_t)((Number[i] - '0') * 1000 + (Number[i + 1] - '0') * 100 + (Number[i + 2] - '0') * 10 + (Number[i + 3] - '0')));
+
+				int64_t Weight = (int64_t)(Integer.size() / 4) - 1;
+				size_t Start = 0, End = Digits.size();
+				while (Start < End && !Digits[Start])
+				{
+					++Start;
+					--Weight;
+				}
+				while (End > Start && !Digits[End - 1])
+					--End;
+
+				if (Start == End)
+				{
+					Weight = 0;
+					Negative = false;
+				}
+
+				ToCopyInteger(Buffer, (uint64_t)(End - Start), 2);
+				ToCopyInteger(Buffer, (uint64_t)Weight, 2);
+				ToCopyInteger(Buffer, Negative ? 0x4000 : 0x0000, 2);
+				ToCopyInteger(Buffer, (uint64_t)Scale, 2);
+				for (size_t i = Start; i < End; i++)
+					ToCopyInteger(Buffer, Digits[i], 2);
+
 				return true;
 			}
-			Core::String Address::Get(AddressOp Key) const
+			static bool IsTransactionBoundary(const std::string_view& Command)
 			{
-				auto It = Params.find(Core::KeyLookupCast(GetKeyName(Key)));
-				if (It == Params.end())
-					return "";
+				size_t Start = 0;
+				while (Start < Command.size() && Core::Stringify::IsWhitespace(Command[Start]))
+					++Start;
 
-				return It->second;
-			}
-			Core::String Address::GetAddress() const
-			{
-				Core::String Hostname = Get(AddressOp::Ip);
-				if (Hostname.empty())
-					Hostname = Get(AddressOp::Host);
+				size_t End = Start;
+				while (End < Command.size() && isalpha((uint8_t)Command[End]))
+					++End;
 
-				return "postgresql://" + Hostname + ':' + Get(AddressOp::Port) + '/';
+				Core::String Keyword = Core::String(Command.substr(Start, End - Start));
+				Core::Stringify::ToUpper(Keyword);
+				return Keyword == "BEGIN" || Keyword == "START" || Keyword == "COMMIT" || Keyword == "END" || Keyword == "ROLLBACK" || Keyword == "ABORT";
 			}
-			const Core::UnorderedMap<Core::String, Core::String>& Address::Get() const
+			static bool IsSingleStatement(const std::string_view& Command)
 			{
-				return Params;
-			}
-			std::string_view Address::GetKeyName(AddressOp Key)
+				size_t Offset = Command.find(';');
+				if (Offset == std::string::npos)
+					return true;
+
+				for (size_t i = Offset + 1; i < Command.size(); i++)
+				{
+					if (Command[i] != '\0' && !Core::Stringify::IsWhitespace(Command[i]))
+						return false;
+				}
+
+				return true;
+			}
+			static void ReleaseResponse(TResponse*& Base, std::atomic<uint32_t>*& Shares)
+			{
+				if (Shares != nullptr)
+				{
+					if (--(*Shares) > 0)
+					{
+						Shares = nullptr;
+						Base = nullptr;
+						return;
+					}
+					Core::Memory::Delete(Shares);
+				}
+#ifdef VI_POSTGRESQL
+				if (Base != nullptr)
+					PQclear(Base);
+#endif
+				Base = nullptr;
+			}
+			static size_t GetResponseSize(TResponse* Base)
+			{
+#ifdef VI_POSTGRESQL
+				if (!Base)
+					return 0;
+#ifdef LIBPQ_HAS_PIPELINING
+				return PQresultMemorySize(Base);
+#else
+				int Rows = PQntuples(Base), Columns = PQnfields(Base);
+				size_t Size = sizeof(void*) * 32 + (size_t)Columns * 64;
+				for (int Row = 0; Row < Rows; Row++)
+				{
+					for (int Column = 0; Column < Columns; Column++)
+						Size += (size_t)PQgetlength(Base, Row, Column) + sizeof(void*) * 2;
+				}
+				return Size;
+#endif
+#else
+				return 0;
+#endif
+			}
+			static uint64_t GetCacheMix(uint64_t Value)
+			{
+				Value ^= Value >> 33;
+				Value *= 0xff51afd7ed558ccdllu;
+				Value ^= Value >> 33;
+				Value *= 0xc4ceb9fe1a85ec53llu;
+				Value ^= Value >> 33;
+				return Value;
+			}
+			static std::pair<uint64_t, uint64_t> GetCacheHash(const std::string_view& Data, uint64_t Seed)
+			{
+				const uint64_t Prime1 = 0x9e3779b185ebca87llu, Prime2 = 0xc2b2ae3d27d4eb4fllu;
+				uint64_t Low = Seed ^ (Data.size() * Prime1), High = ~Seed ^ (Data.size() * Prime2);
+				const char* Buffer = Data.data();
+				size_t Size = Data.size();
+				while (Size >= sizeof(uint64_t))
+				{
+					uint64_t Block;
+					memcpy(&Block, Buffer, sizeof(Block));
+					Low ^= Block * Prime2;
+					Low = (Low << 31 | Low >> 33) * Prime1;
+					High += Block * Prime1;
+					High = (High << 27 | High >> 37) * Prime2 + Low;
+					Buffer += sizeof(uint64_t);
+					Size -= sizeof(uint64_t);
+				}
+
+				uint64_t Block = 0;
+				memcpy(&Block, Buffer, Size);
+				Low ^= Block * Prime2;
+				High += Block * Prime1;
+				return std::make_pair(GetCacheMix(Low + High), GetCacheMix(High ^ (Low * Prime1)));
+			}
+			DatabaseException::DatabaseException(TConnection* Connection)
+			{
+#ifdef VI_POSTGRESQL
+				VI_ASSERT(Connection != nullptr, "base should be set");
+				char* NewMessage = PQerrorMessage(Connection);
+				if (!NewMessage || NewMessage[0] == '\0')
+					return;
+
+				Core::String Buffer(NewMessage);
+				Buffer.erase(Buffer.size() - 1);
+				for (auto& Item : Core::Stringify::Split(Buffer, '\n'))
+				{
+					if (Item.empty())
+						continue;
+					if (Message.empty())
+						Message += Item;
+					else
+						Message += ", " + Item;
+				}
+#else
+				Message = "not supported";
+#endif
+			}
+			DatabaseException::DatabaseException(Core::String&& NewMessage)
+			{
+				Message = std::move(NewMessage);
+			}
+			const char* DatabaseException::type() const noexcept
+			{
+				return "postgresql_error";
+			}
+
+			Address::Address()
+			{
+			}
+			void Address::Override(const std::string_view& Key, const std::string_view& Value)
+			{
+				Params[Core::String(Key)] = Value;
+			}
+			bool Address::Set(AddressOp Key, const std::string_view& Value)
+			{
+				Core::String Name = Core::String(GetKeyName(Key));
+				if (Name.empty())
+					return false;
+
+				Params[Name] = Value;
+				return true;
+			}
+			Core::String Address::Get(AddressOp Key) const
+			{
+				auto It = Params.find(Core::KeyLookupCast(GetKeyName(Key)));
+				if (It == Params.end())
+					return "";
+
+				return It->second;
+			}
+			Core::String Address::GetAddress() const
+			{
+				Core::String Hostname = Get(AddressOp::Ip);
+				if (Hostname.empty())
+					Hostname = Get(AddressOp::Host);
+
+				return "postgresql://" + Hostname + ':' + Get(AddressOp::Port) + '/';
+			}
+			const Core::UnorderedMap<Core::String, Core::String>& Address::Get() const
+			{
+				return Params;
+			}
+			std::string_view Address::GetKeyName(AddressOp Key)
 			{
 				switch (Key)
 				{
@@ -612,7 +1156,7 @@ namespace Vitex
 				int Size = PQgetlength(Base, (int)RowIndex, (int)ColumnIndex);
 				Oid Type = PQftype(Base, (int)ColumnIndex);
 
-				return ToVariant(Data, Size, Type);
+				return ToVariant(Data, Size, Type, PQfformat(Base, (int)ColumnIndex) == 1);
 #else
 				return Core::Var::Undefined();
 #endif
@@ -630,7 +1174,7 @@ namespace Vitex
 				int Size = PQgetlength(Base, (int)RowIndex, (int)ColumnIndex);
 				Oid Type = PQftype(Base, (int)ColumnIndex);
 
-				return ToSchema(Data, Size, Type);
+				return ToSchema(Data, Size, Type, PQfformat(Base, (int)ColumnIndex) == 1);
 #else
 				return nullptr;
 #endif
@@ -790,7 +1334,7 @@ namespace Vitex
 					Oid Type = PQftype(Base, j);
 
 					if (!Null)
-						Result->Set(Name ? Name : Core::ToString(j), ToSchema(Data, Count, Type));
+						Result->Set(Name ? Name : Core::ToString(j), ToSchema(Data, Count, Type, PQfformat(Base, j) == 1));
 					else
 						Result->Set(Name ? Name : Core::ToString(j), Core::Var::Null());
 				}
@@ -819,7 +1363,7 @@ namespace Vitex
 					int Count = PQgetlength(Base, (int)RowIndex, j);
 					bool Null = PQgetisnull(Base, (int)RowIndex, j) == 1;
 					Oid Type = PQftype(Base, j);
-					Result->Push(Null ? Core::Var::Set::Null() : ToSchema(Data, Count, Type));
+					Result->Push(Null ? Core::Var::Set::Null() : ToSchema(Data, Count, Type, PQfformat(Base, j) == 1));
 				}
 
 				return Result;
@@ -894,33 +1438,29 @@ namespace Vitex
 			{
 
 			}
-			Response::Response(TResponse* NewBase) : Base(NewBase), Failure(false)
+			Response::Response(TResponse* NewBase) : Shares(nullptr), Base(NewBase), Failure(false)
 			{
 			}
-			Response::Response(Response&& Other) : Base(Other.Base), Failure(Other.Failure)
+			Response::Response(Response&& Other) : Shares(Other.Shares), Base(Other.Base), Failure(Other.Failure)
 			{
+				Other.Shares = nullptr;
 				Other.Base = nullptr;
 				Other.Failure = false;
 			}
 			Response::~Response()
 			{
-#ifdef VI_POSTGRESQL
-				if (Base != nullptr)
-					PQclear(Base);
-				Base = nullptr;
-#endif
+				ReleaseResponse(Base, Shares);
 			}
 			Response& Response::operator =(Response&& Other)
 			{
 				if (&Other == this)
 					return *this;
 
-#ifdef VI_POSTGRESQL
-				if (Base != nullptr)
-					PQclear(Base);
-#endif
+				ReleaseResponse(Base, Shares);
+				Shares = Other.Shares;
 				Base = Other.Base;
 				Failure = Other.Failure;
+				Other.Shares = nullptr;
 				Other.Base = nullptr;
 				Other.Failure = false;
 				return *this;
@@ -941,12 +1481,15 @@ namespace Vitex
 					return Result;
 
 				Core::Vector<std::pair<Core::String, Oid>> Meta;
+				Core::Vector<bool> Formats;
 				Meta.reserve((size_t)ColumnsSize);
+				Formats.reserve((size_t)ColumnsSize);
 
 				for (int j = 0; j < ColumnsSize; j++)
 				{
 					char* Name = PQfname(Base, j);
 					Meta.emplace_back(std::make_pair(Name ? Name : Core::ToString(j), PQftype(Base, j)));
+					Formats.push_back(PQfformat(Base, j) == 1);
 				}
 
 				Result->Reserve((size_t)RowsSize);
@@ -963,7 +1506,7 @@ namespace Vitex
 						auto& Field = Meta[j];
 
 						if (!Null)
-							Subresult->Set(Field.first, ToSchema(Data, Size, Field.second));
+							Subresult->Set(Field.first, ToSchema(Data, Size, Field.second, Formats[j]));
 						else
 							Subresult->Set(Field.first, Core::Var::Null());
 					}
@@ -992,10 +1535,15 @@ namespace Vitex
 					return Result;
 
 				Core::Vector<Oid> Meta;
+				Core::Vector<bool> Formats;
 				Meta.reserve((size_t)ColumnsSize);
+				Formats.reserve((size_t)ColumnsSize);
 
 				for (int j = 0; j < ColumnsSize; j++)
+				{
 					Meta.emplace_back(PQftype(Base, j));
+					Formats.push_back(PQfformat(Base, j) == 1);
+				}
 
 				Result->Reserve((size_t)RowsSize);
 				for (int i = 0; i < RowsSize; i++)
@@ -1008,7 +1556,7 @@ namespace Vitex
 						char* Data = PQgetvalue(Base, i, j);
 						int Size = PQgetlength(Base, i, j);
 						bool Null = PQgetisnull(Base, i, j) == 1;
-						Subresult->Push(Null ? Core::Var::Set::Null() : ToSchema(Data, Size, Meta[j]));
+						Subresult->Push(Null ? Core::Var::Set::Null() : ToSchema(Data, Size, Meta[j], Formats[j]));
 					}
 
 					Result->Push(Subresult);
@@ -1263,6 +1811,21 @@ namespace Vitex
 				return Response();
 #endif
 			}
+			Response Response::Share()
+			{
+				Response Result;
+				if (!Base)
+					return Result;
+
+				if (!Shares)
+					Shares = Core::Memory::New<std::atomic<uint32_t>>(1);
+
+				++(*Shares);
+				Result.Shares = Shares;
+				Result.Base = Base;
+				Result.Failure = Failure;
+				return Result;
+			}
 			TResponse* Response::Get() const
 			{
 				return Base;
@@ -1373,6 +1936,20 @@ namespace Vitex
 
 				return Result;
 			}
+			Cursor Cursor::Share()
+			{
+				Cursor Result(Executor, Caching::Cached);
+				if (Base.empty())
+					return Result;
+
+				Result.Base.clear();
+				Result.Base.reserve(Base.size());
+
+				for (auto& Item : Base)
+					Result.Base.emplace_back(Item.Share());
+
+				return Result;
+			}
 			const Response& Cursor::First() const
 			{
 				VI_ASSERT(!Base.empty(), "index outside of range");
@@ -1425,7 +2002,7 @@ namespace Vitex
 				return Base[ResponseIndex].GetArray(Index);
 			}
 
-			Connection::Connection(TConnection* NewBase, socket_t Fd) : Base(NewBase), Stream(new Socket(Fd)), Current(nullptr), Status(QueryState::Idle)
+			Connection::Connection(TConnection* NewBase, socket_t Fd) : Base(NewBase), Stream(new Socket(Fd)), Current(nullptr), Status(QueryState::Idle), Cancelling(false)
 			{
 			}
 			Connection::~Connection() noexcept
@@ -1478,10 +2055,25 @@ namespace Vitex
 				return false;
 #endif
 			}
+			bool Connection::InPipeline() const
+			{
+				return !Pipeline.empty();
+			}
 			bool Connection::Busy() const
 			{
 				return Current != nullptr || Status == QueryState::Busy || Status == QueryState::BusyInTransaction;
 			}
+			void Connection::MakePrepared(const Core::String& Statement, size_t Capacity)
+			{
+				Statements.push_front(Statement);
+				Prepared[Statement] = Statements.begin();
+				while (Statements.size() > Capacity && Statements.size() > 1)
+				{
+					Prepared.erase(Statements.back());
+					Unprepared.push_back(std::move(Statements.back()));
+					Statements.pop_back();
+				}
+			}
 			void Connection::MakeBusy(Request* Data)
 			{
 				Status = InTransaction() ? QueryState::BusyInTransaction : QueryState::Busy;
@@ -1502,7 +2094,7 @@ namespace Vitex
 				return Copy;
 			}
 
-			Request::Request(const std::string_view& Commands, SessionId NewSession, Caching Status, uint64_t Rid, size_t NewOptions) : Command(Commands.begin(), Commands.end()), Time(Core::Schedule::GetClock()), Session(NewSession), Result(nullptr, Status), Id(Rid), Options(NewOptions)
+			Request::Request(const std::string_view& Commands, SessionId NewSession, Caching Status, uint64_t Rid, size_t NewOptions) : Command(Commands.begin(), Commands.end()), Time(Core::Schedule::GetClock()), Session(NewSession), Result(nullptr, Status), Id(Rid), Options(NewOptions), Skips(0), Rows(0), Stage(Step::Execute), Parameterized(false), Pipelinable(false), Boundary(false), Cancelled(false), Drained(false)
 			{
 				Command.emplace_back('\0');
 			}
@@ -1543,7 +2135,7 @@ namespace Vitex
 				return Future.IsPending();
 			}
 
-			Cluster::Cluster()
+			Cluster::Cluster() : StatementCapacity(256), PipelineDepth(0)
 			{
 				Multiplexer::Get()->Activate();
 			}
@@ -1568,8 +2160,14 @@ namespace Vitex
 			}
 			void Cluster::ClearCache()
 			{
-				Core::UMutex<std::mutex> Unique(Cache.Context);
-				Cache.Objects.clear();
+				for (auto& Shard : Cache.Shards)
+				{
+					Core::LinkedList<CacheEntry> Evicted;
+					Core::UMutex<std::mutex> Unique(Shard.Context);
+					Evicted.swap(Shard.Order);
+					Shard.Objects.clear();
+					Shard.Bytes = 0;
+				}
 			}
 			void Cluster::SetCacheCleanup(uint64_t Interval)
 			{
@@ -1593,6 +2191,18 @@ namespace Vitex
 						break;
 				}
 			}
+			void Cluster::SetCacheCapacity(size_t Bytes)
+			{
+				Cache.Capacity = Bytes;
+			}
+			void Cluster::SetStatementCapacity(size_t Capacity)
+			{
+				StatementCapacity = Capacity;
+			}
+			void Cluster::SetPipelineDepth(size_t Depth)
+			{
+				PipelineDepth = Depth;
+			}
 			void Cluster::SetWhenReconnected(const OnReconnect& NewCallback)
 			{
 				Core::UMutex<std::recursive_mutex> Unique(Update);
@@ -1905,15 +2515,148 @@ namespace Vitex
 
 				return Query(*Template, Opts, Session);
 			}
+			ExpectsPromiseDB<Cursor> Cluster::PreparedQuery(const std::string_view& Name, Core::SchemaArgs* Map, size_t Opts, SessionId Session)
+			{
+				VI_DEBUG("[pq] prepared query %s", Name.empty() ? "empty-query-name" : Core::String(Name).c_str());
+				Core::Vector<std::pair<Core::Schema*, bool>> Binds;
+				Core::String Statement;
+				auto Template = Driver::Get()->GetParameterizedQuery(Name, Map, &Binds, &Statement);
+				if (!Template)
+					return ExpectsPromiseDB<Cursor>(Template.Error());
+
+				Core::Vector<std::pair<Core::String, int>> Params;
+				Params.reserve(Binds.size());
+				for (auto& Item : Binds)
+					Params.emplace_back(ToParameter(Item.first, Item.second));
+
+				return Execute(*Template, &Params, std::move(Statement), nullptr, 0, Opts, Session);
+			}
+			ExpectsPromiseDB<Cursor> Cluster::ParameterizedQuery(const std::string_view& Command, Core::SchemaList* Map, size_t Opts, SessionId Session)
+			{
+				Core::Vector<std::pair<Core::String, int>> Params;
+				if (Map != nullptr)
+				{
+					Params.reserve(Map->size());
+					for (auto& Item : *Map)
+						Params.emplace_back(ToParameter(*Item, false));
+				}
+
+				return Execute(Command, &Params, Core::String(), nullptr, 0, Opts, Session);
+			}
+			ExpectsPromiseDB<Cursor> Cluster::CopyFrom(const std::string_view& Command, OnCopyIn&& Producer, SessionId Session)
+			{
+				VI_ASSERT(!Command.empty(), "command should not be empty");
+				VI_ASSERT(Producer != nullptr, "producer should be set");
+				if (!IsManaging(Session))
+					return ExpectsPromiseDB<Cursor>(DatabaseException("supplied transaction id does not exist"));
+
+				Driver::Get()->LogQuery(Command);
+				Request* Next = new Request(Command, Session, Caching::Never, ++Counter, 0);
+				Next->Input = std::move(Producer);
+				return Submit(Next);
+			}
+			ExpectsPromiseDB<Cursor> Cluster::CopyFromStream(const std::string_view& Command, Core::Stream* Source, SessionId Session)
+			{
+				VI_ASSERT(Source != nullptr, "stream should be set");
+				Source->AddRef();
+				return CopyFrom(Command, [Source](Core::String& Buffer) -> ExpectsDB<bool>
+				{
+					uint8_t Chunk[Core::BLOB_SIZE];
+					auto Size = Source->Read(Chunk, sizeof(Chunk));
+					if (!Size)
+						return DatabaseException("copy stream read error: " + Core::Copy<Core::String>(Size.Error().message()));
+
+					Buffer.append((char*)Chunk, *Size);
+					return *Size > 0;
+				}, Session).Then<ExpectsDB<Cursor>>([Source](ExpectsDB<Cursor>&& Result) -> ExpectsDB<Cursor>
+				{
+					Core::Memory::Release(Source);
+					return std::move(Result);
+				});
+			}
+			ExpectsPromiseDB<Cursor> Cluster::CopyFromRows(const std::string_view& Command, const Core::Vector<OidType>& Types, OnCopyRow&& Producer, SessionId Session)
+			{
+				VI_ASSERT(!Types.empty(), "types should not be empty");
+				VI_ASSERT(Producer != nullptr, "producer should be set");
+				return CopyFrom(Command, [Types, Producer = std::move(Producer), Header = false](Core::String& Buffer) mutable -> ExpectsDB<bool>
+				{
+					if (!Header)
+					{
+						Buffer.append(Utils::GetCopyHeader());
+						Header = true;
+					}
+
+					Core::VariantList Row;
+					while (Buffer.size() < Core::BLOB_SIZE * 8)
+					{
+						Row.clear();
+						if (!Producer(Row))
+						{
+							Buffer.append(Utils::GetCopyTrailer());
+							return false;
+						}
+
+						auto Status = Utils::WriteCopyRow(Buffer, Row, Types);
+						if (!Status)
+							return Status.Error();
+					}
+
+					return true;
+				}, Session);
+			}
+			ExpectsPromiseDB<Cursor> Cluster::CopyTo(const std::string_view& Command, OnCopyOut&& Consumer, SessionId Session)
+			{
+				VI_ASSERT(!Command.empty(), "command should not be empty");
+				VI_ASSERT(Consumer != nullptr, "consumer should be set");
+				if (!IsManaging(Session))
+					return ExpectsPromiseDB<Cursor>(DatabaseException("supplied transaction id does not exist"));
+
+				Driver::Get()->LogQuery(Command);
+				Request* Next = new Request(Command, Session, Caching::Never, ++Counter, 0);
+				Next->Output = std::move(Consumer);
+				return Submit(Next);
+			}
+			ExpectsPromiseDB<Cursor> Cluster::CopyToStream(const std::string_view& Command, Core::Stream* Target, SessionId Session)
+			{
+				VI_ASSERT(Target != nullptr, "stream should be set");
+				Target->AddRef();
+				return CopyTo(Command, [Target](const std::string_view& Buffer) -> bool
+				{
+					auto Size = Target->Write((uint8_t*)Buffer.data(), Buffer.size());
+					return Size && *Size == Buffer.size();
+				}, Session).Then<ExpectsDB<Cursor>>([Target](ExpectsDB<Cursor>&& Result) -> ExpectsDB<Cursor>
+				{
+					Core::Memory::Release(Target);
+					return std::move(Result);
+				});
+			}
+			ExpectsPromiseDB<Cursor> Cluster::StreamQuery(const std::string_view& Command, OnStream&& Callback, size_t ChunkRows, SessionId Session)
+			{
+				VI_ASSERT(Callback != nullptr, "callback should be set");
+				return Execute(Command, nullptr, Core::String(), std::move(Callback), ChunkRows, 0, Session);
+			}
 			ExpectsPromiseDB<Cursor> Cluster::Query(const std::string_view& Command, size_t Opts, SessionId Session)
+			{
+				return Execute(Command, nullptr, Core::String(), nullptr, 0, Opts, Session);
+			}
+			ExpectsPromiseDB<Cursor> Cluster::Execute(const std::string_view& Command, Core::Vector<std::pair<Core::String, int>>* Params, Core::String&& Statement, OnStream&& Stream, size_t ChunkRows, size_t Opts, SessionId Session)
 			{
 				VI_ASSERT(!Command.empty(), "command should not be empty");
-				Core::String Reference;
-				bool MayCache = Opts & (size_t)QueryOp::CacheShort || Opts & (size_t)QueryOp::CacheMid || Opts & (size_t)QueryOp::CacheLong;
+				Core::MemoryScope Scope(Core::MemoryTag::Database);
+				std::pair<uint64_t, uint64_t> Reference = { 0, 0 };
+				bool MayCache = !Stream && (Opts & (size_t)QueryOp::CacheShort || Opts & (size_t)QueryOp::CacheMid || Opts & (size_t)QueryOp::CacheLong);
 				if (MayCache)
 				{
 					Cursor Result(nullptr, Caching::Cached);
-					Reference = GetCacheOid(Command, Opts);
+					if (Params != nullptr)
+					{
+						Core::String Payload(Command);
+						for (auto& Item : *Params)
+							Payload.append(1, '\0').append(Core::ToString(Item.second)).append(1, ':').append(Item.first);
+						Reference = GetCacheOid(Payload, Opts);
+					}
+					else
+						Reference = GetCacheOid(Command, Opts);
 					if (GetCache(Reference, &Result))
 					{
 						Driver::Get()->LogQuery(Command);
@@ -1927,9 +2670,26 @@ namespace Vitex
 					Driver::Get()->LogQuery(Command);
 
 				Request* Next = new Request(Command, Session, MayCache ? Caching::Miss : Caching::Never, ++Counter, Opts);
-				if (!Reference.empty())
+				if (MayCache)
 					Next->Callback = [this, Reference, Opts](Cursor& Data) { SetCache(Reference, &Data, Opts); };
-
+				if (Params != nullptr)
+				{
+					Next->Params = std::move(*Params);
+					Next->Parameterized = true;
+					if (StatementCapacity > 0)
+						Next->Statement = std::move(Statement);
+				}
+				if (Stream != nullptr)
+				{
+					Next->Stream = std::move(Stream);
+					Next->Rows = ChunkRows;
+				}
+				Next->Pipelinable = !Next->Stream && IsSingleStatement(Command);
+				Next->Boundary = IsTransactionBoundary(Command);
+				return Submit(Next);
+			}
+			ExpectsPromiseDB<Cursor> Cluster::Submit(Request* Next)
+			{
 				auto Future = Next->Future;
 				Core::UMutex<std::recursive_mutex> Unique(Update);
 				Requests.push_back(Next);
@@ -1993,48 +2753,75 @@ namespace Vitex
 
 				return nullptr;
 			}
-			Core::String Cluster::GetCacheOid(const std::string_view& Payload, size_t Opts)
+			std::pair<uint64_t, uint64_t> Cluster::GetCacheOid(const std::string_view& Payload, size_t Opts)
 			{
-				auto Hash = Compute::Crypto::HashHex(Compute::Digests::SHA256(), Payload);
-				Core::String Reference = Hash ? Compute::Codec::HexEncode(*Hash) : Compute::Codec::HexEncode(Payload.substr(0, 32));
+				uint64_t Seed = 0;
 				if (Opts & (size_t)QueryOp::CacheShort)
-					Reference.append(".s");
+					Seed = (uint64_t)QueryOp::CacheShort;
 				else if (Opts & (size_t)QueryOp::CacheMid)
-					Reference.append(".m");
+					Seed = (uint64_t)QueryOp::CacheMid;
 				else if (Opts & (size_t)QueryOp::CacheLong)
-					Reference.append(".l");
+					Seed = (uint64_t)QueryOp::CacheLong;
 
-				return Reference;
+				return GetCacheHash(Payload, Seed);
+			}
+			CacheStatistics Cluster::GetCacheStatistics()
+			{
+				CacheStatistics Result;
+				Result.Hits = Cache.Hits;
+				Result.Misses = Cache.Misses;
+				Result.Evictions = Cache.Evictions;
+				Result.Capacity = Cache.Capacity;
+				for (auto& Shard : Cache.Shards)
+				{
+					Core::UMutex<std::mutex> Unique(Shard.Context);
+					Result.Entries += Shard.Objects.size();
+					Result.Bytes += Shard.Bytes;
+				}
+
+				return Result;
 			}
 			bool Cluster::IsConnected() const
 			{
 				return !Pool.empty();
 			}
-			bool Cluster::GetCache(const std::string_view& CacheOid, Cursor* Data)
+			bool Cluster::GetCache(const std::pair<uint64_t, uint64_t>& CacheOid, Cursor* Data)
 			{
-				VI_ASSERT(!CacheOid.empty(), "cache oid should not be empty");
 				VI_ASSERT(Data != nullptr, "cursor should be set");
-
-				Core::UMutex<std::mutex> Unique(Cache.Context);
-				auto It = Cache.Objects.find(Core::KeyLookupCast(CacheOid));
-				if (It == Cache.Objects.end())
+				auto& Shard = Cache.Shards[CacheOid.second % std::size(Cache.Shards)];
+				Core::LinkedList<CacheEntry> Evicted;
+				Core::UMutex<std::mutex> Unique(Shard.Context);
+				auto It = Shard.Objects.find(CacheOid.first);
+				if (It == Shard.Objects.end() || It->second->Check != CacheOid.second)
+				{
+					++Cache.Misses;
 					return false;
+				}
 
-				int64_t Time = time(nullptr);
-				if (It->second.first < Time)
+				auto Entry = It->second;
+				if (Entry->Expires < (int64_t)time(nullptr))
 				{
-					*Data = std::move(It->second.second);
-					Cache.Objects.erase(It);
+					Shard.Bytes -= Entry->Size;
+					Shard.Objects.erase(It);
+					Evicted.splice(Evicted.end(), Shard.Order, Entry);
+					++Cache.Misses;
+					return false;
 				}
-				else
-					*Data = It->second.second.Copy();
 
+				Shard.Order.splice(Shard.Order.begin(), Shard.Order, Entry);
+				*Data = Entry->Data.Share();
+				++Cache.Hits;
 				return true;
 			}
-			void Cluster::SetCache(const std::string_view& CacheOid, Cursor* Data, size_t Opts)
+			void Cluster::SetCache(const std::pair<uint64_t, uint64_t>& CacheOid, Cursor* Data, size_t Opts)
 			{
-				VI_ASSERT(!CacheOid.empty(), "cache oid should not be empty");
 				VI_ASSERT(Data != nullptr, "cursor should be set");
+				size_t Capacity = Cache.Capacity / std::size(Cache.Shards);
+				size_t Size = sizeof(CacheEntry);
+				for (auto& Item : Data->Base)
+					Size += sizeof(Response) + GetResponseSize(Item.Get());
+				if (Size > Capacity)
+					return;
 
 				int64_t Time = time(nullptr);
 				int64_t Timeout = Time;
@@ -2045,27 +2832,50 @@ namespace Vitex
 				else if (Opts & (size_t)QueryOp::CacheLong)
 					Timeout += Cache.LongDuration;
 
-				Core::UMutex<std::mutex> Unique(Cache.Context);
-				if (Cache.NextCleanup < Time)
+				CacheEntry Next;
+				Next.Data = Data->Share();
+				Next.Key = CacheOid.first;
+				Next.Check = CacheOid.second;
+				Next.Expires = Timeout;
+				Next.Size = Size;
+
+				auto& Shard = Cache.Shards[CacheOid.second % std::size(Cache.Shards)];
+				Core::LinkedList<CacheEntry> Evicted;
+				Core::UMutex<std::mutex> Unique(Shard.Context);
+				if (Shard.NextCleanup < Time)
 				{
-					Cache.NextCleanup = Time + Cache.CleanupDuration;
-					for (auto It = Cache.Objects.begin(); It != Cache.Objects.end();)
+					Shard.NextCleanup = Time + Cache.CleanupDuration;
+					for (auto It = Shard.Order.begin(); It != Shard.Order.end();)
 					{
-						if (It->second.first < Time)
-							It = Cache.Objects.erase(It);
-						else
-							++It;
+						auto Entry = It++;
+						if (Entry->Expires >= Time)
+							continue;
+
+						Shard.Bytes -= Entry->Size;
+						Shard.Objects.erase(Entry->Key);
+						Evicted.splice(Evicted.end(), Shard.Order, Entry);
 					}
 				}
 
-				auto It = Cache.Objects.find(Core::KeyLookupCast(CacheOid));
-				if (It != Cache.Objects.end())
+				auto It = Shard.Objects.find(Next.Key);
+				if (It != Shard.Objects.end())
 				{
-					It->second.second = Data->Copy();
-					It->second.first = Timeout;
+					Shard.Bytes -= It->second->Size;
+					Evicted.splice(Evicted.end(), Shard.Order, It->second);
+					Shard.Objects.erase(It);
+				}
+
+				Shard.Order.emplace_front(std::move(Next));
+				Shard.Objects[CacheOid.first] = Shard.Order.begin();
+				Shard.Bytes += Size;
+				while (Shard.Bytes > Capacity && Shard.Order.size() > 1)
+				{
+					auto Entry = std::prev(Shard.Order.end());
+					Shard.Bytes -= Entry->Size;
+					Shard.Objects.erase(Entry->Key);
+					Evicted.splice(Evicted.end(), Shard.Order, Entry);
+					++Cache.Evictions;
 				}
-				else
-					Cache.Objects[Core::String(CacheOid)] = std::make_pair(Timeout, Data->Copy());
 			}
 			bool Cluster::Reestablish(Connection* Target)
 			{
@@ -2073,18 +2883,33 @@ namespace Vitex
 				const char** Keys = Source.CreateKeys();
 				const char** Values = Source.CreateValues();
 				Core::UMutex<std::recursive_mutex> Unique(Update);
+				Core::Vector<Request*> BrokenRequests;
+				BrokenRequests.reserve(Target->Pipeline.size() + 1);
+				for (auto* Item : Target->Pipeline)
+				{
+					if (Item != nullptr)
+						BrokenRequests.push_back(Item);
+				}
+
 				auto* BrokenRequest = Target->MakeLost();
-				if (BrokenRequest != nullptr)
+				if (BrokenRequest != nullptr && Target->Pipeline.empty())
+					BrokenRequests.push_back(BrokenRequest);
+
+				Target->Pipeline.clear();
+				for (auto* Item : BrokenRequests)
 				{
-					VI_DEBUG("[pqerr] query reset on 0x%" PRIXPTR ": connection lost", (uintptr_t)Target->Base);
-					Core::Codefer([BrokenRequest]()
+					VI_DEBUG("[pqerr] query reset on 0x%" PRIXPTR ": connection lost (rid: %" PRIu64 ")", (uintptr_t)Target->Base, Item->Id);
+					Core::Codefer([Item]()
 					{
-						Core::UPtr<Request> Item = BrokenRequest;
-						Item->ReportFailure();
+						Core::UPtr<Request> Target = Item;
+						Target->ReportFailure();
 					});
 				}
 
 				Target->Stream->ClearEvents(false);
+				Target->Prepared.clear();
+				Target->Statements.clear();
+				Target->Unprepared.clear();
 				PQlogNoticeOf(Target->Base);
 				PQfinish(Target->Base);
 
@@ -2095,181 +2920,677 @@ namespace Vitex
 
 				if (!Target->Base || PQstatus(Target->Base) != ConnStatusType::CONNECTION_OK)
 				{
-					if (Target != nullptr)
-						PQlogNoticeOf(Target->Base);
+					if (Target != nullptr)
+						PQlogNoticeOf(Target->Base);
+
+					Core::Codefer([this, Target]() { Reestablish(Target); });
+					return false;
+				}
+
+				Core::Vector<Core::String> Channels;
+				Channels.reserve(Target->Listens.size());
+				for (auto& Item : Target->Listens)
+					Channels.push_back(Item);
+				Target->Listens.clear();
+
+				VI_DEBUG("[pq] OK reconnect on 0x%" PRIXPTR, (uintptr_t)Target->Base);
+				Target->MakeIdle();
+				Target->Stream->MigrateTo((socket_t)PQsocket(Target->Base));
+				PQsetnonblocking(Target->Base, 1);
+				PQsetNoticeProcessor(Target->Base, PQlogNotice, nullptr);
+				Consume(Target);
+				Unique.Negate();
+
+				bool Success = Reprocess(Target);
+				if (!Channels.empty())
+				{
+					if (Reconnected)
+					{
+						Reconnected(Channels).When([this, Channels](bool&& ListenToChannels)
+						{
+							if (ListenToChannels)
+								Listen(Channels);
+						});
+					}
+					else
+						Listen(Channels);
+				}
+				else if (Reconnected)
+					Reconnected(Channels);
+
+				return Success;
+#else
+				return false;
+#endif
+			}
+			bool Cluster::Consume(Connection* Base)
+			{
+#ifdef VI_POSTGRESQL
+				Core::UMutex<std::recursive_mutex> Unique(Update);
+				if (Base->Cancelling)
+					return false;
+				else if (Base->InPipeline())
+					return Enqueue(Base);
+				else if (Base->Busy())
+					return false;
+
+				for (auto It = Requests.begin(); It != Requests.end(); ++It)
+				{
+					Request* Context = *It;
+					if (Context->Session != nullptr)
+					{
+						if (Context->Session != Base)
+							continue;
+					}
+					else if (Base->InTransaction())
+						continue;
+#ifdef LIBPQ_HAS_PIPELINING
+					bool Pipelinable = PipelineDepth > 1 && Context->Pipelinable;
+					bool Pipelined = PQpipelineStatus(Base->Base) != PQ_PIPELINE_OFF;
+					if (Pipelinable && !Pipelined)
+						Pipelined = PQenterPipelineMode(Base->Base) == 1;
+					else if (!Pipelinable && Pipelined)
+						Pipelined = PQexitPipelineMode(Base->Base) != 1;
+
+					if (Pipelined)
+						return Pipelinable ? Enqueue(Base) : false;
+#endif
+					Context->Result.Executor = Base;
+					Base->MakeBusy(Context);
+					Requests.erase(It);
+					break;
+				}
+
+				if (!Base->Busy())
+					return false;
+
+				VI_MEASURE(Core::Timings::Intensive);
+				VI_DEBUG("[pq] execute query on 0x%" PRIXPTR "%s (rid: %" PRIu64 "): %.64s%s", (uintptr_t)Base, Base->InTransaction() ? " (transaction)" : "", Base->Current->Id, Base->Current->Command.data(), Base->Current->Command.size() > 64 ? " ..." : "");
+				if (Transmit(Base, Base->Current))
+				{
+					Flush(Base, false);
+					return true;
+				}
+
+				auto* BrokenRequest = Base->MakeIdle();
+				PQlogNoticeOf(Base->Base);
+				Core::Codefer([BrokenRequest]()
+				{
+					Core::UPtr<Request> Item = BrokenRequest;
+					Item->ReportFailure();
+				});
+				return true;
+#else
+				return false;
+#endif
+			}
+			bool Cluster::Reprocess(Connection* Source)
+			{
+				return Multiplexer::Get()->WhenReadable(Source->Stream, [this, Source](SocketPoll Event)
+				{
+					if (Packet::IsError(Event))
+						Reestablish(Source);
+					else if (!Packet::IsSkip(Event))
+						Dispatch(Source);
+				});
+			}
+			bool Cluster::Flush(Connection* Source, bool ListenForResults)
+			{
+#ifdef VI_POSTGRESQL
+				if (PQflush(Source->Base) == 1)
+				{
+					Source->Stream->ClearEvents(false);
+					return Multiplexer::Get()->WhenWriteable(Source->Stream, [this, Source](SocketPoll Event)
+					{
+						if (!Packet::IsSkip(Event))
+							Flush(Source, true);
+					});
+				}
+#endif
+				if (ListenForResults)
+					return Reprocess(Source);
+
+				return true;
+			}
+			bool Cluster::Dispatch(Connection* Source)
+			{
+#ifdef VI_POSTGRESQL
+				Core::MemoryScope Scope(Core::MemoryTag::Database);
+				VI_MEASURE(Core::Timings::Intensive);
+				Consume(Source);
+			Retry:
+				if (PQconsumeInput(Source->Base) != 1)
+					return Reestablish(Source);
+				else if (PQisBusy(Source->Base) != 0)
+					return Reprocess(Source);
+
+				Core::UMutex<std::recursive_mutex> Unique(Update);
+				PGnotify* Notification = nullptr;
+				while ((Notification = PQnotifies(Source->Base)) != nullptr)
+				{
+					if (Notification != nullptr && Notification->relname != nullptr)
+					{
+						auto It = Listeners.find(Notification->relname);
+						if (It != Listeners.end() && !It->second.empty())
+						{
+							Notify Event(Notification);
+							for (auto& Item : It->second)
+							{
+								OnNotification Callback = Item.second;
+								Core::Codefer([Event, Callback = std::move(Callback)]() { Callback(Event); });
+							}
+						}
+						VI_DEBUG("[pq] notification on channel @%s: %s", Notification->relname, Notification->extra ? Notification->extra : "[payload]");
+						PQfreeNotify(Notification);
+					}
+				}
+
+#ifdef LIBPQ_HAS_PIPELINING
+				if (Source->InPipeline())
+				{
+					Request* Context = Source->Pipeline.front();
+					Response Chunk(PQgetResult(Source->Base));
+					if (!Chunk.Exists())
+					{
+						if (Context != nullptr && Context->Skips > 0)
+							--Context->Skips;
+						goto Retry;
+					}
+
+					QueryExec Status = Chunk.GetStatus();
+					if (Status == QueryExec::Pipeline_Sync)
+					{
+						Source->Pipeline.pop_front();
+						if (Source->Pipeline.empty())
+							Source->MakeIdle();
+						else
+							Source->Current = Source->Pipeline.front();
+
+						if (Context != nullptr)
+						{
+							if (!Context->Result.Error())
+								VI_DEBUG("[pq] OK execute on 0x%" PRIXPTR " (%" PRIu64 " ms, rid: %" PRIu64 ", pipeline)", (uintptr_t)Source, Context->GetTiming(), Context->Id);
+
+							Core::Codefer([Context]()
+							{
+								Core::UPtr<Request> Item = Context;
+								Item->ReportCursor();
+							});
+						}
+
+						Consume(Source);
+						goto Retry;
+					}
+					else if (Context != nullptr && Status != QueryExec::Pipeline_Aborted)
+					{
+						if (Context->Skips > 0 && Chunk.Error())
+						{
+							auto It = Source->Prepared.find(Context->Statement);
+							if (It != Source->Prepared.end())
+							{
+								Source->Statements.erase(It->second);
+								Source->Prepared.erase(It);
+							}
+							Context->Result.Base.emplace_back(std::move(Chunk));
+						}
+						else if (!Context->Skips)
+							Context->Result.Base.emplace_back(std::move(Chunk));
+					}
+					goto Retry;
+				}
+#endif
+				Response Chunk(PQgetResult(Source->Base));
+				if (Chunk.Exists())
+				{
+					Request* Context = Source->Current;
+					QueryExec Status = Chunk.GetStatus();
+					if (Context != nullptr && Status == QueryExec::Copy_In)
+					{
+						Unique.Negate();
+						return Upload(Source);
+					}
+					else if (Context != nullptr && Status == QueryExec::Copy_Out)
+					{
+						Unique.Negate();
+						if (Download(Source))
+							goto Retry;
+
+						return true;
+					}
+					else if (Context != nullptr && Context->Stream && Context->Stage == Request::Step::Execute && (Status == QueryExec::Single_Tuple || Status == QueryExec::Tuples_Chunk))
+					{
+						if (Context->Cancelled)
+							goto Retry;
+
+						Unique.Negate();
+						auto Next = Context->Stream(std::move(Chunk));
+						if (Next.IsPending())
+						{
+							Next.When([this, Source, Context](bool&& Continue)
+							{
+								Core::UMutex<std::recursive_mutex> Unique(Update);
+								if (!Continue && Source->Current == Context)
+									Interrupt(Source, Context);
+
+								Unique.Negate();
+								Dispatch(Source);
+							});
+							return true;
+						}
+
+						bool Continue = Next.Get();
+						Unique.Negate();
+						if (!Continue)
+							Interrupt(Source, Context);
+						goto Retry;
+					}
+					else if (Context != nullptr && (Context->Stage == Request::Step::Execute || (Context->Stage == Request::Step::Prepare && Chunk.Error())))
+					{
+						Context->Result.Base.emplace_back(std::move(Chunk));
+						Context->Stage = Request::Step::Execute;
+					}
+					goto Retry;
+				}
+
+				PQlogNoticeOf(Source->Base);
+				if (Source->Current != nullptr && Source->Current->Stage != Request::Step::Execute)
+				{
+					Request* Context = Source->Current;
+					if (Context->Stage == Request::Step::Prepare)
+						Source->MakePrepared(Context->Statement, StatementCapacity);
+
+					if (Transmit(Source, Context))
+					{
+						Flush(Source, false);
+						goto Retry;
+					}
+
+					auto* BrokenRequest = Source->MakeIdle();
+					PQlogNoticeOf(Source->Base);
+					Core::Codefer([BrokenRequest]()
+					{
+						Core::UPtr<Request> Item = BrokenRequest;
+						Item->ReportFailure();
+					});
+					if (Consume(Source))
+						goto Retry;
+
+					return Reprocess(Source);
+				}
+
+				if (Source->Current != nullptr && !Source->Current->Result.Error())
+					VI_DEBUG("[pq] OK execute on 0x%" PRIXPTR " (%" PRIu64 " ms, rid: %" PRIu64 ")", (uintptr_t)Source, Source->Current->GetTiming(), Source->Current->Id);
+
+				auto* ReadyRequest = Source->MakeIdle();
+				if (ReadyRequest != nullptr)
+				{
+					Core::Codefer([ReadyRequest]()
+					{
+						Core::UPtr<Request> Item = ReadyRequest;
+						Item->ReportCursor();
+					});
+				}
+				if (Consume(Source))
+					goto Retry;
+
+				return Reprocess(Source);
+#else
+				return false;
+#endif
+			}
+			bool Cluster::Transmit(Connection* Base, Request* Context)
+			{
+#ifdef VI_POSTGRESQL
+				auto Split = [Base, Context](bool Sent) -> bool
+				{
+					if (!Sent || !Context->Stream)
+						return Sent;
+#ifdef LIBPQ_HAS_CHUNK_MODE
+					if (Context->Rows > 1 && PQsetChunkedRowsMode(Base->Base, (int)Context->Rows) == 1)
+						return true;
+#endif
+					if (PQsetSingleRowMode(Base->Base) != 1)
+						VI_DEBUG("[pqerr] cannot stream rows on 0x%" PRIXPTR " (rid: %" PRIu64 "): result will be buffered", (uintptr_t)Base, Context->Id);
+
+					return true;
+				};
+				bool Pipelined = false;
+#ifdef LIBPQ_HAS_PIPELINING
+				Pipelined = PQpipelineStatus(Base->Base) != PQ_PIPELINE_OFF;
+#endif
+				if (!Context->Parameterized && !Pipelined)
+					return Split(PQsendQuery(Base->Base, Context->Command.data()) == 1);
+
+				int Count = (int)Context->Params.size();
+				int Format = Context->Parameterized ? 1 : 0;
+				Core::Vector<const char*> Values;
+				Core::Vector<int> Lengths, Formats;
+				Core::Vector<Oid> Types;
+				Values.reserve(Context->Params.size());
+				Lengths.reserve(Context->Params.size());
+				Formats.reserve(Context->Params.size());
+				Types.reserve(Context->Params.size());
+				for (auto& Item : Context->Params)
+				{
+					Values.push_back(Item.second < 0 ? nullptr : Item.first.c_str());
+					Lengths.push_back((int)Item.first.size());
+					Formats.push_back(Item.second > 0 ? 1 : 0);
+					Types.push_back(Item.second > 0 ? (Oid)OidType::Bytea : 0);
+				}
+#ifdef LIBPQ_HAS_PIPELINING
+				if (Pipelined)
+				{
+					if (!Base->Unprepared.empty())
+					{
+						for (auto& Name : Base->Unprepared)
+						{
+							Core::String Command = "DEALLOCATE " + Name;
+							if (PQsendQueryParams(Base->Base, Command.c_str(), 0, nullptr, nullptr, nullptr, nullptr, 0) != 1)
+								return false;
+						}
+
+						Base->Unprepared.clear();
+						if (PQpipelineSync(Base->Base) != 1)
+							return false;
+
+						Base->Pipeline.push_back(nullptr);
+					}
+
+					Context->Skips = 0;
+					Context->Stage = Request::Step::Execute;
+					if (!Context->Statement.empty())
+					{
+						auto It = Base->Prepared.find(Context->Statement);
+						if (It != Base->Prepared.end())
+							Base->Statements.splice(Base->Statements.begin(), Base->Statements, It->second);
+						else if (PQsendPrepare(Base->Base, Context->Statement.c_str(), Context->Command.data(), Count, Types.data()) == 1)
+						{
+							Base->MakePrepared(Context->Statement, StatementCapacity);
+							Context->Skips = 1;
+						}
+						else
+							return false;
+
+						if (PQsendQueryPrepared(Base->Base, Context->Statement.c_str(), Count, Values.data(), Lengths.data(), Formats.data(), Format) != 1)
+							return false;
+					}
+					else if (PQsendQueryParams(Base->Base, Context->Command.data(), Count, nullptr, Values.data(), Lengths.data(), Formats.data(), Format) != 1)
+						return false;
+
+					return PQpipelineSync(Base->Base) == 1;
+				}
+#endif
+				if (Context->Statement.empty())
+				{
+					Context->Stage = Request::Step::Execute;
+					return Split(PQsendQueryParams(Base->Base, Context->Command.data(), Count, nullptr, Values.data(), Lengths.data(), Formats.data(), Format) == 1);
+				}
+
+				auto It = Base->Prepared.find(Context->Statement);
+				if (It != Base->Prepared.end())
+				{
+					Base->Statements.splice(Base->Statements.begin(), Base->Statements, It->second);
+					Context->Stage = Request::Step::Execute;
+					return Split(PQsendQueryPrepared(Base->Base, Context->Statement.c_str(), Count, Values.data(), Lengths.data(), Formats.data(), Format) == 1);
+				}
+				else if (!Base->Unprepared.empty())
+				{
+					Core::String Command;
+					for (auto& Name : Base->Unprepared)
+						Command.append("DEALLOCATE ").append(Name).append(1, ';');
 
-					Core::Codefer([this, Target]() { Reestablish(Target); });
-					return false;
+					Base->Unprepared.clear();
+					Context->Stage = Request::Step::Deallocate;
+					return PQsendQuery(Base->Base, Command.c_str()) == 1;
 				}
 
-				Core::Vector<Core::String> Channels;
-				Channels.reserve(Target->Listens.size());
-				for (auto& Item : Target->Listens)
-					Channels.push_back(Item);
-				Target->Listens.clear();
+				Context->Stage = Request::Step::Prepare;
+				return PQsendPrepare(Base->Base, Context->Statement.c_str(), Context->Command.data(), Count, Types.data()) == 1;
+#else
+				return false;
+#endif
+			}
+			void Cluster::Interrupt(Connection* Base, Request* Context)
+			{
+#ifdef VI_POSTGRESQL
+				Context->Cancelled = true;
+				if (Base->Cancelling)
+					return;
 
-				VI_DEBUG("[pq] OK reconnect on 0x%" PRIXPTR, (uintptr_t)Target->Base);
-				Target->MakeIdle();
-				Target->Stream->MigrateTo((socket_t)PQsocket(Target->Base));
-				PQsetnonblocking(Target->Base, 1);
-				PQsetNoticeProcessor(Target->Base, PQlogNotice, nullptr);
-				Consume(Target);
-				Unique.Negate();
+				uintptr_t Address = (uintptr_t)Base;
+				uint64_t Id = Context->Id;
+#ifdef LIBPQ_HAS_ASYNC_CANCEL
+				PGcancelConn* Cancel = PQcancelCreate(Base->Base);
+				if (!Cancel)
+					return;
 
-				bool Success = Reprocess(Target);
-				if (!Channels.empty())
+				Base->Cancelling = true;
+				Base->AddRef();
+				Core::Cotask<void>([this, Base, Cancel, Address, Id]()
 				{
-					if (Reconnected)
-					{
-						Reconnected(Channels).When([this, Channels](bool&& ListenToChannels)
-						{
-							if (ListenToChannels)
-								Listen(Channels);
-						});
-					}
+					if (PQcancelBlocking(Cancel) != 1)
+						VI_DEBUG("[pqerr] cancel query on 0x%" PRIXPTR " (rid: %" PRIu64 "): %s", Address, Id, PQcancelErrorMessage(Cancel));
 					else
-						Listen(Channels);
-				}
-				else if (Reconnected)
-					Reconnected(Channels);
-
-				return Success;
+						VI_DEBUG("[pq] cancel query on 0x%" PRIXPTR " (rid: %" PRIu64 ")", Address, Id);
+					PQcancelFinish(Cancel);
+					Resume(Base);
+				}, true);
 #else
-				return false;
+				PGcancel* Cancel = PQgetCancel(Base->Base);
+				if (!Cancel)
+					return;
+
+				Base->Cancelling = true;
+				Base->AddRef();
+				Core::Cotask<void>([this, Base, Cancel, Address, Id]()
+				{
+					char Error[256] = { 0 };
+					if (PQcancel(Cancel, Error, (int)sizeof(Error)) != 1)
+						VI_DEBUG("[pqerr] cancel query on 0x%" PRIXPTR " (rid: %" PRIu64 "): %s", Address, Id, Error);
+					else
+						VI_DEBUG("[pq] cancel query on 0x%" PRIXPTR " (rid: %" PRIu64 ")", Address, Id);
+					PQfreeCancel(Cancel);
+					Resume(Base);
+				}, true);
+#endif
 #endif
 			}
-			bool Cluster::Consume(Connection* Base)
+			void Cluster::Resume(Connection* Base)
 			{
 #ifdef VI_POSTGRESQL
 				Core::UMutex<std::recursive_mutex> Unique(Update);
-				if (Base->Busy())
+				Base->Cancelling = false;
+				bool Idle = Pool.find(Base->Stream) != Pool.end() && !Base->Busy();
+				Unique.Negate();
+				if (Idle)
+					Dispatch(Base);
+				Base->Release();
+#endif
+			}
+			bool Cluster::Upload(Connection* Source)
+			{
+#ifdef VI_POSTGRESQL
+				Core::UMutex<std::recursive_mutex> Unique(Update);
+				Request* Context = Source->Current;
+				if (!Context)
 					return false;
 
-				for (auto It = Requests.begin(); It != Requests.end(); ++It)
+				if (!Context->Input && !Context->Drained)
 				{
-					Request* Context = *It;
-					if (Context->Session != nullptr)
+					Context->Payload = "copy source is not set";
+					Context->Cancelled = true;
+					Context->Drained = true;
+				}
+
+				while (true)
+				{
+					int Flushed = PQflush(Source->Base);
+					if (Flushed < 0)
 					{
-						if (Context->Session != Base)
-							continue;
+						Unique.Negate();
+						return Reestablish(Source);
 					}
-					else if (Base->InTransaction())
-						continue;
+					else if (Flushed == 1)
+						break;
 
-					Context->Result.Executor = Base;
-					Base->MakeBusy(Context);
-					Requests.erase(It);
-					break;
-				}
+					if (Context->Drained && (Context->Payload.empty() || Context->Cancelled))
+					{
+						int Code = PQputCopyEnd(Source->Base, Context->Cancelled ? Context->Payload.c_str() : nullptr);
+						if (Code == 0)
+							break;
+
+						VI_DEBUG("[pq] %s copy on 0x%" PRIXPTR " (rid: %" PRIu64 ")", Context->Cancelled ? "abort" : "end", (uintptr_t)Source, Context->Id);
+						Context->Payload.clear();
+						Unique.Negate();
+						return Flush(Source, true);
+					}
+					else if (Context->Payload.empty())
+					{
+						Unique.Negate();
+						auto Status = Context->Input(Context->Payload);
+						Unique.Negate();
+						if (!Status)
+						{
+							Context->Payload = Status.Error().message();
+							Context->Cancelled = true;
+							Context->Drained = true;
+						}
+						else
+							Context->Drained = !*Status;
+						continue;
+					}
 
-				if (!Base->Busy())
-					return false;
+					int Code = PQputCopyData(Source->Base, Context->Payload.data(), (int)Context->Payload.size());
+					if (Code == 0)
+						break;
+					else if (Code < 0)
+					{
+						PQlogNoticeOf(Source->Base);
+						Context->Payload.clear();
+						Unique.Negate();
+						return Flush(Source, true);
+					}
 
-				VI_MEASURE(Core::Timings::Intensive);
-				VI_DEBUG("[pq] execute query on 0x%" PRIXPTR "%s (rid: %" PRIu64 "): %.64s%s", (uintptr_t)Base, Base->InTransaction() ? " (transaction)" : "", Base->Current->Id, Base->Current->Command.data(), Base->Current->Command.size() > 64 ? " ..." : "");
-				if (PQsendQuery(Base->Base, Base->Current->Command.data()) == 1)
-				{
-					Flush(Base, false);
-					return true;
+					Context->Payload.clear();
 				}
 
-				auto* BrokenRequest = Base->MakeIdle();
-				PQlogNoticeOf(Base->Base);
-				Core::Codefer([BrokenRequest]()
-				{
-					Core::UPtr<Request> Item = BrokenRequest;
-					Item->ReportFailure();
-				});
-				return true;
-#else
-				return false;
-#endif
-			}
-			bool Cluster::Reprocess(Connection* Source)
-			{
-				return Multiplexer::Get()->WhenReadable(Source->Stream, [this, Source](SocketPoll Event)
+				Source->Stream->ClearEvents(false);
+				return Multiplexer::Get()->WhenWriteable(Source->Stream, [this, Source](SocketPoll Event)
 				{
 					if (Packet::IsError(Event))
 						Reestablish(Source);
 					else if (!Packet::IsSkip(Event))
-						Dispatch(Source);
+						Upload(Source);
 				});
+#else
+				return false;
+#endif
 			}
-			bool Cluster::Flush(Connection* Source, bool ListenForResults)
+			bool Cluster::Download(Connection* Source)
 			{
 #ifdef VI_POSTGRESQL
-				if (PQflush(Source->Base) == 1)
+				Core::UMutex<std::recursive_mutex> Unique(Update);
+				Request* Context = Source->Current;
+				bool Consumed = false;
+				while (true)
 				{
-					Source->Stream->ClearEvents(false);
-					return Multiplexer::Get()->WhenWriteable(Source->Stream, [this, Source](SocketPoll Event)
+					char* Buffer = nullptr;
+					int Size = PQgetCopyData(Source->Base, &Buffer, 1);
+					if (Size > 0)
 					{
-						if (!Packet::IsSkip(Event))
-							Flush(Source, true);
-					});
+						bool Continue = true;
+						if (Context != nullptr && Context->Output && !Context->Cancelled)
+						{
+							Unique.Negate();
+							Continue = Context->Output(std::string_view(Buffer, (size_t)Size));
+							Unique.Negate();
+						}
+
+						PQfreemem(Buffer);
+						if (!Continue)
+							Interrupt(Source, Context);
+						Consumed = false;
+						continue;
+					}
+					else if (Size < 0)
+						return true;
+					else if (Consumed)
+						break;
+
+					if (PQconsumeInput(Source->Base) != 1)
+					{
+						Unique.Negate();
+						Reestablish(Source);
+						return false;
+					}
+
+					Consumed = true;
 				}
-#endif
-				if (ListenForResults)
-					return Reprocess(Source);
 
-				return true;
+				Unique.Negate();
+				Reprocess(Source);
+				return false;
+#else
+				return false;
+#endif
 			}
-			bool Cluster::Dispatch(Connection* Source)
+			bool Cluster::Enqueue(Connection* Base)
 			{
-#ifdef VI_POSTGRESQL
-				VI_MEASURE(Core::Timings::Intensive);
-				Consume(Source);
-			Retry:
-				if (PQconsumeInput(Source->Base) != 1)
-					return Reestablish(Source);
-				else if (PQisBusy(Source->Base) != 0)
-					return Reprocess(Source);
-
+#ifdef LIBPQ_HAS_PIPELINING
 				Core::UMutex<std::recursive_mutex> Unique(Update);
-				PGnotify* Notification = nullptr;
-				while ((Notification = PQnotifies(Source->Base)) != nullptr)
+				bool Idle = Base->Pipeline.empty();
+				size_t Count = 0;
+				while (Base->Pipeline.size() < PipelineDepth)
 				{
-					if (Notification != nullptr && Notification->relname != nullptr)
+					Request* Last = Base->Pipeline.empty() ? nullptr : Base->Pipeline.back();
+					if (Last != nullptr && Last->Boundary)
+						break;
+
+					auto It = Requests.begin();
+					for (; It != Requests.end(); ++It)
 					{
-						auto It = Listeners.find(Notification->relname);
-						if (It != Listeners.end() && !It->second.empty())
+						Request* Context = *It;
+						if (Last != nullptr)
 						{
-							Notify Event(Notification);
-							for (auto& Item : It->second)
-							{
-								OnNotification Callback = Item.second;
-								Core::Codefer([Event, Callback = std::move(Callback)]() { Callback(Event); });
-							}
+							if (Context->Session == Last->Session)
+								break;
 						}
-						VI_DEBUG("[pq] notification on channel @%s: %s", Notification->relname, Notification->extra ? Notification->extra : "[payload]");
-						PQfreeNotify(Notification);
+						else if (Context->Session != nullptr)
+						{
+							if (Context->Session == Base)
+								break;
+						}
+						else if (!Base->InTransaction())
+							break;
 					}
-				}
-
-				Response Chunk(PQgetResult(Source->Base));
-				if (Chunk.Exists())
-				{
-					if (Source->Current != nullptr)
-						Source->Current->Result.Base.emplace_back(std::move(Chunk));
-					goto Retry;
-				}
 
-				PQlogNoticeOf(Source->Base);
-				if (Source->Current != nullptr && !Source->Current->Result.Error())
-					VI_DEBUG("[pq] OK execute on 0x%" PRIXPTR " (%" PRIu64 " ms, rid: %" PRIu64 ")", (uintptr_t)Source, Source->Current->GetTiming(), Source->Current->Id);
+					if (It == Requests.end() || !(*It)->Pipelinable)
+						break;
 
-				auto* ReadyRequest = Source->MakeIdle();
-				if (ReadyRequest != nullptr)
-				{
-					Core::Codefer([ReadyRequest]()
+					Request* Context = *It;
+					Context->Result.Executor = Base;
+					Requests.erase(It);
+					VI_DEBUG("[pq] pipeline query on 0x%" PRIXPTR "%s (rid: %" PRIu64 ", depth: %i): %.64s%s", (uintptr_t)Base, Context->Session ? " (transaction)" : "", Context->Id, (int)Base->Pipeline.size() + 1, Context->Command.data(), Context->Command.size() > 64 ? " ..." : "");
+					if (!Transmit(Base, Context))
 					{
-						Core::UPtr<Request> Item = ReadyRequest;
-						Item->ReportCursor();
-					});
+						PQlogNoticeOf(Base->Base);
+						Base->Pipeline.push_back(Context);
+						Core::Codefer([this, Base]() { Reestablish(Base); });
+						return true;
+					}
+
+					Base->Pipeline.push_back(Context);
+					++Count;
 				}
-				if (Consume(Source))
-					goto Retry;
 
-				return Reprocess(Source);
+				if (!Count)
+					return false;
+
+				if (Idle)
+					Base->MakeBusy(Base->Pipeline.front());
+
+				Flush(Base, false);
+				return true;
 #else
 				return false;
 #endif
@@ -2479,6 +3800,109 @@ namespace Vitex
 
 				return "NULL";
 			}
+			Core::String Utils::GetCopyHeader() noexcept
+			{
+				Core::String Result("PGCOPY\n\377\r\n\0", 11);
+				ToCopyInteger(Result, 0, 4);
+				ToCopyInteger(Result, 0, 4);
+				return Result;
+			}
+			Core::String Utils::GetCopyTrailer() noexcept
+			{
+				Core::String Result;
+				ToCopyInteger(Result, 0xFFFF, 2);
+				return Result;
+			}
+			ExpectsDB<void> Utils::WriteCopyRow(Core::String& Buffer, const Core::VariantList& Row, const Core::Vector<OidType>& Types) noexcept
+			{
+				if (Row.size() != Types.size())
+					return DatabaseException("copy row has " + Core::ToString(Row.size()) + " values, expected " + Core::ToString(Types.size()));
+
+				ToCopyInteger(Buffer, (uint64_t)Row.size(), 2);
+				for (size_t i = 0; i < Row.size(); i++)
+				{
+					auto& Value = Row[i];
+					if (Value.GetType() == Core::VarType::Null || Value.GetType() == Core::VarType::Undefined)
+					{
+						ToCopyInteger(Buffer, 0xFFFFFFFF, 4);
+						continue;
+					}
+
+					size_t Offset = Buffer.size();
+					Buffer.append(4, '\0');
+					switch (Types[i])
+					{
+						case OidType::Bool:
+							Buffer.append(1, Value.GetBoolean() ? '\1' : '\0');
+							break;
+						case OidType::Int2:
+							ToCopyInteger(Buffer, (uint64_t)Value.GetInteger(), 2);
+							break;
+						case OidType::Int4:
+							ToCopyInteger(Buffer, (uint64_t)Value.GetInteger(), 4);
+							break;
+						case OidType::Int8:
+							ToCopyInteger(Buffer, (uint64_t)Value.GetInteger(), 8);
+							break;
+						case OidType::Float4:
+						{
+							float Number = (float)Value.GetNumber();
+							uint32_t Bits = 0;
+							memcpy(&Bits, &Number, sizeof(Bits));
+							ToCopyInteger(Buffer, Bits, 4);
+							break;
+						}
+						case OidType::Float8:
+						{
+							double Number = Value.GetNumber();
+							uint64_t Bits = 0;
+							memcpy(&Bits, &Number, sizeof(Bits));
+							ToCopyInteger(Buffer, Bits, 8);
+							break;
+						}
+						case OidType::Numeric:
+						{
+							Core::String Number = (Value.GetType() == Core::VarType::Decimal ? Value.GetDecimal().ToString() : Value.GetBlob());
+							if (!ToCopyNumeric(Buffer, Number))
+								return DatabaseException("copy value is not a valid numeric: " + Number);
+							break;
+						}
+						case OidType::UUID:
+						{
+							Core::String Data = Value.GetBlob();
+							Core::Stringify::Replace(Data, "-", "");
+							Data = Compute::Codec::HexDecode(Data);
+							if (Data.size() != 16)
+								return DatabaseException("copy value is not a valid uuid: " + Value.GetBlob());
+
+							Buffer.append(Data);
+							break;
+						}
+						case OidType::JSONB:
+							Buffer.append(1, '\1');
+							Buffer.append(Value.GetBlob());
+							break;
+						case OidType::Bytea:
+						case OidType::Char:
+						case OidType::JSON:
+						case OidType::Name:
+						case OidType::Text:
+						case OidType::CString:
+						case OidType::BpChar:
+						case OidType::VarChar:
+							Buffer.append(Value.GetString());
+							break;
+						default:
+							return DatabaseException("copy type " + Core::ToString((int)Types[i]) + " is not supported in binary format");
+					}
+
+					uint32_t Length = (uint32_t)(Buffer.size() - Offset - 4);
+					for (size_t j = 0; j < 4; j++)
+						Buffer[Offset + j] = (char)((Length >> (24 - j * 8)) & 0xFF);
+				}
+
+				return Core::Expectation::Met;
+			}
 
 			Driver::Driver() noexcept : Active(false), Logger(nullptr)
 			{
@@ -2591,6 +4015,7 @@ namespace Vitex
 				if (Variables.empty())
 					Result.Cache = Result.Request;
 
+				Parameterize(Result);
 				Core::UMutex<std::mutex> Unique(Exclusive);
 				Queries[Core::String(Name)] = std::move(Result);
 				return Core::Expectation::Met;
@@ -2689,6 +4114,7 @@ namespace Vitex
 						}
 					}
 
+					Parameterize(Result);
 					Core::String Name = Data->GetVar("name").GetBlob();
 					Queries[Name] = std::move(Result);
 					++Count;
@@ -2816,6 +4242,32 @@ namespace Vitex
 
 				return Result;
 			}
+			ExpectsDB<Core::String> Driver::GetParameterizedQuery(const std::string_view& Name, Core::SchemaArgs* Map, Core::Vector<std::pair<Core::Schema*, bool>>* Params, Core::String* Statement) noexcept
+			{
+				VI_ASSERT(Params != nullptr, "params should be set");
+				Core::UMutex<std::mutex> Unique(Exclusive);
+				auto It = Queries.find(Core::KeyLookupCast(Name));
+				if (It == Queries.end())
+					return DatabaseException("query not found: " + Core::String(Name));
+
+				if (It->second.Parameterized.empty())
+					return DatabaseException("query cannot be prepared with unsafe variables: " + Core::String(Name));
+
+				Params->reserve(It->second.Binds.size());
+				for (auto& Bind : It->second.Binds)
+				{
+					auto Value = (Map ? Map->find(Bind.first) : Core::SchemaArgs::iterator());
+					if (!Map || Value == Map->end())
+						return DatabaseException("query expects @" + Bind.first + " constant: " + Core::String(Name));
+
+					Params->emplace_back(*Value->second, Bind.second);
+				}
+
+				if (Statement != nullptr)
+					*Statement = It->second.Statement;
+
+				return It->second.Parameterized;
+			}
 			Core::Vector<Core::String> Driver::GetQueries() noexcept
 			{
 				Core::Vector<Core::String> Result;
@@ -2826,6 +4278,36 @@ namespace Vitex
 
 				return Result;
 			}
+			void Driver::Parameterize(Sequence& Next)
+			{
+				Next.Binds.clear();
+				Next.Parameterized.clear();
+				Next.Statement.clear();
+				for (auto& Word : Next.Positions)
+				{
+					if (!Word.Escape)
+						return;
+				}
+
+				Core::String Result = Next.Request;
+				size_t Offset = 0;
+				for (auto& Word : Next.Positions)
+				{
+					size_t Index = 0;
+					while (Index < Next.Binds.size() && (Next.Binds[Index].first != Word.Key || Next.Binds[Index].second != Word.Negate))
+						++Index;
+
+					if (Index == Next.Binds.size())
+						Next.Binds.emplace_back(Word.Key, Word.Negate);
+
+					Core::String Value = "$" + Core::ToString(Index + 1);
+					Result.insert(Word.Offset + Offset, Value);
+					Offset += Value.size();
+				}
+
+				Next.Parameterized = std::move(Result);
+				Next.Statement = Core::Stringify::Text("vi_%" PRIx64, (uint64_t)std::hash<std::string_view>()(Next.Parameterized));
+			}
 		}
 	}
 }
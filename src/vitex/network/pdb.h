@@ -32,6 +32,7 @@ namespace Vitex
 			typedef std::function<void(const std::string_view&)> OnQueryLog;
 			typedef std::function<void(const Notify&)> OnNotification;
 			typedef std::function<void(Cursor&)> OnResult;
+			typedef std::function<Core::Promise<bool>(Response&&)> OnStream;
 			typedef Connection* SessionId;
 			typedef pg_conn TConnection;
 			typedef pg_result TResponse;
@@ -95,7 +96,10 @@ namespace Vitex
 				Non_Fatal_Error,
 				Fatal_Error,
 				Copy_Both,
-				Single_Tuple
+				Single_Tuple,
+				Pipeline_Sync,
+				Pipeline_Aborted,
+				Tuples_Chunk
 			};
 
 			enum class FieldCode
@@ -181,7 +185,9 @@ namespace Vitex
 				Float8 = 701,
 				Money = 790,
 				Numeric = 1700,
-				Bytea = 17
+				Bytea = 17,
+				Timestamp = 1114,
+				TimestampTZ = 1184
 			};
 
 			enum class QueryState
@@ -212,6 +218,20 @@ namespace Vitex
 			template <typename T, typename Executor = Core::ParallelExecutor>
 			using ExpectsPromiseDB = Core::BasicPromise<ExpectsDB<T>, Executor>;
 
+			typedef std::function<ExpectsDB<bool>(Core::String&)> OnCopyIn;
+			typedef std::function<bool(const std::string_view&)> OnCopyOut;
+			typedef std::function<bool(Core::VariantList&)> OnCopyRow;
+
+			struct VI_OUT CacheStatistics
+			{
+				uint64_t Hits = 0;
+				uint64_t Misses = 0;
+				uint64_t Evictions = 0;
+				size_t Entries = 0;
+				size_t Bytes = 0;
+				size_t Capacity = 0;
+			};
+
 			class VI_OUT Address
 			{
 			private:
@@ -341,6 +361,7 @@ namespace Vitex
 				};
 
 			private:
+				std::atomic<uint32_t>* Shares;
 				TResponse* Base;
 				bool Failure;
 
@@ -378,6 +399,7 @@ namespace Vitex
 				Row Front() const;
 				Row Back() const;
 				Response Copy() const;
+				Response Share();
 				TResponse* Get() const;
 				bool Empty() const;
 				bool Error() const;
@@ -442,6 +464,7 @@ namespace Vitex
 				size_t Size() const;
 				size_t AffectedRows() const;
 				Cursor Copy() const;
+				Cursor Share();
 				const Response& First() const;
 				const Response& Last() const;
 				const Response& At(size_t Index) const;
@@ -468,11 +491,16 @@ namespace Vitex
 				friend Cluster;
 
 			private:
+				Core::UnorderedMap<Core::String, Core::LinkedList<Core::String>::iterator> Prepared;
+				Core::LinkedList<Core::String> Statements;
+				Core::Vector<Core::String> Unprepared;
 				Core::UnorderedSet<Core::String> Listens;
+				Core::DoubleQueue<Request*> Pipeline;
 				TConnection* Base;
 				Socket* Stream;
 				Request* Current;
 				QueryState Status;
+				bool Cancelling;
 
 			public:
 				Connection(TConnection* NewBase, socket_t Fd);
@@ -483,9 +511,11 @@ namespace Vitex
 				QueryState GetState() const;
 				TransactionState GetTxState() const;
 				bool InTransaction() const;
+				bool InPipeline() const;
 				bool Busy() const;
 
 			private:
+				void MakePrepared(const Core::String& Statement, size_t Capacity);
 				void MakeBusy(Request* Data);
 				Request* MakeIdle();
 				Request* MakeLost();
@@ -495,15 +525,37 @@ namespace Vitex
 			{
 				friend Cluster;
 
+			private:
+				enum class Step
+				{
+					Execute,
+					Prepare,
+					Deallocate
+				};
+
 			private:
 				ExpectsPromiseDB<Cursor> Future;
+				Core::Vector<std::pair<Core::String, int>> Params;
 				Core::Vector<char> Command;
+				Core::String Statement;
 				std::chrono::microseconds Time;
 				SessionId Session;
 				OnResult Callback;
+				OnStream Stream;
+				OnCopyIn Input;
+				OnCopyOut Output;
+				Core::String Payload;
 				Cursor Result;
 				uint64_t Id;
 				size_t Options;
+				size_t Skips;
+				size_t Rows;
+				Step Stage;
+				bool Parameterized;
+				bool Pipelinable;
+				bool Boundary;
+				bool Cancelled;
+				bool Drained;
 
 			public:
 				Request(const std::string_view& Commands, SessionId NewSession, Caching Status, uint64_t Rid, size_t NewOptions);
@@ -522,15 +574,36 @@ namespace Vitex
 				friend Driver;
 
 			private:
-				struct
+				struct CacheEntry
 				{
-					Core::UnorderedMap<Core::String, std::pair<int64_t, Cursor>> Objects;
+					Cursor Data;
+					uint64_t Key = 0;
+					uint64_t Check = 0;
+					int64_t Expires = 0;
+					size_t Size = 0;
+				};
+
+				struct CacheShard
+				{
+					Core::UnorderedMap<uint64_t, Core::LinkedList<CacheEntry>::iterator> Objects;
+					Core::LinkedList<CacheEntry> Order;
 					std::mutex Context;
+					int64_t NextCleanup = 0;
+					size_t Bytes = 0;
+				};
+
+			private:
+				struct
+				{
+					CacheShard Shards[16];
+					std::atomic<uint64_t> Hits = 0;
+					std::atomic<uint64_t> Misses = 0;
+					std::atomic<uint64_t> Evictions = 0;
+					std::atomic<size_t> Capacity = 64 * 1024 * 1024;
 					uint64_t ShortDuration = 10;
 					uint64_t MidDuration = 30;
 					uint64_t LongDuration = 60;
 					uint64_t CleanupDuration = 300;
-					int64_t NextCleanup = 0;
 				} Cache;
 
 			private:
@@ -542,6 +615,8 @@ namespace Vitex
 				std::recursive_mutex Update;
 				OnReconnect Reconnected;
 				Address Source;
+				size_t StatementCapacity;
+				size_t PipelineDepth;
 
 			public:
 				Cluster();
@@ -549,6 +624,9 @@ namespace Vitex
 				void ClearCache();
 				void SetCacheCleanup(uint64_t Interval);
 				void SetCacheDuration(QueryOp CacheId, uint64_t Duration);
+				void SetCacheCapacity(size_t Bytes);
+				void SetStatementCapacity(size_t Capacity);
+				void SetPipelineDepth(size_t Depth);
 				void SetWhenReconnected(const OnReconnect& NewCallback);
 				uint64_t AddChannel(const std::string_view& Name, const OnNotification& NewCallback);
 				bool RemoveChannel(const std::string_view& Name, uint64_t Id);
@@ -563,20 +641,37 @@ namespace Vitex
 				ExpectsPromiseDB<void> Unlisten(const Core::Vector<Core::String>& Channels);
 				ExpectsPromiseDB<Cursor> EmplaceQuery(const std::string_view& Command, Core::SchemaList* Map, size_t QueryOps = 0, SessionId Session = nullptr);
 				ExpectsPromiseDB<Cursor> TemplateQuery(const std::string_view& Name, Core::SchemaArgs* Map, size_t QueryOps = 0, SessionId Session = nullptr);
+				ExpectsPromiseDB<Cursor> PreparedQuery(const std::string_view& Name, Core::SchemaArgs* Map, size_t QueryOps = 0, SessionId Session = nullptr);
+				ExpectsPromiseDB<Cursor> ParameterizedQuery(const std::string_view& Command, Core::SchemaList* Map, size_t QueryOps = 0, SessionId Session = nullptr);
+				ExpectsPromiseDB<Cursor> CopyFrom(const std::string_view& Command, OnCopyIn&& Producer, SessionId Session = nullptr);
+				ExpectsPromiseDB<Cursor> CopyFromStream(const std::string_view& Command, Core::Stream* Source, SessionId Session = nullptr);
+				ExpectsPromiseDB<Cursor> CopyFromRows(const std::string_view& Command, const Core::Vector<OidType>& Types, OnCopyRow&& Producer, SessionId Session = nullptr);
+				ExpectsPromiseDB<Cursor> CopyTo(const std::string_view& Command, OnCopyOut&& Consumer, SessionId Session = nullptr);
+				ExpectsPromiseDB<Cursor> CopyToStream(const std::string_view& Command, Core::Stream* Target, SessionId Session = nullptr);
+				ExpectsPromiseDB<Cursor> StreamQuery(const std::string_view& Command, OnStream&& Callback, size_t ChunkRows = 0, SessionId Session = nullptr);
 				ExpectsPromiseDB<Cursor> Query(const std::string_view& Command, size_t QueryOps = 0, SessionId Session = nullptr);
 				Connection* GetConnection(QueryState State);
 				Connection* GetAnyConnection() const;
+				CacheStatistics GetCacheStatistics();
 				bool IsConnected() const;
 
 			private:
-				Core::String GetCacheOid(const std::string_view& Payload, size_t QueryOpts);
-				bool GetCache(const std::string_view& CacheOid, Cursor* Data);
-				void SetCache(const std::string_view& CacheOid, Cursor* Data, size_t QueryOpts);
+				ExpectsPromiseDB<Cursor> Execute(const std::string_view& Command, Core::Vector<std::pair<Core::String, int>>* Params, Core::String&& Statement, OnStream&& Stream, size_t ChunkRows, size_t QueryOps, SessionId Session);
+				ExpectsPromiseDB<Cursor> Submit(Request* Next);
+				std::pair<uint64_t, uint64_t> GetCacheOid(const std::string_view& Payload, size_t QueryOpts);
+				bool GetCache(const std::pair<uint64_t, uint64_t>& CacheOid, Cursor* Data);
+				void SetCache(const std::pair<uint64_t, uint64_t>& CacheOid, Cursor* Data, size_t QueryOpts);
 				bool Reestablish(Connection* Base);
 				bool Consume(Connection* Base);
 				bool Reprocess(Connection* Base);
 				bool Flush(Connection* Base, bool ListenForResults);
 				bool Dispatch(Connection* Base);
+				bool Transmit(Connection* Base, Request* Context);
+				bool Enqueue(Connection* Base);
+				void Interrupt(Connection* Base, Request* Context);
+				void Resume(Connection* Base);
+				bool Upload(Connection* Base);
+				bool Download(Connection* Base);
 				bool IsManaging(SessionId Session);
 				Connection* IsListens(const std::string_view& Name);
 			};
@@ -589,6 +684,9 @@ namespace Vitex
 				static Core::String GetCharArray(Connection* Base, const std::string_view& Src) noexcept;
 				static Core::String GetByteArray(Connection* Base, const std::string_view& Src) noexcept;
 				static Core::String GetSQL(Connection* Base, Core::Schema* Source, bool Escape, bool Negate) noexcept;
+				static Core::String GetCopyHeader() noexcept;
+				static Core::String GetCopyTrailer() noexcept;
+				static ExpectsDB<void> WriteCopyRow(Core::String& Buffer, const Core::VariantList& Row, const Core::Vector<OidType>& Types) noexcept;
 			};
 
 			class VI_OUT_TS Driver final : public Core::Singleton<Driver>
@@ -604,7 +702,10 @@ namespace Vitex
 
 				struct Sequence
 				{
+					Core::Vector<std::pair<Core::String, bool>> Binds;
 					Core::Vector<Pose> Positions;
+					Core::String Parameterized;
+					Core::String Statement;
 					Core::String Request;
 					Core::String Cache;
 				};
@@ -630,7 +731,11 @@ namespace Vitex
 				Core::Schema* GetCacheDump() noexcept;
 				ExpectsDB<Core::String> Emplace(Cluster* Base, const std::string_view& SQL, Core::SchemaList* Map) noexcept;
 				ExpectsDB<Core::String> GetQuery(Cluster* Base, const std::string_view& Name, Core::SchemaArgs* Map) noexcept;
+				ExpectsDB<Core::String> GetParameterizedQuery(const std::string_view& Name, Core::SchemaArgs* Map, Core::Vector<std::pair<Core::Schema*, bool>>* Params, Core::String* Statement) noexcept;
 				Core::Vector<Core::String> GetQueries() noexcept;
+
+			private:
+				static void Parameterize(Sequence& Next);
 			};
 		}
 	}
@@ -5454,6 +5454,7 @@ namespace Vitex
 		{
 			VI_ASSERT(Context != nullptr, "context should be set");
 #ifdef VI_ANGELSCRIPT
+			Core::MemoryScope Scope(Core::MemoryTag::Scripting);
 			int R = Context->Execute();
 			if (Callbacks.StopExecutions.empty())
 				return FunctionFactory::ToReturn<Execution>(R, (Execution)R);
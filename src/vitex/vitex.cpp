@@ -245,7 +245,10 @@ namespace Vitex
 	{
 		VI_TRACE("[lib] free singleton instances");
 		Layer::Application::CleanupInstance();
+		Network::HTTP::ClientPool::CleanupInstance();
 		Network::HTTP::HrmCache::CleanupInstance();
+		Network::HTTP::FileCache::CleanupInstance();
+		Network::HTTP::VariantCache::CleanupInstance();
 		Network::LDB::Driver::CleanupInstance();
 		Network::PDB::Driver::CleanupInstance();
 		Network::MDB::Driver::CleanupInstance();